@@ -0,0 +1,89 @@
+"""
+Extracts the static web assets (ASSET_* strings) from WebserverMemoryVariables.h
+and the single page app (templates/spa-ui) into gzipped files for the LittleFS image (data/www/...).
+
+Used as PlatformIO extra script, can also be run standalone: python scripts/build_assets.py
+
+The LittleFS image replaces the whole filesystem of the device, including the settings and printers
+(/conf.bin, /pconf.bin, /conf.txt, /pconf.txt) and the warm start data (/warm.bin). Download a backup
+from the update page (/settings/backup) before uploading the image and restore it afterwards, or set
+PRINTBUDDY_SETTINGS=<backup file> to put the settings into the image (imported on the next boot).
+"""
+import gzip
+import os
+import re
+
+ASSET_SOURCE = os.path.join("src", "Network", "WebserverMemoryVariables.h")
+ASSET_TARGET = os.path.join("data", "www")
+SPA_SOURCE = os.path.join("templates", "spa-ui")
+SETTINGS_TARGET = "data"
+SETTINGS_BACKUP_HEADER = "# PrintBuddy settings backup"
+SETTINGS_BACKUP_PRINTERS = "# Printers"
+ASSET_PATTERN = re.compile(r'static const char ASSET_(\w+)\[\] PROGMEM =((?:\s*"(?:[^"\\]|\\.)*")+)\s*;')
+LITERAL_PATTERN = re.compile(r'"((?:[^"\\]|\\.)*)"')
+
+
+def asset_file_name(asset_name):
+    # ASSET_APP_CSS -> app.css
+    base, extension = asset_name.lower().rsplit("_", 1)
+    return base.replace("_", "-") + "." + extension
+
+
+def unescape_literal(literal):
+    return re.sub(r'\\(.)', lambda m: {"n": "\n", "t": "\t"}.get(m.group(1), m.group(1)), literal)
+
+
+def build_assets(project_dir):
+    with open(os.path.join(project_dir, ASSET_SOURCE), "r", encoding="utf-8") as f:
+        source = f.read()
+
+    target_dir = os.path.join(project_dir, ASSET_TARGET)
+    os.makedirs(target_dir, exist_ok=True)
+    for match in ASSET_PATTERN.finditer(source):
+        content = "".join(unescape_literal(l) for l in LITERAL_PATTERN.findall(match.group(2)))
+        write_asset(os.path.join(target_dir, asset_file_name(match.group(1)) + ".gz"), content.encode("utf-8"))
+
+    spa_dir = os.path.join(project_dir, SPA_SOURCE)
+    if os.path.isdir(spa_dir):
+        for file_name in sorted(os.listdir(spa_dir)):
+            with open(os.path.join(spa_dir, file_name), "rb") as f:
+                write_asset(os.path.join(target_dir, file_name + ".gz"), f.read())
+
+
+def build_settings(project_dir, backup_file):
+    # Split a settings backup into the text settings, which are imported if there are no binary settings
+    with open(backup_file, "r", encoding="utf-8") as f:
+        lines = [line.rstrip("\r\n") for line in f]
+    if not lines or lines[0] != SETTINGS_BACKUP_HEADER or SETTINGS_BACKUP_PRINTERS not in lines:
+        raise ValueError("%s is no settings backup" % backup_file)
+    split = lines.index(SETTINGS_BACKUP_PRINTERS)
+    target_dir = os.path.join(project_dir, SETTINGS_TARGET)
+    for file_name, content in (("conf.txt", lines[1:split]), ("pconf.txt", lines[split + 1:])):
+        with open(os.path.join(target_dir, file_name), "w", encoding="utf-8") as f:
+            f.write("\n".join(line for line in content if line) + "\n")
+    print("Settings from %s are added to the filesystem image" % backup_file)
+
+
+def write_asset(target_file, content):
+    # mtime=0 keeps the output (and the ETag) stable as long as the asset does not change
+    compressed = gzip.compress(content, compresslevel=9, mtime=0)
+    if os.path.exists(target_file):
+        with open(target_file, "rb") as f:
+            if f.read() == compressed:
+                return
+    with open(target_file, "wb") as f:
+        f.write(compressed)
+    print("Asset %s: %d -> %d bytes" % (target_file, len(content), len(compressed)))
+
+
+try:
+    Import("env")
+    build_assets(env.subst("$PROJECT_DIR"))
+    if set(COMMAND_LINE_TARGETS) & {"buildfs", "uploadfs", "uploadfsota"}:
+        if os.environ.get("PRINTBUDDY_SETTINGS"):
+            build_settings(env.subst("$PROJECT_DIR"), os.environ["PRINTBUDDY_SETTINGS"])
+        else:
+            print("WARNING: the filesystem image replaces all settings and printers on the device, "
+                  "restore a settings backup after the upload (see scripts/build_assets.py)")
+except NameError:
+    build_assets(os.path.dirname(os.path.dirname(os.path.abspath(__file__))))
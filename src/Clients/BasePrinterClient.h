@@ -44,5 +44,6 @@ public:
         printerData->toolTargetTemp = 0.0f;
         printerData->toolTemp = 0.0f;
         printerData->errorReadCnt = 0;
+        printerData->cachedEpoch = 0;
     }
 };
\ No newline at end of file
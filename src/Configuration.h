@@ -11,13 +11,26 @@
  */
 #define VERSION                     "1.0 RC1"
 #define HOSTNAME                    "PrintBuddy-" 
-#define CONFIG                      "/conf.txt"         // EEProm config file for general settings
-#define PRINTERCONFIG               "/pconf.txt"        // EEProm config file for printer settings
+#define CONFIG                      "/conf.txt"         // EEProm config file for general settings (text export/import)
+#define PRINTERCONFIG               "/pconf.txt"        // EEProm config file for printer settings (text export/import)
+#define CONFIG_BINARY               "/conf.bin"         // EEProm config file for general settings (loaded on boot)
+#define PRINTERCONFIG_BINARY        "/pconf.bin"        // EEProm config file for printer settings (loaded on boot)
+#define SETTINGS_RESTORE_FILE       "/restore.tmp"      // Uploaded settings backup, imported and removed after the upload
+#define SETTINGS_RESTORE_MAX_SIZE   8192                // Max size of an uploaded settings backup
 #define DEBUG_MODE_ENABLE           true                // true = Enables debug message on terminal | false = disable all debug messages
 #define MAX_PRINTERS                9                   // Limit of configurable printers, please not that many printers slow down the system!
 #define PRINTER_SYNC_SEC            60                  // Snyc printer when offline or not printing every x seconds
 #define PRINTER_SYNC_SEC_PRINTING   20                  // Snyc printer when printing every x seconds
-#define SENSOR_SYNC_SEC             60                  // Sync for sensor in seconds
+#define SENSOR_SYNC_SEC             10                  // Sample sensor every x seconds
+#define SENSOR_SAMPLE_BUFFER        30                  // Samples kept for rolling min/max/avg (30 x 10 s = 5 minutes)
+#define SENSOR_FILTER               SENSOR_FILTER_MEDIAN // Filter for shown values: SENSOR_FILTER_NONE | SENSOR_FILTER_MEDIAN | SENSOR_FILTER_EMA
+#define SENSOR_FILTER_MEDIAN_SIZE   5                   // Median of the last x samples
+#define SENSOR_FILTER_EMA_ALPHA     0.3                 // Weight of a new sample for the exponential filter (0...1)
+#define WEATHER_OBSERVATION_SEC     600                 // OpenWeatherMap publishes a new observation at most every x seconds
+#define WEATHER_RETRY_MIN_SEC       30                  // Retry failed weather request after x seconds, doubled on each failure
+#define WARMSTART_FILE              "/warm.bin"         // Last known printer, weather and sensor data, shown as cached after boot
+#define WARMSTART_SNAPSHOT_SEC      60                  // Store last known data in RTC memory every x seconds
+#define WARMSTART_FILE_SEC          900                 // Store last known data in LittleFS at most every x seconds (flash wear)
 
 /**
  * @brief ArduinoJSON Max buffer for responses, used for printers and weather
@@ -102,6 +115,13 @@
 #define DISPLAY_SCL_PIN                     I2C_SCL_PIN
 #define DISPLAY_INVERT_DISPLAY              true        // true = pins at top | false = pins at the bottom
 
+// OLED render policy: full frame rate is only used while a page transition is animated,
+// otherwise the screen is redrawn when the data or the displayed second changes
+#define DISPLAY_OLED_TRANSITION_FPS         30          // Frame rate during page transitions
+#define DISPLAY_OLED_TIME_PER_FRAME         5000        // Milliseconds a page is shown before auto transition
+#define DISPLAY_BOOT_SCREEN_MILLIS          5000        // Minimum time the boot screen is shown
+#define DISPLAY_OLED_BANNER_MILLIS          5000        // Time the sleep/wake up banner is shown
+
 //===========================================================================
 //======================= Webserver default config ==========================
 //===========================================================================
@@ -110,6 +130,9 @@
 #define WEBSERVER_ENABLED           true
 // The port you can access this device on over HTTP
 #define WEBSERVER_PORT              80
+// true = dashboard is a single page app rendered by the browser (templates/spa-ui, needs the LittleFS image)
+// false = all pages are rendered on the device
+#define WEBSERVER_SPA               false
 // true = require athentication to change configuration settings / false = no auth
 #define WEBSERVER_IS_BASIC_AUTH     true
 // User account for the Web Interface
@@ -130,6 +153,8 @@
 #define TIME_IS_24HOUR              true
 // Minutes between resync with time server
 #define TIME_RESYNC_MINUTES_DELAY   15
+// SNTP servers, asked in this order until one answers
+#define TIME_NTP_SERVERS            "pool.ntp.org", "time.google.com", "time.cloudflare.com"
 
 //===========================================================================
 //======================== Weather default config ===========================
@@ -0,0 +1,67 @@
+#pragma once
+#include <Arduino.h>
+
+#define CONFIG_BINARY_MAGIC         0x46434250      // "PBCF"
+#define CONFIG_BINARY_VERSION       1
+
+/**
+ * Header of a binary config file, followed by recordCount records of recordSize bytes
+ */
+typedef struct __attribute__((packed)) {
+    uint32_t    magic;
+    uint16_t    version;
+    uint16_t    recordSize;
+    uint16_t    recordCount;
+    uint16_t    reserved;
+    uint32_t    crc;
+} ConfigHeaderDataStruct;
+
+/**
+ * Persisted system, clock, weather, sensor and display settings
+ */
+typedef struct __attribute__((packed)) {
+    uint8_t     useLedFlash;
+    int32_t     webserverPort;
+    char        webserverUsername[32];
+    char        webserverPassword[128];
+    uint8_t     hasBasicAuth;
+    int32_t     clockWeatherResyncMinutes;
+
+    int32_t     clockUtcOffset;
+    char        clockTimezoneHash[24];
+    uint8_t     clockShow;
+    uint8_t     clockIs24h;
+
+    uint8_t     weatherShow;
+    char        weatherApiKey[64];
+    int32_t     weatherCityId;
+    uint8_t     weatherIsMetric;
+    char        weatherLang[8];
+
+    uint8_t     sensorActivated;
+    uint8_t     sensorShowOnDisplay;
+    int32_t     sensorType;
+
+    int32_t     displayType;
+    uint8_t     displayInvert;
+    uint8_t     displayWeatherSensorSplited;
+    int32_t     displayAutomaticSwitchDelay;
+    uint8_t     displayAutomaticSwitchEnabled;
+    uint8_t     displayAutomaticSwitchActiveOnlyEnabled;
+    int32_t     displayAutomaticInactiveOff;
+} ConfigBasicDataStruct;
+
+/**
+ * Persisted settings of a single printer (live data is not stored)
+ */
+typedef struct __attribute__((packed)) {
+    char        customName[20];
+    int32_t     apiType;
+    char        apiKey[60];
+    char        remoteAddress[60];
+    int32_t     remotePort;
+    uint8_t     basicAuthNeeded;
+    char        basicAuthUsername[30];
+    char        basicAuthPassword[60];
+    uint8_t     hasPsuControl;
+} ConfigPrinterDataStruct;
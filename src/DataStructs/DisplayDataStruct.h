@@ -16,3 +16,12 @@ typedef struct {
     bool    automaticSwitchActiveOnlyEnabled;
     int     automaticInactiveOff;
 } DisplayDataStruct;
+
+typedef struct {
+    uint32_t renderedFrames;
+    uint32_t lastFrameMicros;
+    uint32_t maxFrameMicros;
+    uint32_t avgFrameMicros;
+    uint32_t flushedBytes;
+    uint32_t flushedWindows;
+} DisplayRenderStatsDataStruct;
@@ -0,0 +1,11 @@
+#pragma once
+#include <Arduino.h>
+
+/**
+ * Cache validators of the last response, sent again to only receive changed data
+ */
+typedef struct {
+    char            etag[48];
+    unsigned long   maxAgeSec;
+    bool            notModified;
+} HttpCacheDataStruct;
@@ -0,0 +1,13 @@
+#pragma once
+#include <Arduino.h>
+
+// Max length of a queued command (without terminator)
+#define NEXTION_COMMAND_MAX_LEN     71
+
+/**
+ * Command which is sent later, because the display is still settling
+ */
+typedef struct {
+    char            command[NEXTION_COMMAND_MAX_LEN + 1];
+    uint16_t        settleMillis;       // Settle window started after sending (reset, page switch)
+} NextionCommandDataStruct;
@@ -46,4 +46,6 @@ typedef struct {
     bool    isPSUoff;
     char    error[120];
     int     errorReadCnt;
+    long    cachedEpoch;
+    uint32_t id;            // Runtime id, stays the same while other printers are added or removed (not stored)
 } PrinterDataStruct;
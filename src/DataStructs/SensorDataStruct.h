@@ -13,6 +13,19 @@
 #define SENSOR_CLIENT_DHT21_WIRE       (int)7
 #define SENSOR_CLIENT_DHT22_WIRE       (int)8
 
+#define SENSOR_FILTER_NONE             0
+#define SENSOR_FILTER_MEDIAN           1
+#define SENSOR_FILTER_EMA              2
+
+/**
+ * Rolling statistic of one value over the samples in the ring buffer
+ */
+typedef struct {
+    float   min;
+    float   max;
+    float   avg;
+} SensorStatsDataStruct;
+
 typedef struct {
     bool    activated;
     bool    showOnDisplay;
@@ -20,10 +33,18 @@ typedef struct {
     char    error[120];
     bool    sensorIsRuning;
     long    lastSyncEpoch;
-    float   temperature;
+    float   rawTemperature;         // Last reading of the sensor, input of the filter
+    float   rawPressure;
+    float   rawHumidity;
+    float   temperature;            // Filtered values
     float   pressure;
     float   humidity;
     float   airQuality;
     float   gasResistance;
     float   altitude;
+    long    cachedEpoch;
+    int     sampleCount;
+    SensorStatsDataStruct temperatureStats;
+    SensorStatsDataStruct humidityStats;
+    SensorStatsDataStruct pressureStats;
 } SensorDataStruct;
@@ -13,4 +13,7 @@ typedef struct {
     String  version;
     String  lastError;
     String  lastOk;
+    bool    bootQuickConnect;
+    unsigned long bootWifiMillis;
+    unsigned long bootDataMillis;
 } SystemDataStruct;
@@ -0,0 +1,11 @@
+#pragma once
+#include <Arduino.h>
+
+/**
+ * Time of a SNTP response, corrected by half of the network round trip
+ */
+typedef struct {
+    long    epoch;          // Unix time in seconds at the receive of the response
+    long    epochMs;        // Milliseconds of this second at the receive of the response
+    long    roundTripMs;    // Network round trip without the processing time of the server
+} TimeSyncDataStruct;
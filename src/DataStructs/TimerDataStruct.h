@@ -0,0 +1,14 @@
+#pragma once
+#include <Arduino.h>
+#include <functional>
+
+typedef std::function<void()> TimerCallback;
+
+typedef struct {
+    int             handle;
+    bool            active;
+    unsigned long   startMillis;
+    unsigned long   intervalMillis;
+    int             remainingRuns;      // -1 = endless (periodic)
+    TimerCallback   callback;
+} TimerDataStruct;
@@ -0,0 +1,67 @@
+#pragma once
+#include <Arduino.h>
+#include <ESP8266WiFi.h>
+
+typedef struct {
+    char    stateText[24];
+    char    clientType[20];
+    char    host[68];
+    char    progress[6];
+    char    printTime[12];
+    char    printTimeLeft[12];
+    char    toolTemp[10];
+    char    toolTempRounded[8];
+    char    toolTargetTemp[8];
+    char    bedTemp[10];
+    char    bedTempRounded[8];
+    char    bedTargetTemp[8];
+    char    fileSize[16];
+    char    filament[16];
+    bool    isCached;
+} PrinterViewDataStruct;
+
+typedef struct {
+    long    epoch;
+    bool    is24h;
+    char    hours[4];
+    char    minutes[4];
+    char    seconds[4];
+    char    amPmHours[4];
+    char    amPm[4];
+    char    clockShort[8];
+    char    clockLong[16];
+} TimeViewDataStruct;
+
+typedef struct {
+    bool    isValid;
+    char    city[32];
+    char    country[8];
+    char    location[48];
+    char    temperature[12];
+    char    temperatureHtml[16];
+    char    temperatureRounded[8];
+    char    humidity[8];
+    char    humidityRounded[8];
+    char    wind[16];
+    char    condition[24];
+    char    description[48];
+    char    icon[8];
+    char    iconGlyph[2];
+    char    error[120];
+    bool    isCached;
+} WeatherViewDataStruct;
+
+typedef struct {
+    char    type[24];
+    char    temperature[10];
+    char    temperatureRounded[8];
+    char    humidity[10];
+    char    humidityRounded[8];
+    char    temperatureRange[16];
+    char    humidityRange[16];
+    char    pressure[12];
+    char    altitude[12];
+    char    airQuality[24];
+    int     airQualityValue;
+    bool    isCached;
+} SensorViewDataStruct;
@@ -0,0 +1,69 @@
+#pragma once
+#include <Arduino.h>
+
+#define WARMSTART_MAGIC             0x54534D57      // "WMST"
+#define WARMSTART_VERSION           1
+
+/**
+ * Header of a warm start snapshot, followed by sensor, weather and printerCount printer records
+ */
+typedef struct __attribute__((packed)) {
+    uint32_t    magic;
+    uint16_t    version;
+    uint16_t    size;
+    uint8_t     printerCount;
+    uint8_t     reserved[3];
+    uint32_t    epoch;
+    uint32_t    crc;
+} WarmStartHeaderDataStruct;
+
+/**
+ * Last known sensor values, syncEpoch = 0 if there was no reading
+ */
+typedef struct __attribute__((packed)) {
+    uint32_t    syncEpoch;
+    int8_t      sensType;
+    float       temperature;
+    float       humidity;
+    float       pressure;
+    float       airQuality;
+    float       gasResistance;
+    float       altitude;
+} WarmStartSensorDataStruct;
+
+/**
+ * Last known weather, syncEpoch = 0 if there was no valid weather
+ */
+typedef struct __attribute__((packed)) {
+    uint32_t    syncEpoch;
+    int32_t     cityId;
+    float       temperature;
+    float       humidity;
+    float       wind;
+    int16_t     weatherId;
+    char        city[24];
+    char        country[4];
+    char        condition[16];
+    char        description[32];
+    char        icon[4];
+    char        iconGlyph[2];
+} WarmStartWeatherDataStruct;
+
+/**
+ * Last known printer telemetry, only restored if configHash matches the configured printer
+ */
+typedef struct __attribute__((packed)) {
+    uint32_t    configHash;
+    uint32_t    syncEpoch;
+    int8_t      state;
+    bool        isPrinting;
+    bool        isPSUoff;
+    uint8_t     progressCompletion;
+    float       progressPrintTime;
+    float       progressPrintTimeLeft;
+    float       toolTemp;
+    float       toolTargetTemp;
+    float       bedTemp;
+    float       bedTargetTemp;
+    char        fileName[32];
+} WarmStartPrinterDataStruct;
@@ -0,0 +1,11 @@
+#pragma once
+#include <Arduino.h>
+
+typedef struct {
+    const char  *uri;
+    const char  *fileName;
+    const char  *contentType;
+    const char  *cacheControl;
+    bool        isAvailable;
+    char        etag[9];
+} WebserverAssetDataStruct;
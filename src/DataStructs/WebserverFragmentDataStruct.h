@@ -0,0 +1,8 @@
+#pragma once
+#include <Arduino.h>
+
+typedef struct {
+    uint8_t     *content;
+    size_t      length;
+    uint32_t    version;
+} WebserverFragmentDataStruct;
@@ -0,0 +1,19 @@
+#pragma once
+#include <Arduino.h>
+
+#define WIFI_CACHE_MAGIC            0x49464957      // "WIFI"
+
+/**
+ * Access point and IP configuration of the last connection, used for a direct reconnect after reset
+ */
+typedef struct __attribute__((packed)) {
+    uint32_t    magic;
+    uint32_t    crc;
+    uint8_t     bssid[6];
+    uint8_t     channel;
+    uint8_t     reserved;
+    uint32_t    localIp;
+    uint32_t    gateway;
+    uint32_t    subnet;
+    uint32_t    dns;
+} WifiCacheDataStruct;
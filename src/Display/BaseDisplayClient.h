@@ -22,4 +22,8 @@ public:
 
   virtual bool isUpdateable();
   virtual void updateFirmware();
+
+  virtual DisplayRenderStatsDataStruct *getRenderStats();
+  virtual size_t getFrameBufferDumpSize();
+  virtual void sendFrameBuffer(Print *target);
 };
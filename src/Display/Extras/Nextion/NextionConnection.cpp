@@ -25,8 +25,44 @@ void NextionConnection::resetDevice() {
     this->sendCommandValueInt("thup", 1);
     this->sendCommandValueInt("thsp", 0);
     this->sendCommandValueInt("sleep", 0);
-    this->sendCommand("rest");
-    delay(500);
+    this->sendCommandRaw("rest", NEXTION_SETTLE_RESET_MILLIS);
+}
+
+/**
+ * @brief Check if the display has settled and all queued commands are sent
+ * @return true 
+ * @return false 
+ */
+bool NextionConnection::isReady() {
+    return this->canSendDirect();
+}
+
+/**
+ * @brief Send queued commands as far as the display has settled, called from the loop
+ */
+void NextionConnection::handleQueue() {
+    while ((this->queueCount > 0) && this->isSettled()) {
+        NextionCommandDataStruct *entry = &this->commandQueue[this->queueHead];
+        this->flushInput();
+        this->serialPort->print(entry->command);
+        this->sendCommandEnd();
+        if (entry->settleMillis > 0) {
+            this->startSettle(entry->settleMillis);
+        }
+        this->queueHead = (this->queueHead + 1) % NEXTION_COMMAND_QUEUE_SIZE;
+        this->queueCount--;
+    }
+}
+
+/**
+ * @brief Send all queued commands and wait for the settle windows in between.
+ * Only for screens shown from setup() or the config portal, where the loop does not run.
+ */
+void NextionConnection::waitQueueSent() {
+    while (this->queueCount > 0) {
+        this->handleQueue();
+        yield();
+    }
 }
 
 /**
@@ -34,10 +70,9 @@ void NextionConnection::resetDevice() {
  * @param pageId 
  */
 void NextionConnection::switchToPage(int pageId) {
-    String command("page ");
-    command += String(pageId);
-    this->sendCommand(command.c_str());
-    delay(50);
+    char command[12];
+    snprintf(command, sizeof(command), "page %d", pageId);
+    this->sendCommandRaw(command, NEXTION_SETTLE_PAGE_MILLIS);
 }
 
 /**
@@ -51,15 +86,58 @@ void NextionConnection::sendCommandValueTxt(String var, String value) {
     this->sendCommand(command.c_str());
 }
 
+/**
+ * @brief Set an text variable (var) with value, without building a temporary command
+ * @param var 
+ * @param value 
+ */
+void NextionConnection::sendCommandValueTxt(const char *var, const char *value) {
+    if (!this->canSendDirect()) {
+        char command[NEXTION_COMMAND_MAX_LEN + 1];
+        if (snprintf(command, sizeof(command), "%s=\"%s\"", var, value) < (int)sizeof(command)) {
+            this->queueCommand(command, 0);
+        } else {
+            this->debugController->printLn(String("Nextion command too long to queue: ") + var);
+        }
+        return;
+    }
+    this->flushInput();
+    this->serialPort->print(var);
+    this->serialPort->print("=\"");
+    this->serialPort->print(value);
+    this->serialPort->print("\"");
+    this->sendCommandEnd();
+}
+
 /**
  * @brief Set an number variable (var) with value
  * @param var 
  * @param value 
  */
 void NextionConnection::sendCommandValueInt(String var, int value) {
-    String command(var + "=");
-    command += String(value);
-    this->sendCommand(command.c_str());
+    this->sendCommandValueInt(var.c_str(), value);
+}
+
+/**
+ * @brief Set an number variable (var) with value, without building a temporary command
+ * @param var 
+ * @param value 
+ */
+void NextionConnection::sendCommandValueInt(const char *var, int value) {
+    if (!this->canSendDirect()) {
+        char command[NEXTION_COMMAND_MAX_LEN + 1];
+        if (snprintf(command, sizeof(command), "%s=%d", var, value) < (int)sizeof(command)) {
+            this->queueCommand(command, 0);
+        } else {
+            this->debugController->printLn(String("Nextion command too long to queue: ") + var);
+        }
+        return;
+    }
+    this->flushInput();
+    this->serialPort->print(var);
+    this->serialPort->print("=");
+    this->serialPort->print(value);
+    this->sendCommandEnd();
 }
 
 /**
@@ -75,13 +153,89 @@ void NextionConnection::sendCommand(String cmd) {
  * @param cmd 
  */
 void NextionConnection::sendCommand(const char* cmd) {
-  while (this->serialPort->available())
-  {
-    this->serialPort->read();
-  }
-    
-  this->serialPort->print(cmd);
-  this->serialPort->write(0xFF);
-  this->serialPort->write(0xFF);
-  this->serialPort->write(0xFF);
+    this->sendCommandRaw(cmd, 0);
+}
+
+/**
+ * @brief Send command now or queue it while the display is settling
+ * @param command 
+ * @param settleMillis      Settle window started after the command (0 = none)
+ */
+void NextionConnection::sendCommandRaw(const char *command, uint16_t settleMillis) {
+    if (!this->canSendDirect()) {
+        if (strlen(command) <= NEXTION_COMMAND_MAX_LEN) {
+            this->queueCommand(command, settleMillis);
+        } else {
+            this->debugController->printLn(String("Nextion command too long to queue: ") + command);
+        }
+        return;
+    }
+    this->flushInput();
+    this->serialPort->print(command);
+    this->sendCommandEnd();
+    if (settleMillis > 0) {
+        this->startSettle(settleMillis);
+    }
+}
+
+/**
+ * @brief Append a command to the queue, it is sent by handleQueue()
+ * @param command 
+ * @param settleMillis      Settle window started after the command (0 = none)
+ */
+void NextionConnection::queueCommand(const char *command, uint16_t settleMillis) {
+    if (this->queueCount >= NEXTION_COMMAND_QUEUE_SIZE) {
+        this->debugController->printLn(String("Nextion command queue full, dropped: ") + command);
+        return;
+    }
+    NextionCommandDataStruct *entry = &this->commandQueue[(this->queueHead + this->queueCount) % NEXTION_COMMAND_QUEUE_SIZE];
+    strncpy(entry->command, command, NEXTION_COMMAND_MAX_LEN);
+    entry->command[NEXTION_COMMAND_MAX_LEN] = 0;
+    entry->settleMillis = settleMillis;
+    this->queueCount++;
+}
+
+/**
+ * @brief Start settle window, the display ignores commands within this time
+ * @param settleMillis 
+ */
+void NextionConnection::startSettle(unsigned long settleMillis) {
+    this->settleStartMillis = millis();
+    this->settleMillis = settleMillis;
+}
+
+/**
+ * @brief Check if the settle window of the last reset/page switch is over
+ * @return true 
+ * @return false 
+ */
+bool NextionConnection::isSettled() {
+    return (millis() - this->settleStartMillis) >= this->settleMillis;
+}
+
+/**
+ * @brief Commands can be sent directly if the display has settled and nothing is queued before
+ * @return true 
+ * @return false 
+ */
+bool NextionConnection::canSendDirect() {
+    return (this->queueCount == 0) && this->isSettled();
+}
+
+/**
+ * @brief Drop all pending responses from display
+ */
+void NextionConnection::flushInput() {
+    while (this->serialPort->available()) {
+        this->serialPort->read();
+    }
+}
+
+/**
+ * @brief Terminate command
+ */
+void NextionConnection::sendCommandEnd() {
+    this->serialPort->write(0xFF);
+    this->serialPort->write(0xFF);
+    this->serialPort->write(0xFF);
 }
@@ -3,6 +3,14 @@
 #include <ESP8266WiFi.h>
 #include <SoftwareSerial.h>
 #include "../../../Global/GlobalDataController.h"
+#include "../../../DataStructs/NextionCommandDataStruct.h"
+
+// Time the display needs after a reset or page switch before it accepts further commands
+#define NEXTION_SETTLE_RESET_MILLIS     500
+#define NEXTION_SETTLE_PAGE_MILLIS      50
+// Commands kept while the display is settling, sent in order once it is ready
+#define NEXTION_COMMAND_QUEUE_SIZE      16
+#define NEXTION_QUEUE_INTERVAL_MILLIS   10
 
 /**
  * @brief Nextion connection base methods
@@ -11,14 +19,33 @@ class NextionConnection {
 private:
     DebugController *debugController;
     SoftwareSerial *serialPort;
+    unsigned long settleStartMillis = 0;
+    unsigned long settleMillis = 0;
+    NextionCommandDataStruct commandQueue[NEXTION_COMMAND_QUEUE_SIZE];
+    int queueHead = 0;
+    int queueCount = 0;
 
 public:
     NextionConnection(SoftwareSerial *serialPort, DebugController *debugController);
     void setBaudrate(int baudrate);
+    bool isReady();
+    void handleQueue();
+    void waitQueueSent();
     void resetDevice();
     void switchToPage(int pageId);
     void sendCommandValueTxt(String var, String value);
+    void sendCommandValueTxt(const char *var, const char *value);
     void sendCommandValueInt(String var, int value);
+    void sendCommandValueInt(const char *var, int value);
     void sendCommand(String cmd);
     void sendCommand(const char* cmd);
+
+private:
+    bool isSettled();
+    bool canSendDirect();
+    void queueCommand(const char *command, uint16_t settleMillis);
+    void sendCommandRaw(const char *command, uint16_t settleMillis);
+    void flushInput();
+    void startSettle(unsigned long settleMillis);
+    void sendCommandEnd();
 };
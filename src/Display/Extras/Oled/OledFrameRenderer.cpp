@@ -0,0 +1,220 @@
+#include "OledFrameRenderer.h"
+#include "../../../../include/WeatherStationFonts.h"
+
+/**
+ * @brief Draw printer frame
+ * @param display           Handle to display
+ * @param printer           Printer data
+ * @param view              Preformatted printer values
+ * @param x                 X offset (transition)
+ * @param y                 Y offset (transition)
+ */
+void OledFrameRenderer::drawPrinterState(OLEDDisplay *display, PrinterDataStruct *printer, PrinterViewDataStruct *view, int16_t x, int16_t y) {
+    char buffer[32];
+
+    // Draw printer state data
+    display->setTextAlignment(TEXT_ALIGN_LEFT);
+    display->setFont(ArialMT_Plain_10);
+    snprintf(buffer, sizeof(buffer), "%s%s", printer->customName, view->isCached ? " (cached)" : "");
+    display->drawString(x, 13 + y, buffer);
+
+    // State
+    int yPos = 24 + y;
+    display->setTextAlignment(TEXT_ALIGN_RIGHT);
+    display->setFont(ArialMT_Plain_24);
+    display->drawString(display->width() + x, yPos, printer->progressCompletion > 99 ? "99%" : view->progress);
+
+    // Time
+    display->setFont(ArialMT_Plain_10);
+    display->setTextAlignment(TEXT_ALIGN_LEFT);
+    snprintf(buffer, sizeof(buffer), "D: %s", view->printTime);
+    display->drawString(x, yPos, buffer);
+    snprintf(buffer, sizeof(buffer), "L: %s", view->printTimeLeft);
+    display->drawString(x, yPos + 11, buffer);
+
+    // Temps
+    int blockWidth = display->width() / 2;
+    int tOff = 10;
+    int splitBlock = (blockWidth - tOff) / 2;
+    yPos = display->height() - 12 + y;
+    display->setFont(ArialMT_Plain_10);
+    display->setTextAlignment(TEXT_ALIGN_RIGHT);
+    display->drawRect(x, yPos, blockWidth, 12);
+    display->drawRect(x + blockWidth, yPos, blockWidth, 12);
+
+    display->fillRect(x, yPos, tOff, 12);
+    display->fillRect(x + splitBlock + tOff, yPos, splitBlock, 12);    
+    display->drawString(x + splitBlock + tOff - 2, yPos - 1, view->toolTempRounded);
+    if (printer->bedTemp != 0) {
+        display->fillRect(x + blockWidth, yPos, tOff, 12);
+        display->fillRect(x + blockWidth + splitBlock + tOff, yPos, splitBlock, 12);
+        display->drawString(x + blockWidth + splitBlock + tOff - 2, yPos - 1, view->bedTempRounded);
+    }
+
+    display->setColor(OLEDDISPLAY_COLOR::BLACK);
+    display->setTextAlignment(TEXT_ALIGN_LEFT);
+    display->drawString(x + splitBlock + tOff + 2, yPos - 1, view->toolTargetTemp);
+    display->drawString(x + 2, yPos - 1, "T");
+    if (printer->bedTemp != 0) {
+        display->drawString(x + blockWidth + splitBlock + tOff + 2, yPos - 1, view->bedTargetTemp);
+        display->drawString(x + blockWidth + 2, yPos - 1, "B");
+    }
+
+    // Split blocks!
+    display->fillRect(x + blockWidth - 1, yPos, 2, 12);
+
+    // Reset settings!
+    display->setColor(OLEDDISPLAY_COLOR::WHITE);
+}
+
+/**
+ * @brief Draw clock frame
+ * @param display           Handle to display
+ * @param timeView          Preformatted time values
+ * @param x                 X offset (transition)
+ * @param y                 Y offset (transition)
+ */
+void OledFrameRenderer::drawClock(OLEDDisplay *display, TimeViewDataStruct *timeView, int16_t x, int16_t y) {
+    display->setTextAlignment(TEXT_ALIGN_CENTER);
+    display->setFont(ArialMT_Plain_24);
+    display->drawString(64 + x, 20 + y, timeView->clockShort);
+}
+
+/**
+ * @brief Draw outdoor weather
+ * @param display           Handle to display
+ * @param weatherView       Preformatted weather values
+ * @param x                 X offset (transition)
+ * @param y                 Y offset (transition)
+ */
+void OledFrameRenderer::drawWeatherOutdoor(OLEDDisplay *display, WeatherViewDataStruct *weatherView, int16_t x, int16_t y) {
+    display->setTextAlignment(TEXT_ALIGN_LEFT);
+    display->setFont(ArialMT_Plain_10);
+    display->drawString(0 + x, 13 + y, weatherView->city);
+
+    display->setTextAlignment(TEXT_ALIGN_LEFT);
+    display->setFont(ArialMT_Plain_24);
+    display->drawString(0 + x, 24 + y, weatherView->temperature);
+
+    display->setFont((const uint8_t*)Meteocons_Plain_42);
+    display->drawString(84 + x, 14 + y, weatherView->iconGlyph);
+
+    display->setTextAlignment(TEXT_ALIGN_LEFT);
+    display->setFont(ArialMT_Plain_10);
+    display->drawString(0 + x, 50 + y, weatherView->condition);
+}
+
+/**
+ * @brief Draw indoor sensor weather
+ * @param display           Handle to display
+ * @param sensorView        Preformatted sensor values
+ * @param hasHumidity       Sensor measures humidity
+ * @param hasAirQuality     Sensor measures air quality
+ * @param x                 X offset (transition)
+ * @param y                 Y offset (transition)
+ */
+void OledFrameRenderer::drawWeatherIndoor(OLEDDisplay *display, SensorViewDataStruct *sensorView, bool hasHumidity, bool hasAirQuality, int16_t x, int16_t y) {
+    char buffer[40];
+
+    display->setTextAlignment(TEXT_ALIGN_LEFT);
+    display->setFont(ArialMT_Plain_10);
+    display->drawString(0 + x, 13 + y, sensorView->isCached ? "Indoor (cached)" : "Indoor");
+
+    display->setFont(ArialMT_Plain_24);
+    display->setTextAlignment(TEXT_ALIGN_LEFT);
+    snprintf(buffer, sizeof(buffer), "%s°C", sensorView->temperatureRounded);
+    display->drawString(0 + x, 24 + y, buffer);
+
+    if (hasHumidity) {
+        display->setTextAlignment(TEXT_ALIGN_RIGHT);
+        snprintf(buffer, sizeof(buffer), "%s%%", sensorView->humidityRounded);
+        display->drawString(126 + x, 24 + y, buffer);
+    }
+
+    if (hasAirQuality) {
+        display->setTextAlignment(TEXT_ALIGN_LEFT);
+        display->setFont(ArialMT_Plain_10);
+        snprintf(buffer, sizeof(buffer), "Air quality: %s", sensorView->airQuality);
+        display->drawString(0 + x, 50 + y, buffer);
+    } else if (sensorView->temperatureRange[0] != 0) {
+        display->setTextAlignment(TEXT_ALIGN_LEFT);
+        display->setFont(ArialMT_Plain_10);
+        snprintf(buffer, sizeof(buffer), "Min/Max: %s°C", sensorView->temperatureRange);
+        display->drawString(0 + x, 50 + y, buffer);
+    }
+}
+
+/**
+ * @brief Draw basic information header (time and page blobs) on the first 11px from top
+ * @param display           Handle to display
+ * @param timeView          Preformatted time values
+ * @param numPages          Number of pages (blobs are only shown for more than one page)
+ * @param currentPage       Current page
+ */
+void OledFrameRenderer::drawInformationHeader(OLEDDisplay *display, TimeViewDataStruct *timeView, int numPages, int currentPage) {
+    display->setColor(WHITE);
+    display->setFont(ArialMT_Plain_10);  
+    
+    if (!timeView->is24h) {
+        display->setTextAlignment(TEXT_ALIGN_RIGHT);
+        display->drawString(25, 0, timeView->clockShort);
+        display->setTextAlignment(TEXT_ALIGN_LEFT);
+        display->drawString(27, 0, timeView->amPm);
+    } else {
+        display->setTextAlignment(TEXT_ALIGN_LEFT);
+        display->drawString(0, 0, timeView->clockShort);
+    }
+
+    // Draw pages blobs
+    if (numPages > 1) {
+        int xPos = 110 - (numPages * 6);
+        for(int i=0; i<numPages; i++) {
+            if (i == currentPage) {
+                display->fillCircle(xPos, 5, 2);
+            } else {
+                display->drawCircle(xPos, 5, 2);
+            }
+            xPos += 6;
+        }
+    }
+
+    display->drawHorizontalLine(0, 11, 128);
+}
+
+/**
+ * @brief Size of the frame buffer dump (binary PBM)
+ * @param display           Handle to display
+ * @return size_t 
+ */
+size_t OledFrameRenderer::getFrameBufferDumpSize(OLEDDisplay *display) {
+    char header[16];
+    size_t headerLen = snprintf(header, sizeof(header), "P4\n%u %u\n", display->getWidth(), display->getHeight());
+    return headerLen + ((display->getWidth() + 7) / 8) * display->getHeight();
+}
+
+/**
+ * @brief Write the frame buffer as binary PBM (lit pixels are black), e.g. for reference screenshots
+ * @param display           Handle to display
+ * @param target            Output
+ */
+void OledFrameRenderer::sendFrameBuffer(OLEDDisplay *display, Print *target) {
+    uint16_t width = display->getWidth();
+    uint16_t height = display->getHeight();
+    uint8_t row[32];
+    size_t rowLen = _min((size_t)((width + 7) / 8), sizeof(row));
+    char header[16];
+
+    snprintf(header, sizeof(header), "P4\n%u %u\n", width, height);
+    target->print(header);
+    for (uint16_t y = 0; y < height; y++) {
+        memset(row, 0, rowLen);
+        // Frame buffer is organized in pages of 8 rows, one byte per column (LSB on top)
+        uint8_t *page = display->buffer + ((y / 8) * width);
+        for (uint16_t x = 0; x < (rowLen * 8) && x < width; x++) {
+            if (page[x] & (1 << (y & 7))) {
+                row[x / 8] |= 0x80 >> (x & 7);
+            }
+        }
+        target->write(row, rowLen);
+    }
+}
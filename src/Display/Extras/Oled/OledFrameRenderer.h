@@ -0,0 +1,21 @@
+#pragma once
+#include <Arduino.h>
+#include <OLEDDisplay.h>
+#include "../../../DataStructs/PrinterDataStruct.h"
+#include "../../../DataStructs/ViewModelDataStruct.h"
+
+/**
+ * @brief Draws the OLED ui frames from preformatted view data into a display buffer
+ * Has no dependency to the controllers, so the frames can be rendered on the host (env:native)
+ * and compared against the golden images in test/test_oled_render.
+ */
+class OledFrameRenderer {
+public:
+    static void drawPrinterState(OLEDDisplay *display, PrinterDataStruct *printer, PrinterViewDataStruct *view, int16_t x, int16_t y);
+    static void drawClock(OLEDDisplay *display, TimeViewDataStruct *timeView, int16_t x, int16_t y);
+    static void drawWeatherOutdoor(OLEDDisplay *display, WeatherViewDataStruct *weatherView, int16_t x, int16_t y);
+    static void drawWeatherIndoor(OLEDDisplay *display, SensorViewDataStruct *sensorView, bool hasHumidity, bool hasAirQuality, int16_t x, int16_t y);
+    static void drawInformationHeader(OLEDDisplay *display, TimeViewDataStruct *timeView, int numPages, int currentPage);
+    static size_t getFrameBufferDumpSize(OLEDDisplay *display);
+    static void sendFrameBuffer(OLEDDisplay *display, Print *target);
+};
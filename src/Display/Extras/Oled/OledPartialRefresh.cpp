@@ -0,0 +1,92 @@
+#include "OledPartialRefresh.h"
+
+/**
+ * @brief Construct a new Oled Partial Refresh:: Oled Partial Refresh object
+ * @param i2cAddress        I2C address of the display controller
+ */
+OledPartialRefresh::OledPartialRefresh(uint8_t i2cAddress) {
+    this->i2cAddress = i2cAddress;
+}
+
+/**
+ * @brief Bytes (commands and data) sent to the display since boot
+ * @return uint32_t 
+ */
+uint32_t OledPartialRefresh::getFlushedBytes() {
+    return this->flushedBytes;
+}
+
+/**
+ * @brief Windows sent to the display since boot
+ * @return uint32_t 
+ */
+uint32_t OledPartialRefresh::getFlushedWindows() {
+    return this->flushedWindows;
+}
+
+/**
+ * @brief Diff the frame buffer against the shadow buffer and send all changed windows
+ * @param buffer            Current frame buffer
+ * @param bufferBack        Shadow of the last flushed frame buffer (updated here)
+ * @param width             Display width in columns
+ * @param pages             Number of 8px pages
+ */
+void OledPartialRefresh::flushDirtyWindows(uint8_t *buffer, uint8_t *bufferBack, uint8_t width, uint8_t pages) {
+    for (uint8_t page = 0; page < pages; page++) {
+        uint8_t *pageBuffer = buffer + (page * width);
+        uint8_t *pageBufferBack = bufferBack + (page * width);
+        int16_t spanStart = -1;
+        int16_t spanEnd = -1;
+
+        for (uint8_t x = 0; x < width; x++) {
+            if (pageBuffer[x] == pageBufferBack[x]) {
+                continue;
+            }
+            pageBufferBack[x] = pageBuffer[x];
+            if ((spanStart >= 0) && ((x - spanEnd) > OLED_PARTIAL_REFRESH_MERGE_GAP)) {
+                // Gap is too large, addressing a new window is cheaper
+                this->sendWindow(page, spanStart, spanEnd, pageBuffer + spanStart);
+                spanStart = -1;
+            }
+            if (spanStart < 0) {
+                spanStart = x;
+            }
+            spanEnd = x;
+        }
+        if (spanStart >= 0) {
+            this->sendWindow(page, spanStart, spanEnd, pageBuffer + spanStart);
+        }
+        yield();
+    }
+}
+
+/**
+ * @brief Send a single command byte to the controller
+ * @param command 
+ */
+void OledPartialRefresh::writeCommand(uint8_t command) {
+    Wire.beginTransmission(this->i2cAddress);
+    Wire.write(0x80);
+    Wire.write(command);
+    Wire.endTransmission();
+    this->flushedBytes += 2;
+}
+
+/**
+ * @brief Send display data to the current window of the controller
+ * @param data              Data to send
+ * @param length            Number of bytes
+ */
+void OledPartialRefresh::writeData(uint8_t *data, uint8_t length) {
+    this->flushedWindows++;
+    while (length > 0) {
+        uint8_t chunk = length > OLED_PARTIAL_REFRESH_I2C_CHUNK ? OLED_PARTIAL_REFRESH_I2C_CHUNK : length;
+        Wire.beginTransmission(this->i2cAddress);
+        Wire.write(0x40);
+        Wire.write(data, chunk);
+        Wire.endTransmission();
+        this->flushedBytes += chunk + 1;
+        data += chunk;
+        length -= chunk;
+    }
+}
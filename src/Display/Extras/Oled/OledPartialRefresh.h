@@ -0,0 +1,31 @@
+#pragma once
+#include <Arduino.h>
+#include <Wire.h>
+
+// Unchanged columns between two changed spans of a page that are still merged into one window
+#define OLED_PARTIAL_REFRESH_MERGE_GAP      8
+// Data bytes per I2C transmission (same chunk size as the display library)
+#define OLED_PARTIAL_REFRESH_I2C_CHUNK      16
+
+/**
+ * @brief Dirty region tracker for I2C OLED controllers
+ * Compares the frame buffer against the shadow of the last flushed frame buffer page by page
+ * and transmits only the changed column spans (windows) of each page.
+ */
+class OledPartialRefresh {
+private:
+    uint8_t i2cAddress;
+    uint32_t flushedBytes = 0;
+    uint32_t flushedWindows = 0;
+
+public:
+    OledPartialRefresh(uint8_t i2cAddress);
+    uint32_t getFlushedBytes();
+    uint32_t getFlushedWindows();
+
+protected:
+    void flushDirtyWindows(uint8_t *buffer, uint8_t *bufferBack, uint8_t width, uint8_t pages);
+    void writeCommand(uint8_t command);
+    void writeData(uint8_t *data, uint8_t length);
+    virtual void sendWindow(uint8_t page, uint8_t startX, uint8_t endX, uint8_t *data) = 0;
+};
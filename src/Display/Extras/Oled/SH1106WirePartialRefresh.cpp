@@ -0,0 +1,35 @@
+#include "SH1106WirePartialRefresh.h"
+
+/**
+ * @brief Construct a new SH1106WirePartialRefresh::SH1106WirePartialRefresh object
+ * @param address           I2C address
+ * @param sda               SDA pin
+ * @param scl               SCL pin
+ * @param g                 Display geometry
+ */
+SH1106WirePartialRefresh::SH1106WirePartialRefresh(uint8_t address, uint8_t sda, uint8_t scl, OLEDDISPLAY_GEOMETRY g)
+    : SH1106Wire(address, sda, scl, g), OledPartialRefresh(address) {
+}
+
+/**
+ * @brief Send changed windows of the frame buffer
+ */
+void SH1106WirePartialRefresh::display(void) {
+    this->flushDirtyWindows(this->buffer, this->buffer_back, this->width(), this->height() / 8);
+}
+
+/**
+ * @brief Address a window of one page and send its data
+ * The SH1106 has a 132 column RAM, the visible area starts at column 2
+ * @param page              Page (8px row)
+ * @param startX            First column
+ * @param endX              Last column
+ * @param data              Column data
+ */
+void SH1106WirePartialRefresh::sendWindow(uint8_t page, uint8_t startX, uint8_t endX, uint8_t *data) {
+    uint8_t column = startX + 2;
+    this->writeCommand(0xB0 + page);
+    this->writeCommand(column & 0x0F);
+    this->writeCommand(0x10 | (column >> 4));
+    this->writeData(data, endX - startX + 1);
+}
@@ -0,0 +1,16 @@
+#pragma once
+#include <Arduino.h>
+#include <SH1106Wire.h>
+#include "OledPartialRefresh.h"
+
+/**
+ * @brief SH1106 I2C driver which only transmits changed windows (page addressing mode)
+ */
+class SH1106WirePartialRefresh : public SH1106Wire, public OledPartialRefresh {
+public:
+    SH1106WirePartialRefresh(uint8_t address, uint8_t sda, uint8_t scl, OLEDDISPLAY_GEOMETRY g = GEOMETRY_128_64);
+    void display(void);
+
+protected:
+    void sendWindow(uint8_t page, uint8_t startX, uint8_t endX, uint8_t *data);
+};
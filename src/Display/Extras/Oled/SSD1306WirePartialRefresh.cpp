@@ -0,0 +1,37 @@
+#include "SSD1306WirePartialRefresh.h"
+
+/**
+ * @brief Construct a new SSD1306WirePartialRefresh::SSD1306WirePartialRefresh object
+ * @param address           I2C address
+ * @param sda               SDA pin
+ * @param scl               SCL pin
+ * @param g                 Display geometry
+ */
+SSD1306WirePartialRefresh::SSD1306WirePartialRefresh(uint8_t address, uint8_t sda, uint8_t scl, OLEDDISPLAY_GEOMETRY g)
+    : SSD1306Wire(address, sda, scl, g), OledPartialRefresh(address) {
+}
+
+/**
+ * @brief Send changed windows of the frame buffer
+ */
+void SSD1306WirePartialRefresh::display(void) {
+    this->flushDirtyWindows(this->buffer, this->buffer_back, this->width(), this->height() / 8);
+}
+
+/**
+ * @brief Address a window of one page and send its data
+ * @param page              Page (8px row)
+ * @param startX            First column
+ * @param endX              Last column
+ * @param data              Column data
+ */
+void SSD1306WirePartialRefresh::sendWindow(uint8_t page, uint8_t startX, uint8_t endX, uint8_t *data) {
+    uint8_t xOffset = (128 - this->width()) / 2;
+    this->writeCommand(COLUMNADDR);
+    this->writeCommand(xOffset + startX);
+    this->writeCommand(xOffset + endX);
+    this->writeCommand(PAGEADDR);
+    this->writeCommand(page);
+    this->writeCommand(page);
+    this->writeData(data, endX - startX + 1);
+}
@@ -0,0 +1,16 @@
+#pragma once
+#include <Arduino.h>
+#include <SSD1306Wire.h>
+#include "OledPartialRefresh.h"
+
+/**
+ * @brief SSD1306 I2C driver which only transmits changed windows (horizontal addressing mode)
+ */
+class SSD1306WirePartialRefresh : public SSD1306Wire, public OledPartialRefresh {
+public:
+    SSD1306WirePartialRefresh(uint8_t address, uint8_t sda, uint8_t scl, OLEDDISPLAY_GEOMETRY g = GEOMETRY_128_64);
+    void display(void);
+
+protected:
+    void sendWindow(uint8_t page, uint8_t startX, uint8_t endX, uint8_t *data);
+};
@@ -21,6 +21,13 @@ void NextionDisplay::preSetup() {
     this->nextionConnection.setBaudrate(DISPLAY_BAUDRATE);
 #endif
     this->nextionConnection.resetDevice();
+
+    // Commands after the reset are queued, the timer also runs while setup() waits for WiFi
+    if (this->queueTimer == TIMER_INVALID) {
+        this->queueTimer = this->globalDataController->getTimerController()->every(NEXTION_QUEUE_INTERVAL_MILLIS, [this]() {
+            this->nextionConnection.handleQueue();
+        });
+    }
 }
 
 /**
@@ -60,8 +67,9 @@ void NextionDisplay::postSetup(bool isConfigChange) {
     }
     if (isConfigChange) {
         this->nextionConnection.switchToPage(0);
-        delay(1000);
-        this->nextionConnection.switchToPage(4);
+        this->globalDataController->getTimerController()->once(1000, [this]() {
+            this->nextionConnection.switchToPage(4);
+        });
     }
 }
 
@@ -92,6 +100,10 @@ void NextionDisplay::firstLoopCompleted() {
  */
 void NextionDisplay::handleUpdate() {
     TimeClient *timeClient = this->globalDataController->getTimeClient();
+    this->nextionConnection.handleQueue();
+    if (!this->nextionConnection.isReady()) {
+        return;
+    }
 
     // Resync basic data every 10s
     if(timeClient->getSecondsFromLast(this->lastSyncEpochBasic) > 10) {
@@ -133,6 +145,8 @@ void NextionDisplay::showApAccessScreen(String apSsid, String apIp) {
     String webAddress = "http://" + apIp + "/";
     this->nextionConnection.sendCommandValueTxt("vars.WifiServer.txt", webAddress);
     this->nextionConnection.switchToPage(1);
+    // Config portal blocks the loop, so nothing else would send the queue
+    this->nextionConnection.waitQueueSent();
 }
 
 /**
@@ -174,44 +188,53 @@ void NextionDisplay::syncStateData() {
  * @brief Syncronize weather data
  */
 void NextionDisplay::syncWeatherData() {
+    char buffer[64];
     if (this->globalDataController->getWeatherSettings()->cityId != 0) {
-        OpenWeatherMapClient *weatherClient = this->globalDataController->getWeatherClient();
+        WeatherViewDataStruct *weatherView = this->globalDataController->getViewModel()->getWeather();
         this->nextionConnection.sendCommandValueInt("hasWeather", 1);
-        this->nextionConnection.sendCommandValueTxt("vars.EWeatherState.txt", weatherClient->getCondition(0));
-        this->nextionConnection.sendCommandValueTxt("vars.EWeatherTemp.txt", weatherClient->getTempRounded(0) + " " + weatherClient->getTempSymbol());
-        this->nextionConnection.sendCommandValueTxt("vars.EWeatherHumi.txt", weatherClient->getHumidityRounded(0) + " %");
-        this->nextionConnection.sendCommandValueTxt("vars.EWeatherWind.txt", weatherClient->getWindRounded(0) + " " + weatherClient->getSpeedSymbol());
-        this->nextionConnection.sendCommandValueTxt("vars.EWeatherCity.txt", weatherClient->getCity(0));
-        this->nextionConnection.sendCommandValueTxt("vars.EWeatherLoc.txt", "Lat: " + weatherClient->getLat(0) + ", Lon: " + weatherClient->getLon(0));
-        this->nextionConnection.sendCommandValueTxt("vars.EWeatherIcon.txt", this->getWeatherIconShortId());
+        this->nextionConnection.sendCommandValueTxt("vars.EWeatherState.txt", weatherView->condition);
+        // Nextion layout expects a space before the units
+        snprintf(buffer, sizeof(buffer), "%s %s", weatherView->temperatureRounded, this->globalDataController->getWeatherClient()->getTempSymbol().c_str());
+        this->nextionConnection.sendCommandValueTxt("vars.EWeatherTemp.txt", buffer);
+        snprintf(buffer, sizeof(buffer), "%s %%", weatherView->humidityRounded);
+        this->nextionConnection.sendCommandValueTxt("vars.EWeatherHumi.txt", buffer);
+        this->nextionConnection.sendCommandValueTxt("vars.EWeatherWind.txt", weatherView->wind);
+        this->nextionConnection.sendCommandValueTxt("vars.EWeatherCity.txt", weatherView->city);
+        this->nextionConnection.sendCommandValueTxt("vars.EWeatherLoc.txt", weatherView->location);
+        this->nextionConnection.sendCommandValueTxt("vars.EWeatherIcon.txt", this->getWeatherIconShortId().c_str());
     }
     if (this->globalDataController->getSensorSettings()->activated) {
         SensorDataStruct *sensorSettings = this->globalDataController->getSensorSettings();
         BaseSensorClient *sensorClient = this->globalDataController->getSensorClient(sensorSettings);
+        SensorViewDataStruct *sensorView = this->globalDataController->getViewModel()->getSensor();
         this->nextionConnection.sendCommandValueInt("hasSensor", 1);
-        this->nextionConnection.sendCommandValueTxt("vars.SensType.txt", sensorClient->getType());
-        this->nextionConnection.sendCommandValueTxt("vars.SensTemp.txt", sensorClient->getTemperatureRounded(sensorSettings)  + "°C");
+        this->nextionConnection.sendCommandValueTxt("vars.SensType.txt", sensorView->type);
+        snprintf(buffer, sizeof(buffer), "%s°C", sensorView->temperatureRounded);
+        this->nextionConnection.sendCommandValueTxt("vars.SensTemp.txt", buffer);
         if (sensorClient->hasAirQuality()) {
             this->nextionConnection.sendCommandValueInt("vars.SensAqEnab.val", 1);
-            this->nextionConnection.sendCommandValueInt("vars.SensAq.val", sensorClient->airQualityAsInt(sensorSettings));
+            this->nextionConnection.sendCommandValueInt("vars.SensAq.val", sensorView->airQualityValue);
         } else {
             this->nextionConnection.sendCommandValueInt("vars.SensAqEnab.val", 0);
         }
         if (sensorClient->hasHumidity()) {
             this->nextionConnection.sendCommandValueInt("vars.SensHumiEnab.val", 1);
-            this->nextionConnection.sendCommandValueTxt("vars.SensHumi.txt", sensorClient->getHumidityRounded(sensorSettings) + "% Humidiy");
+            snprintf(buffer, sizeof(buffer), "%s%% Humidiy", sensorView->humidityRounded);
+            this->nextionConnection.sendCommandValueTxt("vars.SensHumi.txt", buffer);
         } else {
             this->nextionConnection.sendCommandValueInt("vars.SensHumiEnab.val", 0);
         }
         if (sensorClient->hasPressure()) {
             this->nextionConnection.sendCommandValueInt("vars.SensPressEnab.val", 1);
-            this->nextionConnection.sendCommandValueTxt("vars.SensPressure.txt", String(globalDataController->getSensorSettings()->pressure, 1) + " hPa");
+            snprintf(buffer, sizeof(buffer), "%s hPa", sensorView->pressure);
+            this->nextionConnection.sendCommandValueTxt("vars.SensPressure.txt", buffer);
         } else {
             this->nextionConnection.sendCommandValueInt("vars.SensPressEnab.val", 0);
         }
         if (sensorClient->hasAltitude()) {
             this->nextionConnection.sendCommandValueInt("vars.SensAltEnab.val", 1);
-            this->nextionConnection.sendCommandValueTxt("vars.SensAlt.txt", String(globalDataController->getSensorSettings()->altitude, 1) +  "m");
+            snprintf(buffer, sizeof(buffer), "%sm", sensorView->altitude);
+            this->nextionConnection.sendCommandValueTxt("vars.SensAlt.txt", buffer);
         } else {
             this->nextionConnection.sendCommandValueInt("vars.SensAltEnab.val", 0);
         }
@@ -222,70 +245,64 @@ void NextionDisplay::syncWeatherData() {
  * @brief Syncronize settings data
  */
 void NextionDisplay::syncSettingsData() {
+    char buffer[64];
     uint32_t heapFree = 0;
     uint16_t heapMax = 0;
     uint8_t heapFrag = 0;
     EspController::getHeap(&heapFree, &heapMax, &heapFrag);
 
-    this->nextionConnection.sendCommandValueTxt("vars.ESPChip.txt", "ChipID: " + String(ESP.getChipId()));
-    this->nextionConnection.sendCommandValueTxt("vars.ESPCore.txt", "CoreVersion: " + String(ESP.getCoreVersion()));
-    this->nextionConnection.sendCommandValueTxt("vars.ESPFrag.txt", "Heap (frag/free/max): " + String(heapFrag) + "% |" +  String(heapFree) + " b|" + String(heapMax) + " b");
+    snprintf(buffer, sizeof(buffer), "ChipID: %u", ESP.getChipId());
+    this->nextionConnection.sendCommandValueTxt("vars.ESPChip.txt", buffer);
+    snprintf(buffer, sizeof(buffer), "CoreVersion: %s", ESP.getCoreVersion().c_str());
+    this->nextionConnection.sendCommandValueTxt("vars.ESPCore.txt", buffer);
+    snprintf(buffer, sizeof(buffer), "Heap (frag/free/max): %u%% |%u b|%u b", heapFrag, heapFree, heapMax);
+    this->nextionConnection.sendCommandValueTxt("vars.ESPFrag.txt", buffer);
 }
 
 /**
  * @brief Syncronize printer data
  */
 void NextionDisplay::syncPrintersData() {
+    char buffer[40];
     this->nextionConnection.sendCommandValueInt("activePrinters", this->globalDataController->numPrintersPrinting());
     this->nextionConnection.sendCommandValueInt("totalPrinters", this->globalDataController->getNumPrinters());
 
     PrinterDataStruct *printerConfigs = globalDataController->getPrinterSettings();
     for(int i=0; i<this->globalDataController->getNumPrinters(); i++) {
+        PrinterViewDataStruct *printerView = this->globalDataController->getViewModel()->getPrinter(i);
         if (printerConfigs[i].state == PRINTER_STATE_ERROR) {
-            this->nextionConnection.sendCommandValueInt("vars.pr" + String(i+1) + "State.val", 3);
+            this->nextionConnection.sendCommandValueInt(this->printerVar(i, "State.val"), 3);
         }
         else if (printerConfigs[i].state == PRINTER_STATE_OFFLINE) {
-            this->nextionConnection.sendCommandValueInt("vars.pr" + String(i+1) + "State.val", 0);
+            this->nextionConnection.sendCommandValueInt(this->printerVar(i, "State.val"), 0);
         }
         else if (printerConfigs[i].state == PRINTER_STATE_STANDBY) {
-            this->nextionConnection.sendCommandValueInt("vars.pr" + String(i+1) + "State.val", 1);
+            this->nextionConnection.sendCommandValueInt(this->printerVar(i, "State.val"), 1);
         }
         else {
-            this->nextionConnection.sendCommandValueInt("vars.pr" + String(i+1) + "State.val", 2);
+            this->nextionConnection.sendCommandValueInt(this->printerVar(i, "State.val"), 2);
         }
-        this->nextionConnection.sendCommandValueTxt("vars.pr" + String(i+1) + "Name.txt", String(printerConfigs[i].customName));
-        this->nextionConnection.sendCommandValueTxt("vars.pr" + String(i+1) + "Type.txt", globalDataController->getPrinterClientType(&printerConfigs[i]) + " | " + String(printerConfigs[i].remoteAddress) + ":" + String(printerConfigs[i].remotePort));
-        this->nextionConnection.sendCommandValueTxt("vars.pr" + String(i+1) + "heIs.txt", String(printerConfigs[i].toolTemp, 1) + "°C");
-        this->nextionConnection.sendCommandValueTxt("vars.pr" + String(i+1) + "heTarget.txt", String(printerConfigs[i].toolTargetTemp, 0) + "°C");
+        this->nextionConnection.sendCommandValueTxt(this->printerVar(i, "Name.txt"), printerConfigs[i].customName);
+        this->nextionConnection.sendCommandValueTxt(this->printerVar(i, "Type.txt"), (String(printerView->clientType) + " | " + printerView->host + (printerView->isCached ? " | cached" : "")).c_str());
+        snprintf(buffer, sizeof(buffer), "%s°C", printerView->toolTemp);
+        this->nextionConnection.sendCommandValueTxt(this->printerVar(i, "heIs.txt"), buffer);
+        snprintf(buffer, sizeof(buffer), "%s°C", printerView->toolTargetTemp);
+        this->nextionConnection.sendCommandValueTxt(this->printerVar(i, "heTarget.txt"), buffer);
         if (printerConfigs[i].bedTemp > 0 ) {
-            this->nextionConnection.sendCommandValueTxt("vars.pr" + String(i+1) + "hbIs.txt", String(printerConfigs[i].bedTemp) + "°C");
-            this->nextionConnection.sendCommandValueTxt("vars.pr" + String(i+1) + "hbTarget.txt", String(printerConfigs[i].bedTargetTemp) + "°C");
-        } else {
-            this->nextionConnection.sendCommandValueTxt("vars.pr" + String(i+1) + "hbIs.txt", "N/A");
-            this->nextionConnection.sendCommandValueTxt("vars.pr" + String(i+1) + "hbTarget.txt", "N/A");
-        }
-
-        if (String(printerConfigs[i].fileName).length() > 0) {
-            this->nextionConnection.sendCommandValueTxt("vars.pr" + String(i+1) + "Job.txt", String(printerConfigs[i].fileName));
+            snprintf(buffer, sizeof(buffer), "%.2f°C", printerConfigs[i].bedTemp);
+            this->nextionConnection.sendCommandValueTxt(this->printerVar(i, "hbIs.txt"), buffer);
+            snprintf(buffer, sizeof(buffer), "%.2f°C", printerConfigs[i].bedTargetTemp);
+            this->nextionConnection.sendCommandValueTxt(this->printerVar(i, "hbTarget.txt"), buffer);
         } else {
-            this->nextionConnection.sendCommandValueTxt("vars.pr" + String(i+1) + "Job.txt", "");
+            this->nextionConnection.sendCommandValueTxt(this->printerVar(i, "hbIs.txt"), "N/A");
+            this->nextionConnection.sendCommandValueTxt(this->printerVar(i, "hbTarget.txt"), "N/A");
         }
-
-        int val = printerConfigs[i].progressPrintTime;
-        int hours = globalDataController->numberOfHours(val);
-        int minutes = globalDataController->numberOfMinutes(val);
-        int seconds = globalDataController->numberOfSeconds(val);
-        this->nextionConnection.sendCommandValueTxt("vars.pr" + String(i+1) + "PrintSince.txt", globalDataController->zeroPad(hours) + ":" + globalDataController->zeroPad(minutes) + ":" + globalDataController->zeroPad(seconds));
-
-        val = printerConfigs[i].progressPrintTimeLeft;
-        hours = globalDataController->numberOfHours(val);
-        minutes = globalDataController->numberOfMinutes(val);
-        seconds = globalDataController->numberOfSeconds(val);
-        this->nextionConnection.sendCommandValueTxt("vars.pr" + String(i+1) + "PrintRemain.txt", globalDataController->zeroPad(hours) + ":" + globalDataController->zeroPad(minutes) + ":" + globalDataController->zeroPad(seconds));
-
-        this->nextionConnection.sendCommandValueTxt("vars.pr" + String(i+1) + "PrintEst.txt", "");
-        this->nextionConnection.sendCommandValueInt("vars.pr" + String(i+1) + "JobPercent.val", printerConfigs[i].progressCompletion);
-        this->nextionConnection.sendCommandValueTxt("vars.pr" + String(i+1) + "PrintError.txt", String(printerConfigs[i].error));
+        this->nextionConnection.sendCommandValueTxt(this->printerVar(i, "Job.txt"), printerConfigs[i].fileName);
+        this->nextionConnection.sendCommandValueTxt(this->printerVar(i, "PrintSince.txt"), printerView->printTime);
+        this->nextionConnection.sendCommandValueTxt(this->printerVar(i, "PrintRemain.txt"), printerView->printTimeLeft);
+        this->nextionConnection.sendCommandValueTxt(this->printerVar(i, "PrintEst.txt"), "");
+        this->nextionConnection.sendCommandValueInt(this->printerVar(i, "JobPercent.val"), printerConfigs[i].progressCompletion);
+        this->nextionConnection.sendCommandValueTxt(this->printerVar(i, "PrintError.txt"), printerConfigs[i].error);
     }
 
     // Automatic switching pages
@@ -310,16 +327,27 @@ void NextionDisplay::syncPrintersData() {
     }
 }
 
+/**
+ * @brief Build the variable name of a printer field (vars.pr[1..n][field])
+ * @param idx               Index of printer
+ * @param field             Field name
+ * @return const char*      Valid until next call
+ */
+const char *NextionDisplay::printerVar(int idx, const char *field) {
+    snprintf(this->varBuffer, sizeof(this->varBuffer), "vars.pr%d%s", idx + 1, field);
+    return this->varBuffer;
+}
+
 /**
  * @brief Retrun ID for weather icon for nextion device
  * @return String 
  */
 String NextionDisplay::getWeatherIconShortId()
 {
-    String weather = this->globalDataController->getWeatherClient()->getWeatherId(0);
-    int id = weather.toInt();
+    OpenWeatherMapClient *weatherClient = this->globalDataController->getWeatherClient();
+    int id = weatherClient->getWeatherId(0);
     String returnVal = "211";
-    bool d = weather.indexOf('d') > 0;
+    bool d = strchr(weatherClient->getIcon(0), 'd') != NULL;
     switch(id)
     {
         case 800:
@@ -16,6 +16,8 @@ private:
     long    lastSyncEpochBasic = 0;
     long    lastSyncEpochExtended = 0;
     int     lastActivePrinters = 0;
+    char    varBuffer[32];
+    int     queueTimer = TIMER_INVALID;
     
 public:
     NextionDisplay(SoftwareSerial *serialPort, GlobalDataController *globalDataController, DebugController *debugController);
@@ -38,4 +40,10 @@ public:
     bool isInTransitionMode() { return false; };
     bool isUpdateable() { return true; };
     void updateFirmware() {};
+    DisplayRenderStatsDataStruct *getRenderStats() { return NULL; };
+    size_t getFrameBufferDumpSize() { return 0; };
+    void sendFrameBuffer(Print *target) {};
+
+private:
+    const char *printerVar(int idx, const char *field);
 };
@@ -4,11 +4,14 @@
  * @brief Construct a new Oled Display:: Oled Display object
  * @param typeName 
  * @param oledDisplay 
+ * @param partialRefresh        Flush statistics of display (can be NULL)
  * @param globalDataController 
  * @param debugController 
  */
-OledDisplay::OledDisplay(String typeName, OLEDDisplay *oledDisplay, GlobalDataController *globalDataController, DebugController *debugController) {
+OledDisplay::OledDisplay(String typeName, OLEDDisplay *oledDisplay, OledPartialRefresh *partialRefresh, GlobalDataController *globalDataController, DebugController *debugController) {
     this->typeName = typeName;
+    this->partialRefresh = partialRefresh;
+    memset(&this->renderStats, 0, sizeof(DisplayRenderStatsDataStruct));
     this->globalDataController = globalDataController;
     this->debugController = debugController;
     this->oledDisplay = oledDisplay;
@@ -43,7 +46,8 @@ void OledDisplay::postSetup(bool isConfigChange) {
         this->overlays[0] = [](OLEDDisplay *display, OLEDDisplayUiState* state) { obj->transitionStateSetter(state); obj->drawInformationHeaderOverlay(display, state); };
         this->setupFramesForInactiveMode();
         this->ui->setFrameAnimation(SLIDE_LEFT);
-        this->ui->setTargetFPS(30);
+        this->ui->setTargetFPS(DISPLAY_OLED_TRANSITION_FPS);
+        this->ui->setTimePerFrame(DISPLAY_OLED_TIME_PER_FRAME);
         this->ui->disableAllIndicators();
         this->ui->enableAutoTransition();
 
@@ -58,6 +62,7 @@ void OledDisplay::postSetup(bool isConfigChange) {
         this->isClockOn = true;
     }
     this->isInitialized = true;
+    this->forceRedraw = true;
 }
 
 /**
@@ -75,6 +80,7 @@ void OledDisplay::setupFramesForInactiveMode()
     this->ui->setOverlays(this->overlays, 0);
     this->ui->disableAutoTransition();
     this->numPages = 1;
+    this->forceRedraw = true;
 
     baseFrameCnt = 0;
     if (this->globalDataController->getWeatherSettings()->show && this->globalDataController->getWeatherSettings()->cityId != 0) {
@@ -117,6 +123,7 @@ void OledDisplay::setupFramesForActiveMode() {
     }
 
     if (frameCnt > 0) {
+        this->forceRedraw = true;
         this->numPages = frameCnt;
         this->ui->setFrames(this->frames, frameCnt);
         this->ui->setOverlays(this->overlays, 1);
@@ -147,8 +154,86 @@ void OledDisplay::firstLoopCompleted() {
  * @brief Handle update screen
  */
 void OledDisplay::handleUpdate() {
+    // Sleep/wake up banner is shown, nothing else to do until its timer is over
+    if (this->globalDataController->getTimerController()->isActive(this->bannerTimer)) {
+        return;
+    }
     this->checkDisplay();
+    if (!this->displayOn || !this->isRedrawNeeded()) {
+        return;
+    }
+
+    // The ui only renders if its frame budget is elapsed, keep the request pending otherwise
+    OLEDDisplayUiState* state = this->ui->getUiState();
+    unsigned long lastUpdate = state->lastUpdate;
+    unsigned long startMicros = micros();
     this->ui->update();
+    if (state->lastUpdate != lastUpdate) {
+        this->forceRedraw = false;
+        this->lastRenderedEpoch = this->globalDataController->getTimeClient()->getCurrentEpoch();
+
+        uint32_t frameMicros = micros() - startMicros;
+        this->renderStats.renderedFrames++;
+        this->renderStats.lastFrameMicros = frameMicros;
+        this->renderStats.maxFrameMicros = _max(this->renderStats.maxFrameMicros, frameMicros);
+        this->totalFrameMicros += frameMicros;
+    }
+}
+
+/**
+ * @brief Render statistics (frames, time per rendered frame incl. flush, flushed bytes)
+ * @return DisplayRenderStatsDataStruct* 
+ */
+DisplayRenderStatsDataStruct *OledDisplay::getRenderStats() {
+    if (this->renderStats.renderedFrames > 0) {
+        this->renderStats.avgFrameMicros = this->totalFrameMicros / this->renderStats.renderedFrames;
+    }
+    if (this->partialRefresh != NULL) {
+        this->renderStats.flushedBytes = this->partialRefresh->getFlushedBytes();
+        this->renderStats.flushedWindows = this->partialRefresh->getFlushedWindows();
+    }
+    return &this->renderStats;
+}
+
+/**
+ * @brief Size of the frame buffer dump (binary PBM)
+ * @return size_t 
+ */
+size_t OledDisplay::getFrameBufferDumpSize() {
+    return OledFrameRenderer::getFrameBufferDumpSize(this->oledDisplay);
+}
+
+/**
+ * @brief Write the last rendered frame as binary PBM (lit pixels are black), e.g. for reference screenshots
+ * @param target            Output
+ */
+void OledDisplay::sendFrameBuffer(Print *target) {
+    OledFrameRenderer::sendFrameBuffer(this->oledDisplay, target);
+}
+
+/**
+ * @brief Adaptive frame rate: render with full FPS only while a transition is animated,
+ * otherwise only if something changed (forced redraw, next second, page switch is due)
+ * @return true     If the ui has to be updated
+ * @return false 
+ */
+bool OledDisplay::isRedrawNeeded() {
+    OLEDDisplayUiState* state = this->ui->getUiState();
+    if (this->forceRedraw || (state->frameState == FrameState::IN_TRANSITION)) {
+        return true;
+    }
+
+    // Page switch is due (the ui adds the skipped ticks by itself on the next update)
+    if (this->numPages > 1) {
+        unsigned long interval = 1000 / DISPLAY_OLED_TRANSITION_FPS;
+        unsigned long shownMillis = (state->ticksSinceLastStateSwitch * interval) + (millis() - state->lastUpdate);
+        if (shownMillis >= DISPLAY_OLED_TIME_PER_FRAME) {
+            return true;
+        }
+    }
+
+    // Clock/time values and synced data changes are visible with the next second
+    return this->globalDataController->getTimeClient()->getCurrentEpoch() != this->lastRenderedEpoch;
 }
 
 /**
@@ -159,6 +244,7 @@ void OledDisplay::flipDisplayUpdate() {
     if (this->globalDataController->getDisplaySettings()->invertDisplay) {
         this->oledDisplay->flipScreenVertically(); // connections at top of OLED display
     }
+    this->forceRedraw = true;
     this->ui->update();
 }
 
@@ -235,16 +321,11 @@ void OledDisplay::checkDisplay() {
         && !this->globalDataController->getWeatherSettings()->show
         && !this->globalDataController->getSensorSettings()->showOnDisplay
     ) {
-        this->oledDisplay->clear();
-        this->oledDisplay->display();
-        this->oledDisplay->setFont(ArialMT_Plain_16);
-        this->oledDisplay->setTextAlignment(TEXT_ALIGN_CENTER);
-        this->oledDisplay->setContrast(255); // default is 255
-        this->oledDisplay->drawString(64, 5, "Printer Offline\nSleep Mode...");
-        this->oledDisplay->display();
-        delay(5000);
-        this->enableDisplay(false);
-        this->debugController->printLn("Printer is offline going down to sleep...");
+        this->showBanner("Printer Offline\nSleep Mode...");
+        this->bannerTimer = this->globalDataController->getTimerController()->once(DISPLAY_OLED_BANNER_MILLIS, [this]() {
+            this->enableDisplay(false);
+            this->debugController->printLn("Printer is offline going down to sleep...");
+        });
         return;
         
     // Show clock, weather, printer states
@@ -256,15 +337,11 @@ void OledDisplay::checkDisplay() {
         if (!this->displayOn && this->globalDataController->isAnyPrinterPrinting()) {
             // Wake the Screen up
             this->enableDisplay(true);
-            this->oledDisplay->clear();
-            this->oledDisplay->display();
-            this->oledDisplay->setFont(ArialMT_Plain_16);
-            this->oledDisplay->setTextAlignment(TEXT_ALIGN_CENTER);
-            this->oledDisplay->setContrast(255); // default is 255
-            this->oledDisplay->drawString(64, 5, "Printer Online\nWake up...");
-            this->oledDisplay->display();
+            this->showBanner("Printer Online\nWake up...");
             this->debugController->printLn("Printer is online waking up...");
-            delay(5000);
+            this->bannerTimer = this->globalDataController->getTimerController()->once(DISPLAY_OLED_BANNER_MILLIS, [this]() {
+                this->forceRedraw = true;
+            });
             return;
         }
 
@@ -282,6 +359,20 @@ void OledDisplay::checkDisplay() {
     }
 }
 
+/**
+ * @brief Show a centered text on the whole display (outside of the ui frames)
+ * @param text 
+ */
+void OledDisplay::showBanner(String text) {
+    this->oledDisplay->clear();
+    this->oledDisplay->display();
+    this->oledDisplay->setFont(ArialMT_Plain_16);
+    this->oledDisplay->setTextAlignment(TEXT_ALIGN_CENTER);
+    this->oledDisplay->setContrast(255); // default is 255
+    this->oledDisplay->drawString(64, 5, text);
+    this->oledDisplay->display();
+}
+
 /**
  * @brief Enable or disable dispay when not in use
  * @param enable 
@@ -296,6 +387,7 @@ void OledDisplay::enableDisplay(boolean enable) {
             this->displayOffEpoch = 0;  // reset
         }
         this->oledDisplay->displayOn();
+        this->forceRedraw = true;
         this->debugController->printLn("Display was turned ON: " + timeClient->getFormattedTime());
     } else {
         this->oledDisplay->displayOff();
@@ -317,87 +409,20 @@ void OledDisplay::drawPrinterState(OLEDDisplay *display, OLEDDisplayUiState* sta
     if (this->lastFixedFrame < 0) {
         this->lastFixedFrame = state->currentFrame;
     }
-    PrinterDataStruct refPrinter = this->globalDataController->getPrinterSettings()[this->frameToPrinterHandle[state->currentFrame - this->frameToPrinterHandleOffset]];
+    int printerIdx = this->frameToPrinterHandle[state->currentFrame - this->frameToPrinterHandleOffset];
     if ((x > 0) && (state->frameState == FrameState::IN_TRANSITION)) {
         int nextFrame = state->currentFrame + 1;
         if ((this->numPrintersPrinting + this->frameToPrinterHandleOffset) <= nextFrame) {
             nextFrame = 0;
         }
         if (nextFrame >= this->frameToPrinterHandleOffset) {
-            refPrinter = this->globalDataController->getPrinterSettings()[this->frameToPrinterHandle[nextFrame - this->frameToPrinterHandleOffset]];
+            printerIdx = this->frameToPrinterHandle[nextFrame - this->frameToPrinterHandleOffset];
         }
     }
+    PrinterDataStruct *refPrinter = &this->globalDataController->getPrinterSettings()[printerIdx];
+    PrinterViewDataStruct *refView = this->globalDataController->getViewModel()->getPrinter(printerIdx);
 
-    // Draw printer state data
-    display->setTextAlignment(TEXT_ALIGN_LEFT);
-    display->setFont(ArialMT_Plain_10);
-    display->drawString(x, 13 + y, String(refPrinter.customName));
-
-    // State
-    int yPos = 24 + y;
-    display->setTextAlignment(TEXT_ALIGN_RIGHT);
-    display->setFont(ArialMT_Plain_24);
-    int progressPercent = refPrinter.progressCompletion;
-    if (progressPercent > 99) {
-        progressPercent = 99;
-    }
-    display->drawString(display->width() + x, yPos, String(progressPercent) + "%");
-
-    // Time
-    display->setFont(ArialMT_Plain_10);
-    display->setTextAlignment(TEXT_ALIGN_LEFT);
-
-    int val = refPrinter.progressPrintTimeLeft;
-    int hours = this->globalDataController->numberOfHours(val);
-    int minutes = this->globalDataController->numberOfMinutes(val);
-    int seconds = this->globalDataController->numberOfSeconds(val);
-    String timeLeft = this->globalDataController->zeroPad(hours) + ":" + 
-        this->globalDataController->zeroPad(minutes) + ":" + 
-        this->globalDataController->zeroPad(seconds);
-    val = refPrinter.progressPrintTime;
-    hours = this->globalDataController->numberOfHours(val);
-    minutes = this->globalDataController->numberOfMinutes(val);
-    seconds = this->globalDataController->numberOfSeconds(val);
-    String timePrint = this->globalDataController->zeroPad(hours) + ":" + 
-        this->globalDataController->zeroPad(minutes) + ":" + 
-        this->globalDataController->zeroPad(seconds);
-
-    display->drawString(x, yPos, "D: " + timePrint);
-    display->drawString(x, yPos + 11, "L: " + timeLeft);
-
-    // Temps
-    int blockWidth = display->width() / 2;
-    int tOff = 10;
-    int splitBlock = (blockWidth - tOff) / 2;
-    yPos = display->height() - 12 + y;
-    display->setFont(ArialMT_Plain_10);
-    display->setTextAlignment(TEXT_ALIGN_RIGHT);
-    display->drawRect(x, yPos, blockWidth, 12);
-    display->drawRect(x + blockWidth, yPos, blockWidth, 12);
-
-    display->fillRect(x, yPos, tOff, 12);
-    display->fillRect(x + splitBlock + tOff, yPos, splitBlock, 12);    
-    display->drawString(x + splitBlock + tOff - 2, yPos - 1, String(refPrinter.toolTemp, 0));
-    if (refPrinter.bedTemp != 0) {
-        display->fillRect(x + blockWidth, yPos, tOff, 12);
-        display->fillRect(x + blockWidth + splitBlock + tOff, yPos, splitBlock, 12);
-        display->drawString(x + blockWidth + splitBlock + tOff - 2, yPos - 1, String(refPrinter.bedTemp, 0));
-    }
-
-    display->setColor(OLEDDISPLAY_COLOR::BLACK);
-    display->setTextAlignment(TEXT_ALIGN_LEFT);
-    display->drawString(x + splitBlock + tOff + 2, yPos - 1, String(refPrinter.toolTargetTemp, 0));
-    display->drawString(x + 2, yPos - 1, "T");
-    if (refPrinter.bedTemp != 0) {
-        display->drawString(x + blockWidth + splitBlock + tOff + 2, yPos - 1, String(refPrinter.bedTargetTemp, 0));
-        display->drawString(x + blockWidth + 2, yPos - 1, "B");
-    }
-
-    // Split blocks!
-    display->fillRect(x + blockWidth - 1, yPos, 2, 12);
-
-    // Reset settings!
-    display->setColor(OLEDDISPLAY_COLOR::WHITE);
+    OledFrameRenderer::drawPrinterState(display, refPrinter, refView, x, y);
 }
 
 /**
@@ -409,14 +434,7 @@ void OledDisplay::drawPrinterState(OLEDDisplay *display, OLEDDisplayUiState* sta
  * @param y 
  */
 void OledDisplay::drawClock(OLEDDisplay *display, OLEDDisplayUiState* state, int16_t x, int16_t y) {
-    TimeClient * timeClient = this->globalDataController->getTimeClient();
-    display->setTextAlignment(TEXT_ALIGN_CENTER);
-    String displayTime = timeClient->getAmPmHours() + ":" + timeClient->getMinutes();
-    if (this->globalDataController->getClockSettings()->is24h) {
-        displayTime = timeClient->getHours() + ":" + timeClient->getMinutes(); 
-    }
-    display->setFont(ArialMT_Plain_24);
-    display->drawString(64 + x, 20 + y, displayTime);
+    OledFrameRenderer::drawClock(display, this->globalDataController->getTimeView(), x, y);
     this->drawRssi(display);
 }
 
@@ -428,22 +446,7 @@ void OledDisplay::drawClock(OLEDDisplay *display, OLEDDisplayUiState* state, int
  * @param y 
  */
 void OledDisplay::drawWeatherOutdoor(OLEDDisplay *display, OLEDDisplayUiState* state, int16_t x, int16_t y) {
-    OpenWeatherMapClient *weatherClient = this->globalDataController->getWeatherClient();
-
-    display->setTextAlignment(TEXT_ALIGN_LEFT);
-    display->setFont(ArialMT_Plain_10);
-    display->drawString(0 + x, 13 + y, weatherClient->getCity(0));
-
-    display->setTextAlignment(TEXT_ALIGN_LEFT);
-    display->setFont(ArialMT_Plain_24);
-    display->drawString(0 + x, 24 + y, weatherClient->getTempRounded(0) + weatherClient->getTempSymbol());
-
-    display->setFont((const uint8_t*)Meteocons_Plain_42);
-    display->drawString(84 + x, 14 + y, weatherClient->getWeatherIcon(0));
-
-    display->setTextAlignment(TEXT_ALIGN_LEFT);
-    display->setFont(ArialMT_Plain_10);
-    display->drawString(0 + x, 50 + y, weatherClient->getCondition(0));
+    OledFrameRenderer::drawWeatherOutdoor(display, this->globalDataController->getViewModel()->getWeather(), x, y);
 }
 
 /**
@@ -456,25 +459,8 @@ void OledDisplay::drawWeatherOutdoor(OLEDDisplay *display, OLEDDisplayUiState* s
 void OledDisplay::drawWeatherIndoor(OLEDDisplay *display, OLEDDisplayUiState* state, int16_t x, int16_t y) {
     SensorDataStruct *sensorSettings = this->globalDataController->getSensorSettings();
     BaseSensorClient *sensorClient = this->globalDataController->getSensorClient(sensorSettings);
-
-    display->setTextAlignment(TEXT_ALIGN_LEFT);
-    display->setFont(ArialMT_Plain_10);
-    display->drawString(0 + x, 13 + y, "Indoor");
-
-    display->setFont(ArialMT_Plain_24);
-    display->setTextAlignment(TEXT_ALIGN_LEFT);
-    display->drawString(0 + x, 24 + y, sensorClient->getTemperatureRounded(sensorSettings)  + "°C");
-
-    if (sensorClient->hasHumidity()) {
-        display->setTextAlignment(TEXT_ALIGN_RIGHT);
-        display->drawString(126 + x, 24 + y, sensorClient->getHumidityRounded(sensorSettings)  + "%");
-    }
-
-    if (sensorClient->hasAirQuality()) {
-        display->setTextAlignment(TEXT_ALIGN_LEFT);
-        display->setFont(ArialMT_Plain_10);
-        display->drawString(0 + x, 50 + y, "Air quality: " + sensorClient->airQualityAsString(sensorSettings));
-    }   
+    SensorViewDataStruct *sensorView = this->globalDataController->getViewModel()->getSensor();
+    OledFrameRenderer::drawWeatherIndoor(display, sensorView, sensorClient->hasHumidity(), sensorClient->hasAirQuality(), x, y);
 }
 
 /**
@@ -483,37 +469,7 @@ void OledDisplay::drawWeatherIndoor(OLEDDisplay *display, OLEDDisplayUiState* st
  * @param state 
  */
 void OledDisplay::drawInformationHeaderOverlay(OLEDDisplay *display, OLEDDisplayUiState* state) {
-    TimeClient * timeClient = this->globalDataController->getTimeClient();
-    display->setColor(WHITE);
-    display->setFont(ArialMT_Plain_10);  
-    
-    if (!this->globalDataController->getClockSettings()->is24h) {
-        String displayTime = timeClient->getAmPmHours() + ":" + timeClient->getMinutes();
-        display->setTextAlignment(TEXT_ALIGN_RIGHT);
-        display->drawString(25, 0, displayTime);
-        String ampm = timeClient->getAmPm();
-        display->setTextAlignment(TEXT_ALIGN_LEFT);
-        display->drawString(27, 0, ampm);
-    } else {
-        String displayTime = timeClient->getHours() + ":" + timeClient->getMinutes();
-        display->setTextAlignment(TEXT_ALIGN_LEFT);
-        display->drawString(0, 0, displayTime);
-    }
-
-    // Draw pages blobs
-    if (this->numPages > 1) {
-        int xPos = 110 - (this->numPages * 6);
-        for(int i=0; i<this->numPages; i++) {
-            if (i == state->currentFrame) {
-                display->fillCircle(xPos, 5, 2);
-            } else {
-                display->drawCircle(xPos, 5, 2);
-            }
-            xPos += 6;
-        }
-    }
-
-    display->drawHorizontalLine(0, 11, 128);
+    OledFrameRenderer::drawInformationHeader(display, this->globalDataController->getTimeView(), this->numPages, state->currentFrame);
     this->drawRssi(display);
 }
 
@@ -5,8 +5,9 @@
 #include <OLEDDisplayUi.h>
 #include <OLEDDisplay.h>
 #include "../../include/OledLogo.h"
-#include "../../include/WeatherStationFonts.h"
 #include "BaseDisplayClient.h"
+#include "Extras/Oled/OledPartialRefresh.h"
+#include "Extras/Oled/OledFrameRenderer.h"
 
 /**
  * @brief OLED 128x64 implementation
@@ -16,12 +17,18 @@ private:
     GlobalDataController *globalDataController;
     DebugController *debugController;
     OLEDDisplay *oledDisplay;
+    OledPartialRefresh *partialRefresh;
+    DisplayRenderStatsDataStruct renderStats;
+    uint64_t totalFrameMicros = 0;
     OLEDDisplayUi *ui;
     int numPages = 0;
     boolean displayOn = true;
     long displayOffEpoch = 0;
     bool inTransition = false;
     bool isInitialized = false;
+    bool forceRedraw = true;
+    long lastRenderedEpoch = -1;
+    int bannerTimer = TIMER_INVALID;
 
     OverlayCallback overlays[1];
     FrameCallback baseFrame[2];
@@ -36,7 +43,7 @@ private:
     String typeName;
 
 public:
-    OledDisplay(String typeName, OLEDDisplay *oledDisplay, GlobalDataController *globalDataController, DebugController *debugController);
+    OledDisplay(String typeName, OLEDDisplay *oledDisplay, OledPartialRefresh *partialRefresh, GlobalDataController *globalDataController, DebugController *debugController);
     void preSetup();
     void postSetup(bool isConfigChange);
     void firstLoopCompleted();
@@ -59,9 +66,14 @@ public:
     String getType() { return this->typeName; };
     bool isUpdateable() { return false; };
     void updateFirmware() {};
+    DisplayRenderStatsDataStruct *getRenderStats();
+    size_t getFrameBufferDumpSize();
+    void sendFrameBuffer(Print *target);
 private:
     void setupFramesForInactiveMode();
     void setupFramesForActiveMode();
     void drawImage(int16_t xMove, int16_t yMove, int16_t width, int16_t height, const uint8_t *xbm);
     void transitionStateSetter(OLEDDisplayUiState* state);
+    bool isRedrawNeeded();
+    void showBanner(String text);
 };
\ No newline at end of file
@@ -0,0 +1,118 @@
+#include "BinaryConfigFile.h"
+
+/**
+ * @brief Read all records of a binary config file with a single read
+ * @param fileName          File to read
+ * @param recordSize        Expected size of one record
+ * @param maxRecords        Maximum number of records accepted
+ * @param recordCount       Number of records read
+ * @return void*            Records (release with free()) or NULL if file is missing/invalid
+ */
+void *BinaryConfigFile::read(const char *fileName, size_t recordSize, uint16_t maxRecords, uint16_t *recordCount) {
+    *recordCount = 0;
+    File f = LittleFS.open(fileName, "r");
+    if (!f) {
+        return NULL;
+    }
+
+    ConfigHeaderDataStruct header;
+    if ((f.read((uint8_t *)&header, sizeof(header)) != sizeof(header))
+        || (header.magic != CONFIG_BINARY_MAGIC)
+        || (header.version != CONFIG_BINARY_VERSION)
+        || (header.recordSize != recordSize)
+        || (header.recordCount > maxRecords)
+    ) {
+        f.close();
+        return NULL;
+    }
+
+    size_t payloadSize = recordSize * header.recordCount;
+    // Allocate at least one record, an empty printer list is valid
+    uint8_t *records = (uint8_t *)malloc(payloadSize > 0 ? payloadSize : recordSize);
+    if (records == NULL) {
+        f.close();
+        return NULL;
+    }
+    size_t readBytes = payloadSize > 0 ? f.read(records, payloadSize) : 0;
+    f.close();
+    if ((readBytes != payloadSize) || (BinaryConfigFile::crc32(records, payloadSize) != header.crc)) {
+        free(records);
+        return NULL;
+    }
+    *recordCount = header.recordCount;
+    return records;
+}
+
+/**
+ * @brief Write records as binary config file (temporary file, replaced after success)
+ * @param fileName          File to write
+ * @param records           Records to store
+ * @param recordSize        Size of one record
+ * @param recordCount       Number of records
+ * @return true             Written successfully
+ * @return false 
+ */
+bool BinaryConfigFile::write(const char *fileName, const void *records, size_t recordSize, uint16_t recordCount) {
+    ConfigHeaderDataStruct header;
+    size_t payloadSize = recordSize * recordCount;
+    header.magic = CONFIG_BINARY_MAGIC;
+    header.version = CONFIG_BINARY_VERSION;
+    header.recordSize = recordSize;
+    header.recordCount = recordCount;
+    header.reserved = 0;
+    header.crc = BinaryConfigFile::crc32(records, payloadSize);
+
+    File f = LittleFS.open(BinaryConfigFile::tempFileName(fileName), "w");
+    if (!f) {
+        return false;
+    }
+    bool success = f.write((const uint8_t *)&header, sizeof(header)) == sizeof(header);
+    if (success && (payloadSize > 0)) {
+        success = f.write((const uint8_t *)records, payloadSize) == payloadSize;
+    }
+    f.close();
+    return success && BinaryConfigFile::commit(fileName);
+}
+
+/**
+ * @brief Name of the temporary file used to write a config file
+ * @param fileName          Target file
+ * @return String 
+ */
+String BinaryConfigFile::tempFileName(const char *fileName) {
+    return String(fileName) + CONFIG_TEMP_SUFFIX;
+}
+
+/**
+ * @brief Replace a config file with its written temporary file.
+ * The rename is atomic, so a power loss leaves either the old or the new file.
+ * @param fileName          Target file
+ * @return true             File replaced
+ * @return false 
+ */
+bool BinaryConfigFile::commit(const char *fileName) {
+    String tempName = BinaryConfigFile::tempFileName(fileName);
+    if (LittleFS.rename(tempName, fileName)) {
+        return true;
+    }
+    LittleFS.remove(tempName);
+    return false;
+}
+
+/**
+ * @brief CRC-32 (IEEE 802.3) of a memory block
+ * @param data              Data to check
+ * @param length            Length of data
+ * @return uint32_t 
+ */
+uint32_t BinaryConfigFile::crc32(const void *data, size_t length) {
+    const uint8_t *bytes = (const uint8_t *)data;
+    uint32_t crc = 0xFFFFFFFF;
+    for (size_t i = 0; i < length; i++) {
+        crc ^= bytes[i];
+        for (int bit = 0; bit < 8; bit++) {
+            crc = (crc >> 1) ^ (0xEDB88320 & (0 - (crc & 1)));
+        }
+    }
+    return ~crc;
+}
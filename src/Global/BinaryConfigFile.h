@@ -0,0 +1,21 @@
+#pragma once
+#include <Arduino.h>
+#include <LittleFS.h>
+#include "../DataStructs/ConfigDataStruct.h"
+
+// Suffix of the temporary file written before a config file is replaced
+#define CONFIG_TEMP_SUFFIX          ".tmp"
+
+/**
+ * @brief Reads and writes config records as binary file with version header and CRC
+ * A file is only accepted if magic, version, record size and CRC match, so a changed
+ * struct layout or a damaged file is detected and the caller can fall back to defaults/import.
+ */
+class BinaryConfigFile {
+public:
+    static void *read(const char *fileName, size_t recordSize, uint16_t maxRecords, uint16_t *recordCount);
+    static bool write(const char *fileName, const void *records, size_t recordSize, uint16_t recordCount);
+    static uint32_t crc32(const void *data, size_t length);
+    static String tempFileName(const char *fileName);
+    static bool commit(const char *fileName);
+};
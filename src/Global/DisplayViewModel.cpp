@@ -0,0 +1,200 @@
+#include "DisplayViewModel.h"
+
+/**
+ * @brief Construct a new Display View Model:: Display View Model object
+ */
+DisplayViewModel::DisplayViewModel() {
+    memset(this->printers, 0, sizeof(this->printers));
+    memset(&this->time, 0, sizeof(TimeViewDataStruct));
+    memset(&this->weather, 0, sizeof(WeatherViewDataStruct));
+    memset(&this->sensor, 0, sizeof(SensorViewDataStruct));
+    this->time.epoch = -1;
+}
+
+/**
+ * @brief Format all values of a printer after sync or configuration change
+ * @param idx               Index of printer
+ * @param printerHandle     Handle to printer data
+ * @param clientType        Name of the printer api client
+ * @return true             Formatted values have changed
+ * @return false 
+ */
+bool DisplayViewModel::updatePrinter(int idx, PrinterDataStruct *printerHandle, String clientType) {
+    if ((idx < 0) || (idx >= MAX_PRINTERS)) {
+        return false;
+    }
+    PrinterViewDataStruct *view = &this->printers[idx];
+    PrinterViewDataStruct previous;
+    memcpy(&previous, view, sizeof(PrinterViewDataStruct));
+
+    ViewFormatter::formatPrinter(view, printerHandle, clientType.c_str());
+    return memcmp(&previous, view, sizeof(PrinterViewDataStruct)) != 0;
+}
+
+/**
+ * @brief Format all weather values after weather sync
+ * @param weatherClient     Handle to weather client
+ * @return true             Formatted values have changed
+ * @return false 
+ */
+bool DisplayViewModel::updateWeather(OpenWeatherMapClient *weatherClient) {
+    WeatherViewDataStruct *view = &this->weather;
+    WeatherViewDataStruct previous;
+    memcpy(&previous, view, sizeof(WeatherViewDataStruct));
+    String symbol = weatherClient->getTempSymbol();
+
+    view->isValid = strlen(weatherClient->getCity(0)) > 0;
+    view->isCached = false;
+    strncpy(view->city, weatherClient->getCity(0), sizeof(view->city) - 1);
+    strncpy(view->country, weatherClient->getCountry(0), sizeof(view->country) - 1);
+    snprintf(view->location, sizeof(view->location), "Lat: %.2f, Lon: %.2f", weatherClient->getLat(0), weatherClient->getLon(0));
+    snprintf(view->temperatureRounded, sizeof(view->temperatureRounded), "%d", weatherClient->getTempRounded(0));
+    snprintf(view->temperature, sizeof(view->temperature), "%s%s", view->temperatureRounded, symbol.c_str());
+    snprintf(view->temperatureHtml, sizeof(view->temperatureHtml), "%s%s", view->temperatureRounded, weatherClient->getTempSymbol(true).c_str());
+    snprintf(view->humidityRounded, sizeof(view->humidityRounded), "%d", weatherClient->getHumidityRounded(0));
+    snprintf(view->humidity, sizeof(view->humidity), "%s%%", view->humidityRounded);
+    snprintf(view->wind, sizeof(view->wind), "%d %s", weatherClient->getWindRounded(0), weatherClient->getSpeedSymbol().c_str());
+    strncpy(view->condition, weatherClient->getCondition(0), sizeof(view->condition) - 1);
+    strncpy(view->description, weatherClient->getDescription(0), sizeof(view->description) - 1);
+    strncpy(view->icon, weatherClient->getIcon(0), sizeof(view->icon) - 1);
+    strncpy(view->iconGlyph, weatherClient->getWeatherIcon(0), sizeof(view->iconGlyph) - 1);
+    MemoryHelper::stringToChar(weatherClient->getError(), view->error, sizeof(view->error) - 1);
+    return memcmp(&previous, view, sizeof(WeatherViewDataStruct)) != 0;
+}
+
+/**
+ * @brief Format weather values restored from the warm start snapshot (marked as cached)
+ * @param cachedWeather     Last known weather
+ * @param weatherClient     Handle to weather client (units)
+ * @return true             Formatted values have changed
+ * @return false 
+ */
+bool DisplayViewModel::restoreWeather(WarmStartWeatherDataStruct *cachedWeather, OpenWeatherMapClient *weatherClient) {
+    WeatherViewDataStruct *view = &this->weather;
+    WeatherViewDataStruct previous;
+    memcpy(&previous, view, sizeof(WeatherViewDataStruct));
+    memset(view, 0, sizeof(WeatherViewDataStruct));
+    char rounded[8];
+
+    view->isValid = true;
+    view->isCached = true;
+    ViewFormatter::formatFloat(rounded, sizeof(rounded), cachedWeather->temperature, 0);
+    strncpy(view->temperatureRounded, rounded, sizeof(view->temperatureRounded) - 1);
+    strncpy(view->city, cachedWeather->city, _min(sizeof(view->city), sizeof(cachedWeather->city)) - 1);
+    strncpy(view->country, cachedWeather->country, _min(sizeof(view->country), sizeof(cachedWeather->country)) - 1);
+    snprintf(view->temperature, sizeof(view->temperature), "%s%s", rounded, weatherClient->getTempSymbol().c_str());
+    snprintf(view->temperatureHtml, sizeof(view->temperatureHtml), "%s%s", rounded, weatherClient->getTempSymbol(true).c_str());
+    ViewFormatter::formatFloat(rounded, sizeof(rounded), cachedWeather->humidity, 0);
+    strncpy(view->humidityRounded, rounded, sizeof(view->humidityRounded) - 1);
+    snprintf(view->humidity, sizeof(view->humidity), "%s%%", rounded);
+    ViewFormatter::formatFloat(rounded, sizeof(rounded), cachedWeather->wind, 0);
+    snprintf(view->wind, sizeof(view->wind), "%s %s", rounded, weatherClient->getSpeedSymbol().c_str());
+    snprintf(view->condition, sizeof(view->condition), "Cached: %.*s", (int)sizeof(cachedWeather->condition), cachedWeather->condition);
+    strncpy(view->description, cachedWeather->description, _min(sizeof(view->description), sizeof(cachedWeather->description)) - 1);
+    strncpy(view->icon, cachedWeather->icon, _min(sizeof(view->icon), sizeof(cachedWeather->icon)) - 1);
+    strncpy(view->iconGlyph, cachedWeather->iconGlyph, sizeof(view->iconGlyph) - 1);
+    return memcmp(&previous, view, sizeof(WeatherViewDataStruct)) != 0;
+}
+
+/**
+ * @brief Format all sensor values after sensor sync
+ * @param sensorHandle      Handle to sensor data
+ * @param sensorClient      Handle to sensor client (can be NULL)
+ * @return true             Formatted values have changed
+ * @return false 
+ */
+bool DisplayViewModel::updateSensor(SensorDataStruct *sensorHandle, BaseSensorClient *sensorClient) {
+    SensorViewDataStruct *view = &this->sensor;
+    SensorViewDataStruct previous;
+    memcpy(&previous, view, sizeof(SensorViewDataStruct));
+    memset(view, 0, sizeof(SensorViewDataStruct));
+    if (sensorClient == NULL) {
+        return memcmp(&previous, view, sizeof(SensorViewDataStruct)) != 0;
+    }
+    view->isCached = sensorHandle->cachedEpoch > 0;
+    snprintf(view->type, sizeof(view->type), "%s%s", sensorClient->getType().c_str(), view->isCached ? " (cached)" : "");
+    ViewFormatter::formatFloat(view->temperature, sizeof(view->temperature), sensorHandle->temperature, 1);
+    ViewFormatter::formatFloat(view->temperatureRounded, sizeof(view->temperatureRounded), sensorHandle->temperature, 0);
+    ViewFormatter::formatFloat(view->humidity, sizeof(view->humidity), sensorHandle->humidity, 1);
+    ViewFormatter::formatFloat(view->humidityRounded, sizeof(view->humidityRounded), sensorHandle->humidity, 0);
+    ViewFormatter::formatFloat(view->pressure, sizeof(view->pressure), sensorHandle->pressure, 1);
+    ViewFormatter::formatFloat(view->altitude, sizeof(view->altitude), sensorHandle->altitude, 1);
+    if (!view->isCached && (sensorHandle->sampleCount > 1)) {
+        snprintf(view->temperatureRange, sizeof(view->temperatureRange), "%.1f-%.1f", sensorHandle->temperatureStats.min, sensorHandle->temperatureStats.max);
+        snprintf(view->humidityRange, sizeof(view->humidityRange), "%.0f-%.0f", sensorHandle->humidityStats.min, sensorHandle->humidityStats.max);
+    }
+    if (sensorClient->hasAirQuality()) {
+        MemoryHelper::stringToChar(sensorClient->airQualityAsString(sensorHandle), view->airQuality, sizeof(view->airQuality) - 1);
+        view->airQualityValue = sensorClient->airQualityAsInt(sensorHandle);
+    }
+    return memcmp(&previous, view, sizeof(SensorViewDataStruct)) != 0;
+}
+
+/**
+ * @brief Get preformatted printer values
+ * @param idx                       Index of printer
+ * @return PrinterViewDataStruct* 
+ */
+PrinterViewDataStruct *DisplayViewModel::getPrinter(int idx) {
+    if ((idx < 0) || (idx >= MAX_PRINTERS)) {
+        idx = 0;
+    }
+    return &this->printers[idx];
+}
+
+/**
+ * @brief Get preformatted time values, formatted again if the second has changed
+ * @param timeClient            Handle to time client
+ * @param is24h                 Format for 24h clock
+ * @return TimeViewDataStruct* 
+ */
+TimeViewDataStruct *DisplayViewModel::getTime(TimeClient *timeClient, bool is24h) {
+    long epoch = timeClient->getCurrentEpoch();
+    if ((epoch == this->time.epoch) && (is24h == this->time.is24h)) {
+        return &this->time;
+    }
+    TimeViewDataStruct *view = &this->time;
+    view->epoch = epoch;
+    view->is24h = is24h;
+
+    if (!timeClient->isTimeValid()) {
+        strcpy(view->hours, "--");
+        strcpy(view->minutes, "--");
+        strcpy(view->seconds, "--");
+        strcpy(view->amPmHours, "12");
+        strcpy(view->amPm, "AM");
+    } else {
+        int hours = timeClient->getHoursNumber();
+        int amPmHours = hours > 12 ? hours - 12 : hours;
+        snprintf(view->hours, sizeof(view->hours), "%02d", hours);
+        snprintf(view->minutes, sizeof(view->minutes), "%02d", timeClient->getMinutesNumber());
+        snprintf(view->seconds, sizeof(view->seconds), "%02d", timeClient->getSecondsNumber());
+        snprintf(view->amPmHours, sizeof(view->amPmHours), "%d", amPmHours == 0 ? 12 : amPmHours);
+        strcpy(view->amPm, hours >= 12 ? "PM" : "AM");
+    }
+
+    if (is24h) {
+        snprintf(view->clockShort, sizeof(view->clockShort), "%s:%s", view->hours, view->minutes);
+        snprintf(view->clockLong, sizeof(view->clockLong), "%s:%s:%s", view->hours, view->minutes, view->seconds);
+    } else {
+        snprintf(view->clockShort, sizeof(view->clockShort), "%s:%s", view->amPmHours, view->minutes);
+        snprintf(view->clockLong, sizeof(view->clockLong), "%s:%s:%s %s", view->amPmHours, view->minutes, view->seconds, view->amPm);
+    }
+    return view;
+}
+
+/**
+ * @brief Get preformatted weather values
+ * @return WeatherViewDataStruct* 
+ */
+WeatherViewDataStruct *DisplayViewModel::getWeather() {
+    return &this->weather;
+}
+
+/**
+ * @brief Get preformatted sensor values
+ * @return SensorViewDataStruct* 
+ */
+SensorViewDataStruct *DisplayViewModel::getSensor() {
+    return &this->sensor;
+}
@@ -0,0 +1,37 @@
+#pragma once
+#include <Arduino.h>
+#include <ESP8266WiFi.h>
+#include "Configuration.h"
+#include "../DataStructs/ViewModelDataStruct.h"
+#include "../DataStructs/PrinterDataStruct.h"
+#include "../DataStructs/SensorDataStruct.h"
+#include "../DataStructs/WarmStartDataStruct.h"
+#include "../Network/TimeClient.h"
+#include "../Network/OpenWeatherMapClient.h"
+#include "../Sensors/BaseSensorClient.h"
+#include "../../include/MemoryHelper.h"
+#include "ViewFormatter.h"
+
+/**
+ * @brief Preformatted values for all renderers (OLED, Nextion, webinterface)
+ * Values are formatted once per data change (time once per second) into fixed buffers,
+ * so the renderers do not need to build temporary strings on every frame or request.
+ */
+class DisplayViewModel {
+private:
+    PrinterViewDataStruct printers[MAX_PRINTERS];
+    TimeViewDataStruct time;
+    WeatherViewDataStruct weather;
+    SensorViewDataStruct sensor;
+
+public:
+    DisplayViewModel();
+    bool updatePrinter(int idx, PrinterDataStruct *printerHandle, String clientType);
+    bool updateWeather(OpenWeatherMapClient *weatherClient);
+    bool restoreWeather(WarmStartWeatherDataStruct *cachedWeather, OpenWeatherMapClient *weatherClient);
+    bool updateSensor(SensorDataStruct *sensorHandle, BaseSensorClient *sensorClient);
+    PrinterViewDataStruct *getPrinter(int idx);
+    TimeViewDataStruct *getTime(TimeClient *timeClient, bool is24h);
+    WeatherViewDataStruct *getWeather();
+    SensorViewDataStruct *getSensor();
+};
@@ -3,14 +3,21 @@
 /**
  * @brief Initialize class for all needed data
  */
-GlobalDataController::GlobalDataController(TimeClient *timeClient, OpenWeatherMapClient *weatherClient, DebugController *debugController) {
+GlobalDataController::GlobalDataController(TimeClient *timeClient, TimerController *timerController, OpenWeatherMapClient *weatherClient, DebugController *debugController) {
      this->timeClient = timeClient;
+     this->timerController = timerController;
      this->weatherClient = weatherClient;
      this->debugController = debugController;
      this->printers = (PrinterDataStruct *)malloc(1 * sizeof(PrinterDataStruct));
      this->basePrinterClients = (BasePrinterClient**)malloc(1 * sizeof(int));
      this->baseSensorClients = (BaseSensorClient**)malloc(1 * sizeof(int));
      this->baseDisplayClient = (BaseDisplayClient**)malloc(1 * sizeof(int));
+     memset(this->printerStateVersions, 0, sizeof(this->printerStateVersions));
+     memset(this->printerTextHashes, 0, sizeof(this->printerTextHashes));
+     memset(&this->cachedWeather, 0, sizeof(this->cachedWeather));
+     this->systemData.bootQuickConnect = false;
+     this->systemData.bootWifiMillis = 0;
+     this->systemData.bootDataMillis = 0;
      this->initDefaultConfig();
 }
 
@@ -18,6 +25,8 @@ GlobalDataController::GlobalDataController(TimeClient *timeClient, OpenWeatherMa
  * @brief Setup global controller
  */
 void GlobalDataController::setup() {
+    // State versions restart with every boot, clients notice that by the boot id
+    this->stateBootId = ESP.random();
     this->listSettingFiles();
     this->readSettings();
 
@@ -28,7 +37,12 @@ void GlobalDataController::setup() {
     this->weatherClient->updateCityId(this->weatherData.cityId);
     this->timeClient->setUtcOffset(this->clockData.utcOffset);
     this->timeClient->resetLastEpoch();
+    this->restoreWarmStart();
     this->getDisplayClient()->postSetup(true);
+
+    this->timerController->every(WARMSTART_SNAPSHOT_SEC * 1000, [this]() {
+        this->storeWarmStart(true);
+    });
 }
 
 /**
@@ -47,17 +61,114 @@ void GlobalDataController::listSettingFiles() {
 
 /**
  * @brief Read all setting from eeprom
+ * Binary settings are loaded directly, the text files are only imported if there are no valid binary settings
  */
 void GlobalDataController::readSettings() {
-    if ((LittleFS.exists(CONFIG) == false) || (LittleFS.exists(PRINTERCONFIG) == false)) {
-        this->debugController->printLn("Settings File does not yet exists.");
-        this->writeSettings();
-        return;
-    }
-
     // Reset internal data!
     this->initDefaultConfig();
 
+    // Read times are logged to compare binary and text settings on the device
+    unsigned long readStartMicros = micros();
+    if (this->readBinarySettings()) {
+        this->debugController->printLn("Binary settings read in " + String(micros() - readStartMicros) + " us ("
+            + String(this->printersCnt) + " printers)");
+    } else {
+        if ((LittleFS.exists(CONFIG) == false) || (LittleFS.exists(PRINTERCONFIG) == false)) {
+            this->debugController->printLn("Settings File does not yet exists.");
+            this->writeSettings();
+        } else {
+            this->debugController->printLn("Import settings from text files");
+            readStartMicros = micros();
+            this->importTextSettings();
+            this->debugController->printLn("Text settings read in " + String(micros() - readStartMicros) + " us ("
+                + String(this->printersCnt) + " printers)");
+            this->writeBinaryBasicSettings();
+            this->writeBinaryPrinterSettings();
+        }
+    }
+
+    // Reset printer data
+    for(int i=0; i<this->printersCnt; i++) {
+        this->printers[i].id = ++this->lastPrinterId;
+        BasePrinterClient::resetPrinterData(&this->printers[i]);
+        this->updatePrinterView(&this->printers[i]);
+    }
+    if (this->viewModel.updateSensor(&this->sensorData, this->getSensorClient(&this->sensorData))) {
+        this->sensorStateVersion = this->nextStateVersion();
+    }
+    this->markConfigChanged();
+}
+
+/**
+ * @brief Load settings from binary files (one read per file)
+ * @return true             Settings loaded
+ * @return false            Files missing, damaged or from an other firmware version
+ */
+bool GlobalDataController::readBinarySettings() {
+    uint16_t recordCount = 0;
+    ConfigBasicDataStruct *basic = (ConfigBasicDataStruct *)BinaryConfigFile::read(CONFIG_BINARY, sizeof(ConfigBasicDataStruct), 1, &recordCount);
+    if ((basic == NULL) || (recordCount != 1)) {
+        free(basic);
+        return false;
+    }
+    ConfigPrinterDataStruct *printerRecords = (ConfigPrinterDataStruct *)BinaryConfigFile::read(PRINTERCONFIG_BINARY, sizeof(ConfigPrinterDataStruct), MAX_PRINTERS, &recordCount);
+    if (printerRecords == NULL) {
+        free(basic);
+        return false;
+    }
+
+    this->systemData.useLedFlash = basic->useLedFlash;
+    this->systemData.webserverPort = basic->webserverPort;
+    this->systemData.webserverUsername = basic->webserverUsername;
+    this->systemData.webserverPassword = basic->webserverPassword;
+    this->systemData.hasBasicAuth = basic->hasBasicAuth;
+    this->systemData.clockWeatherResyncMinutes = basic->clockWeatherResyncMinutes;
+    this->clockData.utcOffset = basic->clockUtcOffset;
+    this->clockData.timezoneHash = basic->clockTimezoneHash;
+    this->clockData.show = basic->clockShow;
+    this->clockData.is24h = basic->clockIs24h;
+    this->weatherData.show = basic->weatherShow;
+    this->weatherData.apiKey = basic->weatherApiKey;
+    this->weatherData.cityId = basic->weatherCityId;
+    this->weatherData.isMetric = basic->weatherIsMetric;
+    this->weatherData.lang = basic->weatherLang;
+    this->sensorData.activated = basic->sensorActivated;
+    this->sensorData.showOnDisplay = basic->sensorShowOnDisplay;
+    this->sensorData.sensType = basic->sensorType;
+    this->displayData.displayType = basic->displayType;
+    this->displayData.invertDisplay = basic->displayInvert;
+    this->displayData.showWeatherSensorSplited = basic->displayWeatherSensorSplited;
+    this->displayData.automaticSwitchDelay = basic->displayAutomaticSwitchDelay;
+    this->displayData.automaticSwitchEnabled = basic->displayAutomaticSwitchEnabled;
+    this->displayData.automaticSwitchActiveOnlyEnabled = basic->displayAutomaticSwitchActiveOnlyEnabled;
+    this->displayData.automaticInactiveOff = basic->displayAutomaticInactiveOff;
+    free(basic);
+
+    free(this->printers);
+    this->printersCnt = recordCount;
+    this->printers = (PrinterDataStruct *)malloc((recordCount > 0 ? recordCount : 1) * sizeof(PrinterDataStruct));
+    memset(this->printers, 0, (recordCount > 0 ? recordCount : 1) * sizeof(PrinterDataStruct));
+    for (int i = 0; i < recordCount; i++) {
+        PrinterDataStruct *printer = &this->printers[i];
+        memcpy(printer->customName, printerRecords[i].customName, sizeof(printer->customName));
+        printer->apiType = printerRecords[i].apiType;
+        memcpy(printer->apiKey, printerRecords[i].apiKey, sizeof(printer->apiKey));
+        memcpy(printer->remoteAddress, printerRecords[i].remoteAddress, sizeof(printer->remoteAddress));
+        printer->remotePort = printerRecords[i].remotePort;
+        printer->basicAuthNeeded = printerRecords[i].basicAuthNeeded;
+        memcpy(printer->basicAuthUsername, printerRecords[i].basicAuthUsername, sizeof(printer->basicAuthUsername));
+        memcpy(printer->basicAuthPassword, printerRecords[i].basicAuthPassword, sizeof(printer->basicAuthPassword));
+        printer->hasPsuControl = printerRecords[i].hasPsuControl;
+    }
+    free(printerRecords);
+    this->debugController->printLn("Settings loaded: " + String(this->printersCnt) + " printers");
+    return true;
+}
+
+/**
+ * @brief Import settings from the text files (used when there are no valid binary settings)
+ */
+void GlobalDataController::importTextSettings() {
     // Read basic settings
     File fr = LittleFS.open(CONFIG, "r");
     String line;
@@ -103,6 +214,13 @@ void GlobalDataController::readSettings() {
     String searchName = "";
     while(fr.available()) {
         line = fr.readStringUntil('\n');
+        // Newer exports store the printer count in front of the printer settings
+        if (this->readSettingsForInt(line, "printerCnt", &this->printersCnt)) {
+            free(this->printers);
+            this->printers = (PrinterDataStruct *)malloc((this->printersCnt > 0 ? this->printersCnt : 1) * sizeof(PrinterDataStruct));
+            memset(this->printers, 0, (this->printersCnt > 0 ? this->printersCnt : 1) * sizeof(PrinterDataStruct));
+            continue;
+        }
         for(int i=0; i<this->printersCnt; i++) {
             searchName = "printer" + String(i) + "_";
             this->readSettingsForChar(line, searchName + "Name", this->printers[i].customName, 20);
@@ -117,11 +235,6 @@ void GlobalDataController::readSettings() {
         }
     }
     fr.close();
-
-    // Reset printer data
-    for(int i=0; i<this->printersCnt; i++) {
-        BasePrinterClient::resetPrinterData(&this->printers[i]);
-    }
 }
 
 /**
@@ -200,16 +313,191 @@ bool GlobalDataController::readSettingsForBool(String line, String expSearch, bo
 }
 
 /**
- * @brief Write all setting to eeprom
+ * @brief Write settings to eeprom and apply them to the running system.
+ * Only the given sections are written, live printer and sensor data is kept.
+ * @param sections          SETTINGS_SECTION_* flags of the changed sections
+ */
+void GlobalDataController::writeSettings(uint8_t sections) {
+    if (sections & SETTINGS_SECTION_BASIC) {
+        if (!this->writeBinaryBasicSettings()) {
+            this->debugController->printLn("File open failed!");
+        }
+        this->exportTextBasicSettings();
+        if (this->viewModel.updateSensor(&this->sensorData, this->getSensorClient(&this->sensorData))) {
+            this->sensorStateVersion = this->nextStateVersion();
+        }
+    }
+    if (sections & SETTINGS_SECTION_PRINTERS) {
+        if (!this->writeBinaryPrinterSettings()) {
+            this->debugController->printLn("File open failed!");
+        }
+        this->exportTextPrinterSettings();
+        for(int i=0; i<this->printersCnt; i++) {
+            this->updatePrinterView(&this->printers[i]);
+        }
+    }
+    this->markConfigChanged();
+}
+
+/**
+ * @brief Send the text settings of all sections as one backup file
+ * The backup is kept outside of the device, e.g. to restore the settings after a filesystem image upload
+ * @param target            Output
+ */
+void GlobalDataController::sendSettingsBackup(Print *target) {
+    target->print(SETTINGS_BACKUP_HEADER "\n");
+    this->sendSettingsFile(CONFIG, target);
+    target->print(SETTINGS_BACKUP_PRINTERS "\n");
+    this->sendSettingsFile(PRINTERCONFIG, target);
+}
+
+/**
+ * @brief Restore all settings from an uploaded backup file (see sendSettingsBackup)
+ * The sections are written as text settings and imported like on the first boot after an update.
+ * @param backupFileName    Uploaded backup, removed afterwards
+ * @return true             Settings restored, reboot to apply them to all clients
+ * @return false            File is no valid backup, settings are unchanged
+ */
+bool GlobalDataController::restoreSettings(const char *backupFileName) {
+    File backup = LittleFS.open(backupFileName, "r");
+    if (!backup) {
+        return false;
+    }
+    String line = backup.readStringUntil('\n');
+    line.trim();
+    if (line != SETTINGS_BACKUP_HEADER) {
+        backup.close();
+        LittleFS.remove(backupFileName);
+        return false;
+    }
+
+    File basic = LittleFS.open(BinaryConfigFile::tempFileName(CONFIG), "w");
+    File printers = LittleFS.open(BinaryConfigFile::tempFileName(PRINTERCONFIG), "w");
+    bool inPrinters = false;
+    while (basic && printers && backup.available()) {
+        line = backup.readStringUntil('\n');
+        line.trim();
+        if (line == SETTINGS_BACKUP_PRINTERS) {
+            inPrinters = true;
+        } else if (line.length() > 0 && inPrinters) {
+            printers.println(line);
+        } else if (line.length() > 0) {
+            basic.println(line);
+        }
+    }
+    bool isValid = basic && printers && inPrinters;
+    basic.close();
+    printers.close();
+    backup.close();
+    LittleFS.remove(backupFileName);
+    if (!isValid) {
+        LittleFS.remove(BinaryConfigFile::tempFileName(CONFIG));
+        LittleFS.remove(BinaryConfigFile::tempFileName(PRINTERCONFIG));
+        return false;
+    }
+
+    // Binary settings would be loaded first, so they are dropped and built again from the text settings
+    BinaryConfigFile::commit(CONFIG);
+    BinaryConfigFile::commit(PRINTERCONFIG);
+    LittleFS.remove(CONFIG_BINARY);
+    LittleFS.remove(PRINTERCONFIG_BINARY);
+    this->debugController->printLn("Settings restored from backup");
+    this->readSettings();
+    return true;
+}
+
+/**
+ * @brief Send the content of a settings file
+ * @param fileName          File to send
+ * @param target            Output
+ */
+void GlobalDataController::sendSettingsFile(const char *fileName, Print *target) {
+    File f = LittleFS.open(fileName, "r");
+    if (!f) {
+        return;
+    }
+    uint8_t buffer[128];
+    size_t len;
+    while ((len = f.read(buffer, sizeof(buffer))) > 0) {
+        target->write(buffer, len);
+    }
+    f.close();
+}
+
+/**
+ * @brief Store basic settings as binary file
+ * @return true             File written
+ * @return false 
+ */
+bool GlobalDataController::writeBinaryBasicSettings() {
+    ConfigBasicDataStruct basic;
+    memset(&basic, 0, sizeof(basic));
+    basic.useLedFlash = this->systemData.useLedFlash;
+    basic.webserverPort = this->systemData.webserverPort;
+    MemoryHelper::stringToChar(this->systemData.webserverUsername, basic.webserverUsername, sizeof(basic.webserverUsername) - 1);
+    MemoryHelper::stringToChar(this->systemData.webserverPassword, basic.webserverPassword, sizeof(basic.webserverPassword) - 1);
+    basic.hasBasicAuth = this->systemData.hasBasicAuth;
+    basic.clockWeatherResyncMinutes = this->systemData.clockWeatherResyncMinutes;
+    basic.clockUtcOffset = this->clockData.utcOffset;
+    MemoryHelper::stringToChar(this->clockData.timezoneHash, basic.clockTimezoneHash, sizeof(basic.clockTimezoneHash) - 1);
+    basic.clockShow = this->clockData.show;
+    basic.clockIs24h = this->clockData.is24h;
+    basic.weatherShow = this->weatherData.show;
+    MemoryHelper::stringToChar(this->weatherData.apiKey, basic.weatherApiKey, sizeof(basic.weatherApiKey) - 1);
+    basic.weatherCityId = this->weatherData.cityId;
+    basic.weatherIsMetric = this->weatherData.isMetric;
+    MemoryHelper::stringToChar(this->weatherData.lang, basic.weatherLang, sizeof(basic.weatherLang) - 1);
+    basic.sensorActivated = this->sensorData.activated;
+    basic.sensorShowOnDisplay = this->sensorData.showOnDisplay;
+    basic.sensorType = this->sensorData.sensType;
+    basic.displayType = this->displayData.displayType;
+    basic.displayInvert = this->displayData.invertDisplay;
+    basic.displayWeatherSensorSplited = this->displayData.showWeatherSensorSplited;
+    basic.displayAutomaticSwitchDelay = this->displayData.automaticSwitchDelay;
+    basic.displayAutomaticSwitchEnabled = this->displayData.automaticSwitchEnabled;
+    basic.displayAutomaticSwitchActiveOnlyEnabled = this->displayData.automaticSwitchActiveOnlyEnabled;
+    basic.displayAutomaticInactiveOff = this->displayData.automaticInactiveOff;
+    return BinaryConfigFile::write(CONFIG_BINARY, &basic, sizeof(basic), 1);
+}
+
+/**
+ * @brief Store printer settings as binary file
+ * @return true             File written
+ * @return false 
+ */
+bool GlobalDataController::writeBinaryPrinterSettings() {
+    int printerCount = _min(this->printersCnt, MAX_PRINTERS);
+    ConfigPrinterDataStruct *printerRecords = (ConfigPrinterDataStruct *)malloc((printerCount > 0 ? printerCount : 1) * sizeof(ConfigPrinterDataStruct));
+    if (printerRecords == NULL) {
+        return false;
+    }
+    memset(printerRecords, 0, (printerCount > 0 ? printerCount : 1) * sizeof(ConfigPrinterDataStruct));
+    for (int i = 0; i < printerCount; i++) {
+        PrinterDataStruct *printer = &this->printers[i];
+        memcpy(printerRecords[i].customName, printer->customName, sizeof(printerRecords[i].customName));
+        printerRecords[i].apiType = printer->apiType;
+        memcpy(printerRecords[i].apiKey, printer->apiKey, sizeof(printerRecords[i].apiKey));
+        memcpy(printerRecords[i].remoteAddress, printer->remoteAddress, sizeof(printerRecords[i].remoteAddress));
+        printerRecords[i].remotePort = printer->remotePort;
+        printerRecords[i].basicAuthNeeded = printer->basicAuthNeeded;
+        memcpy(printerRecords[i].basicAuthUsername, printer->basicAuthUsername, sizeof(printerRecords[i].basicAuthUsername));
+        memcpy(printerRecords[i].basicAuthPassword, printer->basicAuthPassword, sizeof(printerRecords[i].basicAuthPassword));
+        printerRecords[i].hasPsuControl = printer->hasPsuControl;
+    }
+    bool success = BinaryConfigFile::write(PRINTERCONFIG_BINARY, printerRecords, sizeof(ConfigPrinterDataStruct), printerCount);
+    free(printerRecords);
+    return success;
+}
+
+/**
+ * @brief Export basic settings as text file (readable backup, imported if the binary settings are not valid)
  */
-void GlobalDataController::writeSettings() {
-    // Store basic settings
-    File f = LittleFS.open(CONFIG, "w");
+void GlobalDataController::exportTextBasicSettings() {
+    File f = LittleFS.open(BinaryConfigFile::tempFileName(CONFIG), "w");
     if (!f) {
         this->debugController->printLn("File open failed!");
     } else {
         this->debugController->printLn("Saving default settings now...");
-        f.println("printerCnt=" + String(this->printersCnt));
         f.println("systemInvertDisplay=" + String(this->displayData.invertDisplay));
         f.println("displayType=" + String(this->displayData.displayType));
         f.println("displayWeatherSplit=" + String(this->displayData.showWeatherSensorSplited));
@@ -235,15 +523,21 @@ void GlobalDataController::writeSettings() {
         f.println("sensorIsActive=" + String(this->sensorData.activated));
         f.println("sensorShow=" + String(this->sensorData.showOnDisplay));
         f.println("sensorType=" + String(this->sensorData.sensType));
+        f.close();
+        BinaryConfigFile::commit(CONFIG);
     }
-    f.close();
+}
 
-    // Store printer settings
-    f = LittleFS.open(PRINTERCONFIG, "w");
+/**
+ * @brief Export printer settings as text file (readable backup, imported if the binary settings are not valid)
+ */
+void GlobalDataController::exportTextPrinterSettings() {
+    File f = LittleFS.open(BinaryConfigFile::tempFileName(PRINTERCONFIG), "w");
     if (!f) {
         this->debugController->printLn("File open failed!");
     } else {
         this->debugController->printLn("Saving printer settings now...");
+        f.println("printerCnt=" + String(this->printersCnt));
         for(int i=0; i<this->printersCnt; i++) {
             f.println("printer" + String(i) + "_Name=" + String(this->printers[i].customName));
             f.println("printer" + String(i) + "_ApiType=" + String(this->printers[i].apiType));
@@ -255,11 +549,9 @@ void GlobalDataController::writeSettings() {
             f.println("printer" + String(i) + "_baPass=" + String(this->printers[i].basicAuthPassword));
             f.println("printer" + String(i) + "_hasPsu=" + String(this->printers[i].hasPsuControl));
         }
+        f.close();
+        BinaryConfigFile::commit(PRINTERCONFIG);
     }
-    f.close();
-
-    // Success, let us read all again to match
-    readSettings();
 }
 
 /**
@@ -302,6 +594,7 @@ void GlobalDataController::initDefaultConfig() {
     this->sensorData.showOnDisplay = false;
     this->sensorData.sensType = 0;
     MemoryHelper::stringToChar("", this->sensorData.error, 120);
+    this->sensorData.cachedEpoch = 0;
 }
 
 /**
@@ -309,6 +602,8 @@ void GlobalDataController::initDefaultConfig() {
  * @return bool     true = success | false = error
  */
 bool GlobalDataController::resetConfig() {
+    LittleFS.remove(CONFIG_BINARY);
+    LittleFS.remove(PRINTERCONFIG_BINARY);
     return LittleFS.remove(CONFIG) && LittleFS.remove(PRINTERCONFIG);
 }
 
@@ -320,6 +615,14 @@ TimeClient *GlobalDataController::getTimeClient() {
     return this->timeClient;
 }
 
+/**
+ * @brief Return internal reference to timer controller
+ * @return TimerController* 
+ */
+TimerController *GlobalDataController::getTimerController() {
+    return this->timerController;
+}
+
 /**
  * @brief Return internal reference to weather client
  * @return OpenWeatherMapClient* 
@@ -328,6 +631,85 @@ OpenWeatherMapClient *GlobalDataController::getWeatherClient() {
     return this->weatherClient;
 }
 
+/**
+ * @brief Sync weather data and update the view
+ */
+void GlobalDataController::syncWeather() {
+    this->weatherClient->updateWeather();
+    this->weatherSyncEpoch = this->timeClient->getCurrentEpoch();
+    this->cachedWeather.syncEpoch = 0;
+    if (this->viewModel.updateWeather(this->weatherClient)) {
+        this->weatherStateVersion = this->nextStateVersion();
+    }
+}
+
+/**
+ * @brief Sync weather if its refresh delay is over
+ * @return true         Weather was requested
+ * @return false 
+ */
+bool GlobalDataController::handleWeatherSync() {
+    if (!this->weatherData.show || ((millis() - this->weatherAttemptMillis) < this->weatherNextDelayMs)) {
+        return false;
+    }
+    this->debugController->printLn("Updating weather...");
+    this->syncWeather();
+    this->weatherAttemptMillis = millis();
+    this->weatherNextDelayMs = this->getNextWeatherDelaySec() * 1000UL;
+    this->debugController->printLn("Next weather update in " + String(this->weatherNextDelayMs / 1000) + " s");
+    return true;
+}
+
+/**
+ * @brief Request weather with the next handleWeatherSync (e.g. after configuration change)
+ */
+void GlobalDataController::resetWeatherSync() {
+    this->weatherNextDelayMs = 0;
+    this->weatherFailCount = 0;
+    this->weatherClient->resetResponseCache();
+}
+
+/**
+ * @brief Calculate delay until next weather request. Failed requests are retried with
+ * increasing delay, otherwise no request is sent before the server can have new data.
+ * @return unsigned long    Delay in seconds
+ */
+unsigned long GlobalDataController::getNextWeatherDelaySec() {
+    unsigned long intervalSec = _max(1, this->systemData.clockWeatherResyncMinutes) * 60UL;
+    if (this->weatherClient->getError() != "") {
+        unsigned long retrySec = (unsigned long)WEATHER_RETRY_MIN_SEC << _min(this->weatherFailCount, 8);
+        if (this->weatherFailCount < 255) {
+            this->weatherFailCount++;
+        }
+        return _min(retrySec, intervalSec);
+    }
+    this->weatherFailCount = 0;
+
+    unsigned long delaySec = _max(intervalSec, this->weatherClient->getMaxAgeSec());
+    long observationEpoch = this->weatherClient->getDt(0);
+    if (this->timeClient->isTimeValid() && (observationEpoch > 0)) {
+        long nextObservationSec = observationEpoch + WEATHER_OBSERVATION_SEC - this->timeClient->getCurrentEpoch();
+        delaySec = _max(delaySec, (unsigned long)_max(nextObservationSec, (long)WEATHER_RETRY_MIN_SEC));
+    }
+    return delaySec;
+}
+
+/**
+ * @brief Return preformatted values for all renderers
+ * @return DisplayViewModel* 
+ */
+DisplayViewModel *GlobalDataController::getViewModel() {
+    return &this->viewModel;
+}
+
+/**
+ * @brief Return preformatted time for the current second
+ * @return TimeViewDataStruct* 
+ */
+TimeViewDataStruct *GlobalDataController::getTimeView() {
+    return this->viewModel.getTime(this->timeClient, this->clockData.is24h);
+}
+
 /**
  * @brief Set LED state
  * @param value     true = enable LED | false = disable LED
@@ -343,18 +725,26 @@ void GlobalDataController::ledOnOff(boolean value) {
 }
 
 /**
- * @brief Cyclic LED flash
+ * @brief Cyclic LED flash, executed by timer in background
  * @param number        Number of cycles
  * @param delayTime     Delay between states
  */
 void GlobalDataController::flashLED(int number, int delayTime) {
-    for (int inx = 0; inx <= number; inx++) {
-        delay(delayTime);
-        digitalWrite(EXTERNAL_LED, LOW); // ON
-        delay(delayTime);
-        digitalWrite(EXTERNAL_LED, HIGH); // OFF
-        delay(delayTime);
-    }
+    this->stopFlashLED();
+    this->flashState = false;
+    this->flashTimer = this->timerController->repeat(delayTime, (number + 1) * 2, [this]() {
+        this->flashState = !this->flashState;
+        digitalWrite(EXTERNAL_LED, this->flashState ? LOW : HIGH);
+    });
+}
+
+/**
+ * @brief Stop running LED flash and switch LED off
+ */
+void GlobalDataController::stopFlashLED() {
+    this->timerController->cancel(this->flashTimer);
+    this->flashTimer = TIMER_INVALID;
+    digitalWrite(EXTERNAL_LED, HIGH); // OFF
 }
 
 /**
@@ -419,6 +809,7 @@ PrinterDataStruct *GlobalDataController::addPrinterSetting() {
     this->printers = newStruct;
     PrinterDataStruct *retStruct = &(this->printers[this->printersCnt]);
     memset(retStruct, 0, sizeof(PrinterDataStruct));
+    retStruct->id = ++this->lastPrinterId;
     this->printersCnt++;
     return retStruct;
 }
@@ -428,7 +819,7 @@ PrinterDataStruct *GlobalDataController::addPrinterSetting() {
  * @return PrinterDataStruct*   The new struct for the entry
  */
 bool GlobalDataController::removePrinterSettingByIdx(int idx) {
-    if (this->printersCnt <= idx) {
+    if ((idx < 0) || (this->printersCnt <= idx)) {
         return false;
     }
     int tSize = this->printersCnt - 1;
@@ -438,8 +829,8 @@ bool GlobalDataController::removePrinterSettingByIdx(int idx) {
     }
     PrinterDataStruct *newStruct = (PrinterDataStruct *)malloc(mallocSize * sizeof(PrinterDataStruct));
     memset(newStruct, 0, mallocSize * sizeof(PrinterDataStruct));
+    int eCnt = 0;
     if (tSize > 0) {
-        int eCnt = 0;
         for(int i=0; i<this->printersCnt; i++) {
             if (i == idx) {
                 continue;
@@ -447,34 +838,34 @@ bool GlobalDataController::removePrinterSettingByIdx(int idx) {
             memcpy(&newStruct[eCnt], &this->printers[i], sizeof(PrinterDataStruct));
             eCnt++;
         }
-        this->printersCnt = eCnt;
-        free(this->printers);
-        this->printers = newStruct;
     }
+    this->printersCnt = eCnt;
+    free(this->printers);
+    this->printers = newStruct;
     return true;
 }
 
+/**
+ * @brief Find printer by its runtime id
+ * @param id                    PrinterDataStruct::id
+ * @return int                  Index in the printer settings or -1
+ */
+int GlobalDataController::getPrinterIdxById(uint32_t id) {
+    for(int i=0; i<this->printersCnt; i++) {
+        if (this->printers[i].id == id) {
+            return i;
+        }
+    }
+    return -1;
+}
+
 /**
  * @brief Return a printer state as readable text
  * @param printerHandle     Handle to printer data
  * @return String 
  */
 String GlobalDataController::getPrinterStateAsText(PrinterDataStruct *printerHandle) {
-    switch (printerHandle->state)
-    {
-    case PRINTER_STATE_ERROR:
-        return "Error";
-    case PRINTER_STATE_STANDBY:
-        return "Standby";
-    case PRINTER_STATE_PRINTING:
-        return "Printing";
-    case PRINTER_STATE_PAUSED:
-        return "Paused";
-    case PRINTER_STATE_COMPLETED:
-        return "Completed";
-    default:
-        return "Offline";
-    }
+    return ViewFormatter::getPrinterStateAsText(printerHandle->state);
 }
 
 /**
@@ -638,6 +1029,7 @@ void GlobalDataController::syncSensor() {
         if (this->sensorData.sensType >= 0) {
             for (int i=0; i<this->baseSensorCount; i++) {
                 if((i == this->sensorData.sensType) && (this->baseSensorClients[i] != NULL)) {
+                    this->baseSensorClients[i]->resetSamples(&this->sensorData);
                     this->baseSensorClients[i]->startSensor(&this->sensorData);
                     this->sensorApiStarted = i;
                     break;
@@ -649,9 +1041,10 @@ void GlobalDataController::syncSensor() {
     if (this->sensorData.sensType >= 0) {
         for (int i=0; i<this->baseSensorCount; i++) {
             if((i == this->sensorData.sensType) && (this->baseSensorClients[i] != NULL)) {
-                this->baseSensorClients[i]->updateSensor(&this->sensorData);
-                if (String(sensorData.error) != "") {
-                    this->debugController->printLn("Error: " + String(sensorData.error));
+                bool newReading = this->baseSensorClients[i]->updateSensor(&this->sensorData);
+                // Asynchronous sensors deliver their values later in handleSensor()
+                if (newReading || !this->baseSensorClients[i]->isMeasuring()) {
+                    this->applySensorData(this->baseSensorClients[i], newReading);
                 }
                 break;
             }
@@ -659,6 +1052,41 @@ void GlobalDataController::syncSensor() {
     }
 }
 
+/**
+ * @brief Poll a running sensor measurement, called from every loop run
+ */
+void GlobalDataController::handleSensor() {
+    if ((this->sensorApiStarted < 0) || (this->sensorApiStarted != this->sensorData.sensType)) {
+        return;
+    }
+    BaseSensorClient *sensorClient = this->baseSensorClients[this->sensorApiStarted];
+    if ((sensorClient == NULL) || !sensorClient->isMeasuring()) {
+        return;
+    }
+    bool newReading = sensorClient->handleSensor(&this->sensorData);
+    if (newReading || !sensorClient->isMeasuring()) {
+        this->applySensorData(sensorClient, newReading);
+    }
+}
+
+/**
+ * @brief Filter new sensor values, update view and state
+ * @param sensorClient      Sensor client that finished the reading
+ * @param newReading        false = reading failed, the values stay unchanged
+ */
+void GlobalDataController::applySensorData(BaseSensorClient *sensorClient, bool newReading) {
+    if (newReading) {
+        sensorClient->addSample(&this->sensorData);
+        this->sensorData.cachedEpoch = 0;
+    }
+    if (String(sensorData.error) != "") {
+        this->debugController->printLn("Error: " + String(sensorData.error));
+    }
+    if (this->viewModel.updateSensor(&this->sensorData, sensorClient)) {
+        this->sensorStateVersion = this->nextStateVersion();
+    }
+}
+
 /**
  * @brief Register an new printer client vor internal handling
  * 
@@ -724,6 +1152,8 @@ void GlobalDataController::syncPrinter(PrinterDataStruct *printerHandle) {
                 this->debugController->printLn("syncPrinter: " + String(printerHandle->lastSyncEpoch) + " | " + String(printerHandle->customName));
                 this->basePrinterClients[i]->getPrinterJobResults(printerHandle);
                 this->basePrinterClients[i]->getPrinterPsuState(printerHandle);
+                printerHandle->cachedEpoch = 0;
+                this->updatePrinterView(printerHandle);
                 return;
             }
         }
@@ -757,4 +1187,287 @@ int GlobalDataController::numPrintersPrinting() {
         }
     }
     return numPrintersPrinting;
-}
\ No newline at end of file
+}
+
+/**
+ * @brief Update preformatted values of a printer
+ * @param printerHandle     Handle to printer data
+ */
+void GlobalDataController::updatePrinterView(PrinterDataStruct *printerHandle) {
+    int idx = printerHandle - this->printers;
+    bool changed = this->viewModel.updatePrinter(idx, printerHandle, this->getPrinterClientType(printerHandle));
+    if ((idx < 0) || (idx >= MAX_PRINTERS)) {
+        return;
+    }
+
+    // Error and filename are used unformatted, so they are not part of the view model
+    uint32_t textHash = GlobalDataController::hashText(2166136261UL, printerHandle->error);
+    textHash = GlobalDataController::hashText(textHash, printerHandle->fileName);
+    if (changed || (textHash != this->printerTextHashes[idx])) {
+        this->printerTextHashes[idx] = textHash;
+        this->printerStateVersions[idx] = this->nextStateVersion();
+    }
+}
+
+/**
+ * @brief Current state version, increased with every change of printer, sensor, weather or configuration data
+ * @return uint32_t 
+ */
+uint32_t GlobalDataController::getStateVersion() {
+    return this->stateVersion;
+}
+
+/**
+ * @brief Random id of this boot, state versions are only comparable within the same boot
+ * @return uint32_t 
+ */
+uint32_t GlobalDataController::getStateBootId() {
+    return this->stateBootId;
+}
+
+/**
+ * @brief State version of last configuration change (printers added, removed or changed)
+ * @return uint32_t 
+ */
+uint32_t GlobalDataController::getConfigStateVersion() {
+    return this->configStateVersion;
+}
+
+/**
+ * @brief State version of last change of a printer
+ * @param idx               Index of printer
+ * @return uint32_t 
+ */
+uint32_t GlobalDataController::getPrinterStateVersion(int idx) {
+    if ((idx < 0) || (idx >= MAX_PRINTERS)) {
+        return 0;
+    }
+    return this->printerStateVersions[idx];
+}
+
+/**
+ * @brief State version of last change of sensor data
+ * @return uint32_t 
+ */
+uint32_t GlobalDataController::getSensorStateVersion() {
+    return this->sensorStateVersion;
+}
+
+/**
+ * @brief State version of last change of weather data
+ * @return uint32_t 
+ */
+uint32_t GlobalDataController::getWeatherStateVersion() {
+    return this->weatherStateVersion;
+}
+
+/**
+ * @brief Increase state version for a change
+ * @return uint32_t         New state version
+ */
+uint32_t GlobalDataController::nextStateVersion() {
+    return ++this->stateVersion;
+}
+
+/**
+ * @brief Continue FNV-1a hash with text
+ * @param hash              Current hash
+ * @param text              Text to add
+ * @return uint32_t         New hash
+ */
+uint32_t GlobalDataController::hashText(uint32_t hash, const char *text) {
+    while (*text != 0) {
+        hash ^= (uint8_t)*text++;
+        hash *= 16777619UL;
+    }
+    return hash;
+}
+
+/**
+ * @brief Mark configuration and all printers as changed (indexes can be shifted)
+ */
+void GlobalDataController::markConfigChanged() {
+    this->configStateVersion = this->nextStateVersion();
+    for (int i = 0; i < MAX_PRINTERS; i++) {
+        this->printerStateVersions[i] = this->configStateVersion;
+    }
+}
+
+/**
+ * @brief Identifies a printer by its connection, cached data is only restored for the same printer
+ * @param printerHandle     Handle to printer data
+ * @return uint32_t 
+ */
+uint32_t GlobalDataController::getPrinterConfigHash(PrinterDataStruct *printerHandle) {
+    char buffer[16];
+    snprintf(buffer, sizeof(buffer), ":%d:%d", printerHandle->remotePort, printerHandle->apiType);
+    uint32_t hash = GlobalDataController::hashText(2166136261UL, printerHandle->remoteAddress);
+    return GlobalDataController::hashText(hash, buffer);
+}
+
+/**
+ * @brief Store last known printer, weather and sensor data for the next boot.
+ * RTC memory is written on every call (if the snapshot fits), LittleFS at most every WARMSTART_FILE_SEC.
+ * @param allowFile         false = RTC memory only (e.g. OTA filesystem update running)
+ */
+void GlobalDataController::storeWarmStart(bool allowFile) {
+    if (!this->timeClient->isTimeValid()) {
+        // Age stamps need the real time
+        return;
+    }
+    int printerCount = _min(this->printersCnt, MAX_PRINTERS);
+    size_t size = sizeof(WarmStartHeaderDataStruct)
+        + sizeof(WarmStartSensorDataStruct)
+        + sizeof(WarmStartWeatherDataStruct)
+        + (printerCount * sizeof(WarmStartPrinterDataStruct));
+    uint32_t *snapshot = (uint32_t *)malloc((size + 3) & ~3);
+    if (snapshot == NULL) {
+        return;
+    }
+    memset(snapshot, 0, (size + 3) & ~3);
+    WarmStartHeaderDataStruct *header = (WarmStartHeaderDataStruct *)snapshot;
+    WarmStartSensorDataStruct *sensor = (WarmStartSensorDataStruct *)(header + 1);
+    WarmStartWeatherDataStruct *weather = (WarmStartWeatherDataStruct *)(sensor + 1);
+    WarmStartPrinterDataStruct *printerRecords = (WarmStartPrinterDataStruct *)(weather + 1);
+
+    // Sensor
+    long sensorEpoch = this->sensorData.cachedEpoch > 0 ? this->sensorData.cachedEpoch : this->sensorData.lastSyncEpoch;
+    if (this->sensorData.activated && (sensorEpoch > 0) && (strlen(this->sensorData.error) == 0)) {
+        sensor->syncEpoch = sensorEpoch;
+        sensor->sensType = this->sensorData.sensType;
+        sensor->temperature = this->sensorData.temperature;
+        sensor->humidity = this->sensorData.humidity;
+        sensor->pressure = this->sensorData.pressure;
+        sensor->airQuality = this->sensorData.airQuality;
+        sensor->gasResistance = this->sensorData.gasResistance;
+        sensor->altitude = this->sensorData.altitude;
+    }
+
+    // Weather
+    if (this->cachedWeather.syncEpoch > 0) {
+        memcpy(weather, &this->cachedWeather, sizeof(WarmStartWeatherDataStruct));
+    } else if ((this->weatherSyncEpoch > 0) && this->viewModel.getWeather()->isValid) {
+        weather->syncEpoch = this->weatherSyncEpoch;
+        weather->cityId = this->weatherData.cityId;
+        weather->temperature = this->weatherClient->getTemp(0);
+        weather->humidity = this->weatherClient->getHumidity(0);
+        weather->wind = this->weatherClient->getWind(0);
+        weather->weatherId = this->weatherClient->getWeatherId(0);
+        strncpy(weather->city, this->weatherClient->getCity(0), sizeof(weather->city) - 1);
+        strncpy(weather->country, this->weatherClient->getCountry(0), sizeof(weather->country) - 1);
+        strncpy(weather->condition, this->weatherClient->getCondition(0), sizeof(weather->condition) - 1);
+        strncpy(weather->description, this->weatherClient->getDescription(0), sizeof(weather->description) - 1);
+        strncpy(weather->icon, this->weatherClient->getIcon(0), sizeof(weather->icon) - 1);
+        strncpy(weather->iconGlyph, this->weatherClient->getWeatherIcon(0), sizeof(weather->iconGlyph) - 1);
+    }
+
+    // Printers
+    for (int i = 0; i < printerCount; i++) {
+        PrinterDataStruct *printer = &this->printers[i];
+        WarmStartPrinterDataStruct *record = &printerRecords[i];
+        record->configHash = GlobalDataController::getPrinterConfigHash(printer);
+        record->syncEpoch = printer->cachedEpoch > 0 ? printer->cachedEpoch : printer->lastSyncEpoch;
+        record->state = printer->state;
+        record->isPrinting = printer->isPrinting;
+        record->isPSUoff = printer->isPSUoff;
+        record->progressCompletion = printer->progressCompletion;
+        record->progressPrintTime = printer->progressPrintTime;
+        record->progressPrintTimeLeft = printer->progressPrintTimeLeft;
+        record->toolTemp = printer->toolTemp;
+        record->toolTargetTemp = printer->toolTargetTemp;
+        record->bedTemp = printer->bedTemp;
+        record->bedTargetTemp = printer->bedTargetTemp;
+        strncpy(record->fileName, printer->fileName, sizeof(record->fileName) - 1);
+    }
+
+    header->magic = WARMSTART_MAGIC;
+    header->version = WARMSTART_VERSION;
+    header->size = size;
+    header->printerCount = printerCount;
+    header->epoch = this->timeClient->getCurrentEpoch();
+    header->crc = BinaryConfigFile::crc32(sensor, size - sizeof(WarmStartHeaderDataStruct));
+
+    WarmStartStorage::writeRtc(snapshot, size);
+    if (allowFile
+        && (header->crc != this->warmStartFileCrc)
+        && ((this->warmStartFileMillis == 0) || ((millis() - this->warmStartFileMillis) >= (WARMSTART_FILE_SEC * 1000UL)))
+    ) {
+        if (WarmStartStorage::writeFile(snapshot, size)) {
+            this->warmStartFileCrc = header->crc;
+            this->warmStartFileMillis = millis();
+        }
+    }
+    free(snapshot);
+}
+
+/**
+ * @brief Restore last known data from the warm start snapshot, marked as cached until the first sync
+ */
+void GlobalDataController::restoreWarmStart() {
+    size_t size = 0;
+    uint32_t *snapshot = WarmStartStorage::read(&size);
+    if (snapshot == NULL) {
+        return;
+    }
+    WarmStartHeaderDataStruct *header = (WarmStartHeaderDataStruct *)snapshot;
+    WarmStartSensorDataStruct *sensor = (WarmStartSensorDataStruct *)(header + 1);
+    WarmStartWeatherDataStruct *weather = (WarmStartWeatherDataStruct *)(sensor + 1);
+    WarmStartPrinterDataStruct *printerRecords = (WarmStartPrinterDataStruct *)(weather + 1);
+    int restoredPrinters = 0;
+
+    if ((sensor->syncEpoch > 0) && this->sensorData.activated && (sensor->sensType == this->sensorData.sensType)) {
+        this->sensorData.temperature = sensor->temperature;
+        this->sensorData.humidity = sensor->humidity;
+        this->sensorData.pressure = sensor->pressure;
+        this->sensorData.airQuality = sensor->airQuality;
+        this->sensorData.gasResistance = sensor->gasResistance;
+        this->sensorData.altitude = sensor->altitude;
+        this->sensorData.cachedEpoch = sensor->syncEpoch;
+        if (this->viewModel.updateSensor(&this->sensorData, this->getSensorClient(&this->sensorData))) {
+            this->sensorStateVersion = this->nextStateVersion();
+        }
+    }
+
+    if ((weather->syncEpoch > 0) && this->weatherData.show && (weather->cityId == this->weatherData.cityId)) {
+        memcpy(&this->cachedWeather, weather, sizeof(WarmStartWeatherDataStruct));
+        if (this->viewModel.restoreWeather(&this->cachedWeather, this->weatherClient)) {
+            this->weatherStateVersion = this->nextStateVersion();
+        }
+    }
+
+    for (int i = 0; i < _min((int)header->printerCount, this->printersCnt); i++) {
+        PrinterDataStruct *printer = &this->printers[i];
+        WarmStartPrinterDataStruct *record = &printerRecords[i];
+        if ((record->syncEpoch == 0) || (record->configHash != GlobalDataController::getPrinterConfigHash(printer))) {
+            continue;
+        }
+        printer->state = record->state;
+        printer->isPrinting = record->isPrinting;
+        printer->isPSUoff = record->isPSUoff;
+        printer->progressCompletion = record->progressCompletion;
+        printer->progressPrintTime = record->progressPrintTime;
+        printer->progressPrintTimeLeft = record->progressPrintTimeLeft;
+        printer->toolTemp = record->toolTemp;
+        printer->toolTargetTemp = record->toolTargetTemp;
+        printer->bedTemp = record->bedTemp;
+        printer->bedTargetTemp = record->bedTargetTemp;
+        strncpy(printer->fileName, record->fileName, sizeof(record->fileName) - 1);
+        // lastSyncEpoch stays 0, so the printer is synced right away
+        printer->cachedEpoch = record->syncEpoch;
+        this->updatePrinterView(printer);
+        restoredPrinters++;
+    }
+    free(snapshot);
+    this->debugController->printLn("Warm start: restored " + String(restoredPrinters) + " printers from " + String(header->epoch));
+}
+
+/**
+ * @brief Last known weather restored on boot
+ * @return WarmStartWeatherDataStruct*  NULL if weather is live (or unknown)
+ */
+WarmStartWeatherDataStruct *GlobalDataController::getCachedWeather() {
+    if (this->cachedWeather.syncEpoch == 0) {
+        return NULL;
+    }
+    return &this->cachedWeather;
+}
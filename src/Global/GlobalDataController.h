@@ -6,6 +6,7 @@
 #include "../DataStructs/ClockDataStruct.h"
 #include "../DataStructs/SystemDataStruct.h"
 #include "../DataStructs/WeatherDataStruct.h"
+#include "../DataStructs/ConfigDataStruct.h"
 #include "../Network/TimeClient.h"
 #include "../Network/OpenWeatherMapClient.h"
 #include "../Display/BaseDisplayClient.h"
@@ -14,9 +15,24 @@
 #include "DebugController.h"
 #include "../../include/MemoryHelper.h"
 #include "EspController.h"
+#include "DisplayViewModel.h"
+#include "TimerController.h"
+#include "BinaryConfigFile.h"
+#include "WarmStartStorage.h"
+
+// Settings sections, each section is stored in its own files
+#define SETTINGS_SECTION_BASIC      1
+#define SETTINGS_SECTION_PRINTERS   2
+#define SETTINGS_SECTION_ALL        (SETTINGS_SECTION_BASIC | SETTINGS_SECTION_PRINTERS)
+
+// Settings backup: text settings of both sections in one file, the marker starts the printer section
+#define SETTINGS_BACKUP_HEADER      "# PrintBuddy settings backup"
+#define SETTINGS_BACKUP_PRINTERS    "# Printers"
 
 static const char ERROR_MESSAGES_ERR1[] PROGMEM = "[ERR1] Printer for update not found!";
 static const char ERROR_MESSAGES_ERR2[] PROGMEM = "[ERR1] Printer for deletion not found!";
+static const char ERROR_MESSAGES_ERR3[] PROGMEM = "[ERR3] File is no valid settings backup!";
+static const char ERROR_MESSAGES_ERR4[] PROGMEM = "[ERR4] Too many changes during printer update, please save again!";
 
 static const char OK_MESSAGES_SAVE1[] PROGMEM = "[OK] Printer successfully saved";
 static const char OK_MESSAGES_SAVE2[] PROGMEM = "[OK] Weather api data successfully saved";
@@ -25,6 +41,7 @@ static const char OK_MESSAGES_SAVE4[] PROGMEM = "[OK] Sensor data successfully s
 static const char OK_MESSAGES_SAVE5[] PROGMEM = "[OK] Display data successfully saved";
 static const char OK_MESSAGES_SAVE6[] PROGMEM = "[OK] Display data successfully saved! Please reboot device!";
 static const char OK_MESSAGES_DELETEPRINTER[] PROGMEM = "[OK] Printer successfully removed";
+static const char OK_MESSAGES_DEFERRED[] PROGMEM = "[OK] Saved, changes are applied after the running printer update";
 
 /**
  * @brief Handles all needed data for all instances
@@ -36,6 +53,7 @@ private:
      */
     String lastReportStatus = "";
     TimeClient *timeClient;
+    TimerController *timerController;
     OpenWeatherMapClient *weatherClient; 
     DebugController *debugController;
     BaseDisplayClient **baseDisplayClient;
@@ -45,33 +63,84 @@ private:
     int baseSensorCount = 0;
     int baseDisplayCount = 0;
     int sensorApiStarted = -1;
+    int flashTimer = TIMER_INVALID;
+    bool flashState = false;
 
     /**
      * Configuration variables
      */
     PrinterDataStruct *printers;
     int printersCnt = 0;
+    uint32_t lastPrinterId = 0;
     SystemDataStruct systemData;
     ClockDataStruct clockData;
     WeatherDataStruct weatherData;
     SensorDataStruct sensorData;
     DisplayDataStruct displayData;
+    DisplayViewModel viewModel;
+
+    /**
+     * State versions, increased with every change of data (for polling api consumers)
+     */
+    uint32_t stateVersion = 0;
+    uint32_t stateBootId = 0;
+    uint32_t configStateVersion = 0;
+    uint32_t printerStateVersions[MAX_PRINTERS];
+    uint32_t printerTextHashes[MAX_PRINTERS];
+    uint32_t sensorStateVersion = 0;
+    uint32_t weatherStateVersion = 0;
+
+    /**
+     * Warm start, last known data is restored on boot and shown as cached until the first sync
+     */
+    long weatherSyncEpoch = 0;
+    WarmStartWeatherDataStruct cachedWeather;
+    unsigned long warmStartFileMillis = 0;
+    uint32_t warmStartFileCrc = 0;
+
+    /**
+     * Weather refresh, independent from time sync
+     */
+    unsigned long weatherAttemptMillis = 0;
+    unsigned long weatherNextDelayMs = 0;
+    uint8_t weatherFailCount = 0;
+
+    unsigned long getNextWeatherDelaySec();
+    void applySensorData(BaseSensorClient *sensorClient, bool newReading);
 
 public:
-    GlobalDataController(TimeClient *timeClient, OpenWeatherMapClient *weatherClient, DebugController *debugController);
+    GlobalDataController(TimeClient *timeClient, TimerController *timerController, OpenWeatherMapClient *weatherClient, DebugController *debugController);
     void setup();
     void listSettingFiles();
     void readSettings();
-    void writeSettings();
+    void writeSettings(uint8_t sections = SETTINGS_SECTION_ALL);
+    void sendSettingsBackup(Print *target);
+    bool restoreSettings(const char *backupFileName);
     SystemDataStruct *getSystemSettings();
     ClockDataStruct *getClockSettings();
     WeatherDataStruct *getWeatherSettings();  
     SensorDataStruct *getSensorSettings();
     TimeClient *getTimeClient();
+    TimerController *getTimerController();
     OpenWeatherMapClient *getWeatherClient();
+    void syncWeather();
+    bool handleWeatherSync();
+    void resetWeatherSync();
+    DisplayViewModel *getViewModel();
+    TimeViewDataStruct *getTimeView();
     void ledOnOff(boolean value);
     void flashLED(int number, int delayTime);
+    void stopFlashLED();
     bool resetConfig();
+    uint32_t getStateVersion();
+    uint32_t getStateBootId();
+    uint32_t getConfigStateVersion();
+    uint32_t getPrinterStateVersion(int idx);
+    uint32_t getSensorStateVersion();
+    uint32_t getWeatherStateVersion();
+    void storeWarmStart(bool allowFile);
+    void restoreWarmStart();
+    WarmStartWeatherDataStruct *getCachedWeather();
 
     void registerDisplayClient(int id, BaseDisplayClient *baseDisplayClient);
     BaseDisplayClient** getRegisteredDisplayClients();
@@ -85,6 +154,7 @@ public:
     int getRegisteredSensorClientsNum();
     String getSensorClientType(SensorDataStruct *sensorHandle);
     void syncSensor();
+    void handleSensor();
     BaseSensorClient *getSensorClient(SensorDataStruct *sensorHandle);
     DisplayDataStruct *getDisplaySettings();
 
@@ -94,15 +164,28 @@ public:
     PrinterDataStruct *getPrinterSettings();
     PrinterDataStruct *addPrinterSetting();
     bool removePrinterSettingByIdx(int idx);
+    int getPrinterIdxById(uint32_t id);
     bool isAnyPrinterPrinting();
     int numPrintersPrinting();
     int getNumPrinters();
     String getPrinterStateAsText(PrinterDataStruct *printerHandle);
     String getPrinterClientType(PrinterDataStruct *printerHandle);
     void syncPrinter(PrinterDataStruct *printerHandle);
+    void updatePrinterView(PrinterDataStruct *printerHandle);
 
 private:
     void initDefaultConfig();
+    bool readBinarySettings();
+    bool writeBinaryBasicSettings();
+    bool writeBinaryPrinterSettings();
+    void importTextSettings();
+    void exportTextBasicSettings();
+    void exportTextPrinterSettings();
+    void sendSettingsFile(const char *fileName, Print *target);
+    uint32_t nextStateVersion();
+    void markConfigChanged();
+    static uint32_t hashText(uint32_t hash, const char *text);
+    static uint32_t getPrinterConfigHash(PrinterDataStruct *printerHandle);
     bool readSettingsForChar(String line, String expSearch, char *targetChar, size_t maxLen);
     bool readSettingsForBool(String line, String expSearch, bool *targetBool);
     bool readSettingsForInt(String line, String expSearch, int *targetInt);
@@ -0,0 +1,118 @@
+#include "TimerController.h"
+
+/**
+ * @brief Construct a new Timer Controller:: Timer Controller object
+ */
+TimerController::TimerController() {
+    for (int i = 0; i < TIMER_MAX_SLOTS; i++) {
+        this->timers[i].handle = TIMER_INVALID;
+        this->timers[i].active = false;
+    }
+}
+
+/**
+ * @brief Execute callback one time after the delay
+ * @param delayMillis       Delay in milliseconds
+ * @param callback          Callback (can start the next timer as continuation)
+ * @return int              Handle of timer or TIMER_INVALID if no slot is free
+ */
+int TimerController::once(unsigned long delayMillis, TimerCallback callback) {
+    return this->repeat(delayMillis, 1, callback);
+}
+
+/**
+ * @brief Execute callback periodic until the timer is canceled
+ * @param intervalMillis    Interval in milliseconds
+ * @param callback          Callback
+ * @return int              Handle of timer or TIMER_INVALID if no slot is free
+ */
+int TimerController::every(unsigned long intervalMillis, TimerCallback callback) {
+    return this->repeat(intervalMillis, -1, callback);
+}
+
+/**
+ * @brief Execute callback a number of times with an interval
+ * @param intervalMillis    Interval in milliseconds
+ * @param runs              Number of executions (-1 = endless)
+ * @param callback          Callback
+ * @return int              Handle of timer or TIMER_INVALID if no slot is free
+ */
+int TimerController::repeat(unsigned long intervalMillis, int runs, TimerCallback callback) {
+    for (int i = 0; i < TIMER_MAX_SLOTS; i++) {
+        if (!this->timers[i].active) {
+            // Handles are never reused, a stale handle can't cancel the next timer in this slot
+            this->lastHandle = (this->lastHandle == INT_MAX) ? 1 : this->lastHandle + 1;
+            this->timers[i].handle = this->lastHandle;
+            this->timers[i].active = true;
+            this->timers[i].startMillis = millis();
+            this->timers[i].intervalMillis = intervalMillis;
+            this->timers[i].remainingRuns = runs;
+            this->timers[i].callback = callback;
+            return this->lastHandle;
+        }
+    }
+    return TIMER_INVALID;
+}
+
+/**
+ * @brief Stop a timer without executing it
+ * @param timerHandle       Handle of timer
+ */
+void TimerController::cancel(int timerHandle) {
+    TimerDataStruct *timer = this->findTimer(timerHandle);
+    if (timer != NULL) {
+        timer->active = false;
+        timer->callback = nullptr;
+    }
+}
+
+/**
+ * @brief Check if the timer is still waiting for (further) execution
+ * @param timerHandle       Handle of timer
+ * @return true 
+ * @return false 
+ */
+bool TimerController::isActive(int timerHandle) {
+    return this->findTimer(timerHandle) != NULL;
+}
+
+/**
+ * @brief Find active timer by handle
+ * @param timerHandle           Handle of timer
+ * @return TimerDataStruct*     NULL if timer is not active (anymore)
+ */
+TimerDataStruct *TimerController::findTimer(int timerHandle) {
+    if (timerHandle == TIMER_INVALID) {
+        return NULL;
+    }
+    for (int i = 0; i < TIMER_MAX_SLOTS; i++) {
+        if (this->timers[i].active && (this->timers[i].handle == timerHandle)) {
+            return &this->timers[i];
+        }
+    }
+    return NULL;
+}
+
+/**
+ * @brief Execute all due timers, called from main loop
+ */
+void TimerController::handle() {
+    unsigned long now = millis();
+    for (int i = 0; i < TIMER_MAX_SLOTS; i++) {
+        TimerDataStruct *timer = &this->timers[i];
+        if (!timer->active || ((now - timer->startMillis) < timer->intervalMillis)) {
+            continue;
+        }
+        timer->startMillis = now;
+        if (timer->remainingRuns > 0) {
+            timer->remainingRuns--;
+        }
+
+        // Slot is freed before the call, so the callback can reuse it for a continuation
+        TimerCallback callback = timer->callback;
+        if (timer->remainingRuns == 0) {
+            this->cancel(timer->handle);
+        }
+        callback();
+    }
+}
@@ -0,0 +1,28 @@
+#pragma once
+#include <Arduino.h>
+#include <limits.h>
+#include "../DataStructs/TimerDataStruct.h"
+
+// Number of timers which can be active at the same time
+#define TIMER_MAX_SLOTS     8
+#define TIMER_INVALID       -1
+
+/**
+ * @brief Cooperative timers, executed from the main loop instead of blocking with delay()
+ */
+class TimerController {
+private:
+    TimerDataStruct timers[TIMER_MAX_SLOTS];
+    int lastHandle = 0;
+
+    TimerDataStruct *findTimer(int timerHandle);
+
+public:
+    TimerController();
+    int once(unsigned long delayMillis, TimerCallback callback);
+    int every(unsigned long intervalMillis, TimerCallback callback);
+    int repeat(unsigned long intervalMillis, int runs, TimerCallback callback);
+    void cancel(int timerHandle);
+    bool isActive(int timerHandle);
+    void handle();
+};
@@ -0,0 +1,88 @@
+#include "ViewFormatter.h"
+
+/**
+ * @brief Format all values of a printer
+ * @param view              Target view
+ * @param printerHandle     Handle to printer data
+ * @param clientType        Name of the printer api client
+ */
+void ViewFormatter::formatPrinter(PrinterViewDataStruct *view, PrinterDataStruct *printerHandle, const char *clientType) {
+    view->isCached = printerHandle->cachedEpoch > 0;
+    snprintf(view->stateText, sizeof(view->stateText), "%s%s%s",
+        view->isCached ? "Cached: " : "",
+        ViewFormatter::getPrinterStateAsText(printerHandle->state),
+        (printerHandle->isPSUoff && printerHandle->hasPsuControl && !view->isCached) ? ", PSU off" : ""
+    );
+    memset(view->clientType, 0, sizeof(view->clientType));
+    strncpy(view->clientType, clientType, sizeof(view->clientType) - 1);
+    snprintf(view->host, sizeof(view->host), "%s:%d", printerHandle->remoteAddress, printerHandle->remotePort);
+    snprintf(view->progress, sizeof(view->progress), "%d%%", printerHandle->progressCompletion);
+    ViewFormatter::formatDuration(view->printTime, sizeof(view->printTime), printerHandle->progressPrintTime);
+    ViewFormatter::formatDuration(view->printTimeLeft, sizeof(view->printTimeLeft), printerHandle->progressPrintTimeLeft);
+    ViewFormatter::formatFloat(view->toolTemp, sizeof(view->toolTemp), printerHandle->toolTemp, 1);
+    ViewFormatter::formatFloat(view->toolTempRounded, sizeof(view->toolTempRounded), printerHandle->toolTemp, 0);
+    ViewFormatter::formatFloat(view->toolTargetTemp, sizeof(view->toolTargetTemp), printerHandle->toolTargetTemp, 0);
+    ViewFormatter::formatFloat(view->bedTemp, sizeof(view->bedTemp), printerHandle->bedTemp, 1);
+    ViewFormatter::formatFloat(view->bedTempRounded, sizeof(view->bedTempRounded), printerHandle->bedTemp, 0);
+    ViewFormatter::formatFloat(view->bedTargetTemp, sizeof(view->bedTargetTemp), printerHandle->bedTargetTemp, 0);
+
+    view->fileSize[0] = 0;
+    if (printerHandle->fileSize > 0) {
+        snprintf(view->fileSize, sizeof(view->fileSize), "%d KB", printerHandle->fileSize);
+    }
+    view->filament[0] = 0;
+    if (printerHandle->filamentLength > 0) {
+        ViewFormatter::formatFloat(view->filament, sizeof(view->filament) - 2, printerHandle->filamentLength / 1000, 2);
+        strcat(view->filament, " m");
+    }
+}
+
+/**
+ * @brief Return a printer state as readable text
+ * @param state             Printer state
+ * @return const char* 
+ */
+const char *ViewFormatter::getPrinterStateAsText(int state) {
+    switch (state)
+    {
+    case PRINTER_STATE_ERROR:
+        return "Error";
+    case PRINTER_STATE_STANDBY:
+        return "Standby";
+    case PRINTER_STATE_PRINTING:
+        return "Printing";
+    case PRINTER_STATE_PAUSED:
+        return "Paused";
+    case PRINTER_STATE_COMPLETED:
+        return "Completed";
+    default:
+        return "Offline";
+    }
+}
+
+/**
+ * @brief Format seconds as hh:mm:ss
+ * @param target            Target buffer
+ * @param maxLen            Size of target buffer
+ * @param duration          Duration in seconds
+ */
+void ViewFormatter::formatDuration(char *target, size_t maxLen, int duration) {
+    if (duration < 0) {
+        duration = 0;
+    }
+    snprintf(target, maxLen, "%02d:%02d:%02d", duration / 3600, (duration / 60) % 60, duration % 60);
+}
+
+/**
+ * @brief Format float with fixed decimals
+ * @param target            Target buffer
+ * @param maxLen            Size of target buffer
+ * @param value             Value to format
+ * @param decimals          Number of decimals
+ */
+void ViewFormatter::formatFloat(char *target, size_t maxLen, float value, unsigned char decimals) {
+    char buffer[24];
+    dtostrf(value, 1, decimals, buffer);
+    strncpy(target, buffer, maxLen - 1);
+    target[maxLen - 1] = 0;
+}
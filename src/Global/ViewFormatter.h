@@ -0,0 +1,16 @@
+#pragma once
+#include <Arduino.h>
+#include "../DataStructs/ViewModelDataStruct.h"
+#include "../DataStructs/PrinterDataStruct.h"
+
+/**
+ * @brief Stateless formatting helpers of the view model
+ * Only depends on the data structs, so the formatting can also be checked on the host (env:native).
+ */
+class ViewFormatter {
+public:
+    static void formatPrinter(PrinterViewDataStruct *view, PrinterDataStruct *printerHandle, const char *clientType);
+    static const char *getPrinterStateAsText(int state);
+    static void formatDuration(char *target, size_t maxLen, int duration);
+    static void formatFloat(char *target, size_t maxLen, float value, unsigned char decimals);
+};
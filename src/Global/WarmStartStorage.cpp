@@ -0,0 +1,149 @@
+#include "WarmStartStorage.h"
+
+/**
+ * @brief Store snapshot in RTC user memory
+ * @param snapshot          Snapshot including header
+ * @param size              Size of snapshot
+ * @return true             Stored
+ * @return false            Snapshot too large for RTC memory
+ */
+bool WarmStartStorage::writeRtc(const uint32_t *snapshot, size_t size) {
+    size_t alignedSize = (size + 3) & ~3;
+    if (alignedSize > WARMSTART_RTC_SIZE) {
+        return false;
+    }
+    return ESP.rtcUserMemoryWrite(WARMSTART_RTC_OFFSET, (uint32_t *)snapshot, alignedSize);
+}
+
+/**
+ * @brief Store snapshot in LittleFS (temporary file, replaced after success)
+ * @param snapshot          Snapshot including header
+ * @param size              Size of snapshot
+ * @return true             Stored
+ * @return false
+ */
+bool WarmStartStorage::writeFile(const uint32_t *snapshot, size_t size) {
+    File f = LittleFS.open(BinaryConfigFile::tempFileName(WARMSTART_FILE), "w");
+    if (!f) {
+        return false;
+    }
+    bool success = f.write((const uint8_t *)snapshot, size) == size;
+    f.close();
+    return success && BinaryConfigFile::commit(WARMSTART_FILE);
+}
+
+/**
+ * @brief Read the newest valid snapshot
+ * @param size              Size of snapshot
+ * @return uint32_t*        Snapshot (release with free()) or NULL
+ */
+uint32_t *WarmStartStorage::read(size_t *size) {
+    size_t rtcSize = 0;
+    size_t fileSize = 0;
+    uint32_t *rtcSnapshot = WarmStartStorage::readRtc(&rtcSize);
+    uint32_t *fileSnapshot = WarmStartStorage::readFile(&fileSize);
+    if ((rtcSnapshot != NULL) && (fileSnapshot != NULL)) {
+        if (((WarmStartHeaderDataStruct *)rtcSnapshot)->epoch >= ((WarmStartHeaderDataStruct *)fileSnapshot)->epoch) {
+            free(fileSnapshot);
+            fileSnapshot = NULL;
+        } else {
+            free(rtcSnapshot);
+            rtcSnapshot = NULL;
+        }
+    }
+    if (rtcSnapshot != NULL) {
+        *size = rtcSize;
+        return rtcSnapshot;
+    }
+    *size = fileSize;
+    return fileSnapshot;
+}
+
+/**
+ * @brief Read snapshot from RTC user memory
+ * @param size              Size of snapshot
+ * @return uint32_t*        Snapshot (release with free()) or NULL
+ */
+uint32_t *WarmStartStorage::readRtc(size_t *size) {
+    WarmStartHeaderDataStruct header;
+    if (!ESP.rtcUserMemoryRead(WARMSTART_RTC_OFFSET, (uint32_t *)&header, sizeof(header))
+        || !WarmStartStorage::isValidHeader(&header)
+    ) {
+        return NULL;
+    }
+    size_t alignedSize = (header.size + 3) & ~3;
+    if (alignedSize > WARMSTART_RTC_SIZE) {
+        return NULL;
+    }
+    uint32_t *snapshot = (uint32_t *)malloc(alignedSize);
+    if (snapshot == NULL) {
+        return NULL;
+    }
+    if (!ESP.rtcUserMemoryRead(WARMSTART_RTC_OFFSET, snapshot, alignedSize) || !WarmStartStorage::isValidPayload(snapshot)) {
+        free(snapshot);
+        return NULL;
+    }
+    *size = header.size;
+    return snapshot;
+}
+
+/**
+ * @brief Read snapshot from LittleFS
+ * @param size              Size of snapshot
+ * @return uint32_t*        Snapshot (release with free()) or NULL
+ */
+uint32_t *WarmStartStorage::readFile(size_t *size) {
+    File f = LittleFS.open(WARMSTART_FILE, "r");
+    if (!f) {
+        return NULL;
+    }
+    WarmStartHeaderDataStruct header;
+    if ((f.read((uint8_t *)&header, sizeof(header)) != sizeof(header)) || !WarmStartStorage::isValidHeader(&header)) {
+        f.close();
+        return NULL;
+    }
+    uint32_t *snapshot = (uint32_t *)malloc((header.size + 3) & ~3);
+    if (snapshot == NULL) {
+        f.close();
+        return NULL;
+    }
+    memcpy(snapshot, &header, sizeof(header));
+    size_t payloadSize = header.size - sizeof(header);
+    size_t readBytes = f.read(((uint8_t *)snapshot) + sizeof(header), payloadSize);
+    f.close();
+    if ((readBytes != payloadSize) || !WarmStartStorage::isValidPayload(snapshot)) {
+        free(snapshot);
+        return NULL;
+    }
+    *size = header.size;
+    return snapshot;
+}
+
+/**
+ * @brief Check magic, version and the size expected for the number of printers
+ * @param header            Header to check
+ * @return true             Header matches this firmware
+ * @return false
+ */
+bool WarmStartStorage::isValidHeader(WarmStartHeaderDataStruct *header) {
+    size_t expectedSize = sizeof(WarmStartHeaderDataStruct)
+        + sizeof(WarmStartSensorDataStruct)
+        + sizeof(WarmStartWeatherDataStruct)
+        + (header->printerCount * sizeof(WarmStartPrinterDataStruct));
+    return (header->magic == WARMSTART_MAGIC)
+        && (header->version == WARMSTART_VERSION)
+        && (header->printerCount <= MAX_PRINTERS)
+        && (header->size == expectedSize);
+}
+
+/**
+ * @brief Check CRC of the data behind the header
+ * @param snapshot          Snapshot including header
+ * @return true             Data is not damaged
+ * @return false
+ */
+bool WarmStartStorage::isValidPayload(const uint32_t *snapshot) {
+    WarmStartHeaderDataStruct *header = (WarmStartHeaderDataStruct *)snapshot;
+    const uint8_t *payload = ((const uint8_t *)snapshot) + sizeof(WarmStartHeaderDataStruct);
+    return BinaryConfigFile::crc32(payload, header->size - sizeof(WarmStartHeaderDataStruct)) == header->crc;
+}
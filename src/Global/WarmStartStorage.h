@@ -0,0 +1,27 @@
+#pragma once
+#include <Arduino.h>
+#include <LittleFS.h>
+#include "Configuration.h"
+#include "../DataStructs/WarmStartDataStruct.h"
+#include "BinaryConfigFile.h"
+
+// RTC user memory is shared with the OTA bootloader command and the WiFi cache, start behind them (in 4 byte blocks)
+#define WARMSTART_RTC_OFFSET        40
+#define WARMSTART_RTC_SIZE          ((128 - WARMSTART_RTC_OFFSET) * 4)
+
+/**
+ * @brief Stores the warm start snapshot in RTC user memory (survives reset and OTA) and
+ * in LittleFS (survives power loss). On boot the newest valid snapshot is used.
+ */
+class WarmStartStorage {
+public:
+    static bool writeRtc(const uint32_t *snapshot, size_t size);
+    static bool writeFile(const uint32_t *snapshot, size_t size);
+    static uint32_t *read(size_t *size);
+
+private:
+    static uint32_t *readRtc(size_t *size);
+    static uint32_t *readFile(size_t *size);
+    static bool isValidHeader(WarmStartHeaderDataStruct *header);
+    static bool isValidPayload(const uint32_t *snapshot);
+};
@@ -4,11 +4,13 @@
 #include <SPI.h>
 #include "Global/GlobalDataController.h"
 #include "Global/DebugController.h"
+#include "Global/TimerController.h"
 #include "Configuration.h"
 #include "Network/WebServer.h"
 #include "Network/TimeClient.h"
 #include "Network/OpenWeatherMapClient.h"
 #include "Network/JsonRequestClient.h"
+#include "Network/WifiQuickConnect.h"
 #include "Clients/RepetierClient.h"
 #include "Clients/KlipperClient.h"
 #include "Clients/DuetClient.h"
@@ -25,16 +27,17 @@
 #include "Sensors/DHT22Wire.h"
 
 #include "Display/NextionDisplay.h"
-#include <SSD1306Wire.h>
-#include <SH1106Wire.h>
+#include "Display/Extras/Oled/SSD1306WirePartialRefresh.h"
+#include "Display/Extras/Oled/SH1106WirePartialRefresh.h"
 #include "Display/OledDisplay.h"
 
 // Initilize all needed data
 DebugController debugController(DEBUG_MODE_ENABLE);
+TimerController timerController;
 JsonRequestClient jsonRequestClient(&debugController);
 TimeClient timeClient(TIME_UTCOFFSET, &debugController);
 OpenWeatherMapClient weatherClient(WEATHER_APIKEY, WEATHER_CITYID, 1, WEATHER_METRIC, WEATHER_LANGUAGE, &debugController, &jsonRequestClient);
-GlobalDataController globalDataController(&timeClient, &weatherClient, &debugController);
+GlobalDataController globalDataController(&timeClient, &timerController, &weatherClient, &debugController);
 WebServer webServer(&globalDataController, &debugController);
 
 // Register all printer clients
@@ -59,8 +62,8 @@ TwoWire *i2cInterface = &Wire;
 
 // Construct correct display client
 SoftwareSerial displaySerialPort(DISPLAY_RX_PIN, DISPLAY_TX_PIN);
-SH1106Wire  displaySH1106(DISPLAY_I2C_DISPLAY_ADDRESS, DISPLAY_SDA_PIN, DISPLAY_SCL_PIN);
-SSD1306Wire displaySSD1306(DISPLAY_I2C_DISPLAY_ADDRESS, DISPLAY_SDA_PIN, DISPLAY_SCL_PIN);
+SH1106WirePartialRefresh  displaySH1106(DISPLAY_I2C_DISPLAY_ADDRESS, DISPLAY_SDA_PIN, DISPLAY_SCL_PIN);
+SSD1306WirePartialRefresh displaySSD1306(DISPLAY_I2C_DISPLAY_ADDRESS, DISPLAY_SDA_PIN, DISPLAY_SCL_PIN);
 NextionDisplay displayClient1(&displaySerialPort, &globalDataController, &debugController);
-OledDisplay displayClient2("OLED SH1106", &displaySH1106, &globalDataController, &debugController);
-OledDisplay displayClient3("OLED SSD1306", &displaySSD1306, &globalDataController, &debugController);
\ No newline at end of file
+OledDisplay displayClient2("OLED SH1106", &displaySH1106, &displaySH1106, &globalDataController, &debugController);
+OledDisplay displayClient3("OLED SSD1306", &displaySSD1306, &displaySSD1306, &globalDataController, &debugController);
\ No newline at end of file
@@ -1,6 +1,9 @@
 #include "JsonRequestClient.h"
 
 StaticJsonDocument<JSON_MAX_BUFFER> JsonRequestClient::lastJsonDocument;
+std::function<void()> JsonRequestClient::waitHandler = NULL;
+bool JsonRequestClient::requestRunning = false;
+bool JsonRequestClient::inWaitHandler = false;
 
 JsonRequestClient::JsonRequestClient(DebugController *debugController) {
     this->debugController = debugController;
@@ -12,7 +15,8 @@ WiFiClient JsonRequestClient::requestWifiClient(
     int port,
     String encodedAuth,
     String httpPath,
-    String apiPostBody
+    String apiPostBody,
+    HttpCacheDataStruct *cache
 ) {
     WiFiClient requestClient;
     requestClient.setTimeout(5000);
@@ -33,6 +37,10 @@ WiFiClient JsonRequestClient::requestWifiClient(
             requestClient.print("Authorization: ");
             requestClient.println("Basic " + encodedAuth);
         }
+        if ((cache != NULL) && (cache->etag[0] != 0)) {
+            requestClient.print("If-None-Match: ");
+            requestClient.println(cache->etag);
+        }
         requestClient.println("User-Agent: ArduinoWiFi/1.1");
         requestClient.println("Connection: close");
         if (requestType == PRINTER_REQUEST_POST) {
@@ -58,7 +66,17 @@ WiFiClient JsonRequestClient::requestWifiClient(
         return requestClient;
     }
 
-    while(requestClient.connected() && !requestClient.available()) delay(1); 
+    // Wait for response, other work (e.g. webserver) is handled meanwhile
+    unsigned long waitStart = millis();
+    while(requestClient.connected() && !requestClient.available()) {
+        if (millis() - waitStart > JSON_REQUEST_RESPONSE_TIMEOUT) {
+            this->debugController->printLn("SOCKET: Timeout: " + fullTarget);
+            this->lastError = "SOCKET: Timeout: " + fullTarget;
+            return requestClient;
+        }
+        JsonRequestClient::handleWait();
+        delay(1);
+    }
 
     // Did we have header data in response?
     char statusPeek[32] = {0};
@@ -72,14 +90,20 @@ WiFiClient JsonRequestClient::requestWifiClient(
     // Check HTTP status
     char status[32] = {0};
     requestClient.readBytesUntil('\r', status, sizeof(status));
-    if (strcmp(status, "HTTP/1.1 200 OK") != 0 && strcmp(status, "HTTP/1.1 409 CONFLICT") != 0) {
+    bool notModified = (cache != NULL) && (strcmp(status, "HTTP/1.1 304 Not Modified") == 0);
+    if (strcmp(status, "HTTP/1.1 200 OK") != 0 && strcmp(status, "HTTP/1.1 409 CONFLICT") != 0 && !notModified) {
         this->debugController->print("Unexpected response: ");
         this->debugController->printLn(status);
         this->lastError = "SOCKET: Response: " + String(status);
         return requestClient;
     }
 
-    // Skip HTTP headers
+    // Skip HTTP headers, keep cache validators if requested
+    if (cache != NULL) {
+        cache->notModified = notModified;
+        this->readCacheHeaders(&requestClient, cache);
+        return requestClient;
+    }
     char endOfHeaders[] = "\r\n\r\n";
     if (!requestClient.find(endOfHeaders)) {
         this->debugController->printLn("Invalid response");
@@ -89,6 +113,68 @@ WiFiClient JsonRequestClient::requestWifiClient(
     return requestClient;
 }
 
+/**
+ * @brief Read HTTP headers up to the body and keep ETag and Cache-Control max-age
+ * @param requestClient     Client positioned behind the status line
+ * @param cache             Target for the validators
+ */
+void JsonRequestClient::readCacheHeaders(WiFiClient *requestClient, HttpCacheDataStruct *cache) {
+    char line[96];
+    unsigned long maxAgeSec = 0;
+    bool hasEtag = false;
+    requestClient->readBytesUntil('\n', line, sizeof(line) - 1);
+    while (true) {
+        size_t len = requestClient->readBytesUntil('\n', line, sizeof(line) - 1);
+        if (len == 0) {
+            this->lastError = "SOCKET: Invalid response";
+            return;
+        }
+        line[len] = 0;
+        if (line[len - 1] == '\r') {
+            line[--len] = 0;
+        }
+        if (len == 0) {
+            break;
+        }
+        if (strncasecmp(line, "ETag:", 5) == 0) {
+            const char *value = line + 5;
+            while (*value == ' ') {
+                value++;
+            }
+            strncpy(cache->etag, value, sizeof(cache->etag) - 1);
+            cache->etag[sizeof(cache->etag) - 1] = 0;
+            hasEtag = true;
+        } else if (strncasecmp(line, "Cache-Control:", 14) == 0) {
+            const char *maxAge = strstr(line, "max-age=");
+            if (maxAge != NULL) {
+                maxAgeSec = strtoul(maxAge + 8, NULL, 10);
+            }
+        }
+    }
+    // A 304 response keeps the validators of the cached data
+    if (!cache->notModified) {
+        cache->maxAgeSec = maxAgeSec;
+        if (!hasEtag) {
+            cache->etag[0] = 0;
+        }
+    } else if (maxAgeSec > 0) {
+        cache->maxAgeSec = maxAgeSec;
+    }
+}
+
+/**
+ * @brief Send request and parse the JSON response
+ * @param requestType       PRINTER_REQUEST_GET or PRINTER_REQUEST_POST
+ * @param server            Host
+ * @param port              Port
+ * @param encodedAuth       Basic auth (base64) or empty
+ * @param httpPath          Path with query
+ * @param apiPostBody       Body for POST requests
+ * @param withResponse      Parse response
+ * @param filter            Only keep keys set to true in this document (NULL = keep all)
+ * @param cache             Send and update cache validators (NULL = no caching)
+ * @return JsonDocument*    Parsed document or NULL on error or unchanged data (cache->notModified)
+ */
 JsonDocument *JsonRequestClient::requestJson(
     int requestType,
     String server,
@@ -96,25 +182,34 @@ JsonDocument *JsonRequestClient::requestJson(
     String encodedAuth,
     String httpPath,
     String apiPostBody,
-    bool withResponse = false
+    bool withResponse,
+    JsonDocument *filter,
+    HttpCacheDataStruct *cache
 ) {
     // Request data
     this->resetLastError();
-    WiFiClient reqClient = this->requestWifiClient(requestType, server, port, encodedAuth, httpPath, apiPostBody);
-    if ((this->lastError != "") || !withResponse) {
+    JsonRequestClient::requestRunning = true;
+    WiFiClient reqClient = this->requestWifiClient(requestType, server, port, encodedAuth, httpPath, apiPostBody, cache);
+    if ((this->lastError != "") || !withResponse || ((cache != NULL) && cache->notModified)) {
         reqClient.stop();
+        JsonRequestClient::requestRunning = false;
         return NULL;
     }
     
     // Parse JSON object
-    DeserializationError error = deserializeJson(JsonRequestClient::lastJsonDocument, reqClient);
+    DeserializationError error;
+    if (filter != NULL) {
+        error = deserializeJson(JsonRequestClient::lastJsonDocument, reqClient, DeserializationOption::Filter(*filter));
+    } else {
+        error = deserializeJson(JsonRequestClient::lastJsonDocument, reqClient);
+    }
+    reqClient.stop();
+    JsonRequestClient::requestRunning = false;
     if (error) {
         this->debugController->printLn("Data Parsing failed: " + server + ":" + String(port) + "[" + error.c_str() + "]");
         this->lastError = "PARSER: Data Parsing failed: " + server + ":" + String(port);
-        reqClient.stop();
         return NULL;
     }
-    reqClient.stop();
     return &JsonRequestClient::lastJsonDocument;
 }
 
@@ -125,3 +220,33 @@ String JsonRequestClient::getLastError() {
 void JsonRequestClient::resetLastError() {
     this->lastError = "";
 }
+
+/**
+ * @brief Set handler that is called repeatedly while waiting for a response.
+ *        Not called during connect and DNS lookup, these still block.
+ * @param handler           Handler, e.g. for the webserver
+ */
+void JsonRequestClient::setWaitHandler(std::function<void()> handler) {
+    JsonRequestClient::waitHandler = handler;
+}
+
+/**
+ * @brief Check if a request is in progress (data of printers/weather may be incomplete)
+ * @return true 
+ * @return false 
+ */
+bool JsonRequestClient::isRequestRunning() {
+    return JsonRequestClient::requestRunning;
+}
+
+/**
+ * @brief Call wait handler, but never nested
+ */
+void JsonRequestClient::handleWait() {
+    if ((JsonRequestClient::waitHandler == NULL) || JsonRequestClient::inWaitHandler) {
+        return;
+    }
+    JsonRequestClient::inWaitHandler = true;
+    JsonRequestClient::waitHandler();
+    JsonRequestClient::inWaitHandler = false;
+}
@@ -3,24 +3,36 @@
 #include <ESP8266WiFi.h>
 #include <ArduinoJson.h>
 #include <base64.h>
+#include <functional>
 #include "Debug.h"
 #include "../Global/DebugController.h"
+#include "../DataStructs/HttpCacheDataStruct.h"
 
 #define PRINTER_REQUEST_GET     0
 #define PRINTER_REQUEST_POST    1
 
+// Maximum time to wait for the first byte of a response
+#define JSON_REQUEST_RESPONSE_TIMEOUT   5000
+
 class JsonRequestClient {
 private:
     DebugController *debugController;
     String lastError = "";
     static StaticJsonDocument<JSON_MAX_BUFFER> lastJsonDocument;
+    static std::function<void()> waitHandler;
+    static bool requestRunning;
+    static bool inWaitHandler;
 
 public:
     JsonRequestClient(DebugController *debugController);
-    JsonDocument *requestJson(int requestType, String server, int port, String encodedAuth, String httpPath, String apiPostBody, bool withResponse);
+    JsonDocument *requestJson(int requestType, String server, int port, String encodedAuth, String httpPath, String apiPostBody, bool withResponse, JsonDocument *filter = NULL, HttpCacheDataStruct *cache = NULL);
     String getLastError();
     void resetLastError();
+    static void setWaitHandler(std::function<void()> handler);
+    static bool isRequestRunning();
 
 private:
-    WiFiClient requestWifiClient(int requestType, String server, int port, String encodedAuth, String httpPath, String apiPostBody);
+    WiFiClient requestWifiClient(int requestType, String server, int port, String encodedAuth, String httpPath, String apiPostBody, HttpCacheDataStruct *cache);
+    void readCacheHeaders(WiFiClient *requestClient, HttpCacheDataStruct *cache);
+    static void handleWait();
 };
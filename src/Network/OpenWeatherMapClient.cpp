@@ -1,6 +1,8 @@
 #include "OpenWeatherMapClient.h"
 
 OpenWeatherMapClient::OpenWeatherMapClient(String ApiKey, int CityID, int cityCount, boolean isMetric, String language, DebugController *debugController, JsonRequestClient *jsonRequestClient) {
+    memset(this->weathers, 0, sizeof(this->weathers));
+    this->resetResponseCache();
     this->debugController = debugController;
     this->jsonRequestClient = jsonRequestClient;
     this->updateCityId(CityID);
@@ -12,6 +14,7 @@ OpenWeatherMapClient::OpenWeatherMapClient(String ApiKey, int CityID, int cityCo
 
 void OpenWeatherMapClient::updateWeatherApiKey(String ApiKey) {
     myApiKey = ApiKey;
+    this->resetResponseCache();
 }
 
 void OpenWeatherMapClient::updateLanguage(String language) {
@@ -19,6 +22,7 @@ void OpenWeatherMapClient::updateLanguage(String language) {
     if (lang == "") {
         lang = "en";
     }
+    this->resetResponseCache();
 }
 
 void OpenWeatherMapClient::updateWeather() {
@@ -26,9 +30,11 @@ void OpenWeatherMapClient::updateWeather() {
     String apiGetData = "/data/2.5/group?id=" + myCityIDs + "&units=" + units + "&cnt=1&APPID=" + myApiKey + "&lang=" + lang;
     this->debugController->printLn("Getting Weather Data");
     this->debugController->printLn(apiGetData);
-    weathers[0].cached = false;
-    weathers[0].error = "";
+    this->cached = false;
+    this->error = "";
 
+    StaticJsonDocument<WEATHER_FILTER_SIZE> filter;
+    OpenWeatherMapClient::buildResponseFilter(filter);
     JsonDocument *jsonBuffer = this->jsonRequestClient->requestJson(
         PRINTER_REQUEST_GET,
         String(servername),
@@ -36,51 +42,86 @@ void OpenWeatherMapClient::updateWeather() {
         "",
         apiGetData,
         "",
-        true
+        true,
+        &filter,
+        &this->responseCache
     );
+    if ((jsonBuffer == NULL) && (this->jsonRequestClient->getLastError() == "") && this->responseCache.notModified) {
+        this->debugController->printLn("Weather not modified");
+        return;
+    }
     if ((jsonBuffer == NULL) || (this->jsonRequestClient->getLastError() != "")) {
         this->debugController->printLn("Weather Data Parsing failed!");
         this->debugController->printLn(this->jsonRequestClient->getLastError());
-        weathers[0].error = this->jsonRequestClient->getLastError();
+        this->error = this->jsonRequestClient->getLastError();
         return;
     }
 
-    int count = ((*jsonBuffer)["cnt"]).as<int>();
+    int count = _min(((*jsonBuffer)["cnt"]).as<int>(), WEATHER_MAX_CITIES);
 
     for (int inx = 0; inx < count; inx++) {
-        weathers[inx].lon = ((*jsonBuffer)["list"][inx]["coord"]["lon"]).as<float>();
-        weathers[inx].lat = ((*jsonBuffer)["list"][inx]["coord"]["lat"]).as<float>();
-        weathers[inx].dt = ((*jsonBuffer)["list"][inx]["dt"]).as<long>();
-        weathers[inx].city = ((*jsonBuffer)["list"][inx]["name"]).as<const char*>();
-        weathers[inx].country = ((*jsonBuffer)["list"][inx]["sys"]["country"]).as<const char*>();
-        weathers[inx].temp = ((*jsonBuffer)["list"][inx]["main"]["temp"]).as<float>();
-        weathers[inx].humidity = ((*jsonBuffer)["list"][inx]["main"]["humidity"]).as<int>();
-        weathers[inx].condition = ((*jsonBuffer)["list"][inx]["weather"][0]["main"]).as<const char*>();
-        weathers[inx].wind = ((*jsonBuffer)["list"][inx]["wind"]["speed"]).as<float>();
-        weathers[inx].weatherId = ((*jsonBuffer)["list"][inx]["weather"][0]["id"]).as<int>();
-        weathers[inx].description = ((*jsonBuffer)["list"][inx]["weather"][0]["description"]).as<const char*>();
-        weathers[inx].icon = ((*jsonBuffer)["list"][inx]["weather"][0]["icon"]).as<const char*>();
-
-        this->debugController->printLn("lat: " + weathers[inx].lat);
-        this->debugController->printLn("lon: " + weathers[inx].lon);
-        this->debugController->printLn("dt: " + weathers[inx].dt);
-        this->debugController->printLn("city: " + weathers[inx].city);
-        this->debugController->printLn("country: " + weathers[inx].country);
-        this->debugController->printLn("temp: " + weathers[inx].temp);
-        this->debugController->printLn("humidity: " + weathers[inx].humidity);
-        this->debugController->printLn("condition: " + weathers[inx].condition);
-        this->debugController->printLn("wind: " + weathers[inx].wind);
-        this->debugController->printLn("weatherId: " + weathers[inx].weatherId);
-        this->debugController->printLn("description: " + weathers[inx].description);
-        this->debugController->printLn("icon: " + weathers[inx].icon);
-        this->debugController->printLn("");
+        JsonVariantConst item = (*jsonBuffer)["list"][inx];
+        weather *target = &weathers[inx];
+        target->lon = item["coord"]["lon"].as<float>();
+        target->lat = item["coord"]["lat"].as<float>();
+        target->dt = item["dt"].as<long>();
+        target->temp = item["main"]["temp"].as<float>();
+        target->humidity = item["main"]["humidity"].as<float>();
+        target->wind = item["wind"]["speed"].as<float>();
+        target->weatherId = item["weather"][0]["id"].as<int>();
+        OpenWeatherMapClient::copyJsonString(target->city, sizeof(target->city), item["name"]);
+        OpenWeatherMapClient::copyJsonString(target->country, sizeof(target->country), item["sys"]["country"]);
+        OpenWeatherMapClient::copyJsonString(target->condition, sizeof(target->condition), item["weather"][0]["main"]);
+        OpenWeatherMapClient::copyJsonString(target->description, sizeof(target->description), item["weather"][0]["description"]);
+        OpenWeatherMapClient::copyJsonString(target->icon, sizeof(target->icon), item["weather"][0]["icon"]);
+
+        char debugLine[128];
+        snprintf(debugLine, sizeof(debugLine), "%s, %s (%.2f, %.2f): %.1f, %.0f%%, %.1f, %d %s, %s", target->city, target->country,
+            target->lat, target->lon, target->temp, target->humidity, target->wind, target->weatherId, target->condition, target->icon);
+        this->debugController->printLn(debugLine);
     }
 }
 
-String OpenWeatherMapClient::roundValue(String value) {
-    float f = value.toFloat();
-    int rounded = (int)(f+0.5f);
-    return String(rounded);
+/**
+ * @brief Keep only the keys of the group response that are stored
+ * @param filter        Target filter document
+ */
+void OpenWeatherMapClient::buildResponseFilter(JsonDocument &filter) {
+    filter["cnt"] = true;
+    // Filter of the first element is used for all elements of the list
+    JsonObject item = filter["list"].createNestedObject();
+    item["coord"]["lat"] = true;
+    item["coord"]["lon"] = true;
+    item["dt"] = true;
+    item["name"] = true;
+    item["sys"]["country"] = true;
+    item["main"]["temp"] = true;
+    item["main"]["humidity"] = true;
+    item["wind"]["speed"] = true;
+    JsonObject weatherItem = item["weather"].createNestedObject();
+    weatherItem["id"] = true;
+    weatherItem["main"] = true;
+    weatherItem["description"] = true;
+    weatherItem["icon"] = true;
+}
+
+/**
+ * @brief Copy JSON string to a fixed buffer (truncated, always terminated)
+ * @param target        Target buffer
+ * @param maxLen        Size of target buffer
+ * @param value         JSON value, empty if not a string
+ */
+void OpenWeatherMapClient::copyJsonString(char *target, size_t maxLen, JsonVariantConst value) {
+    const char *source = value.as<const char*>();
+    if (source == NULL) {
+        source = "";
+    }
+    strncpy(target, source, maxLen - 1);
+    target[maxLen - 1] = 0;
+}
+
+int OpenWeatherMapClient::roundValue(float value) {
+    return (int)lroundf(value);
 }
 
 void OpenWeatherMapClient::updateCityId(int CityID) {
@@ -99,6 +140,7 @@ void OpenWeatherMapClient::updateCityIdList(int CityIDs[], int cityCount) {
             myCityIDs = myCityIDs + String(CityIDs[inx]); 
         }
     }
+    this->resetResponseCache();
 }
 
 void OpenWeatherMapClient::setMetric(boolean isMetric) {
@@ -108,74 +150,90 @@ void OpenWeatherMapClient::setMetric(boolean isMetric) {
         units = "imperial";
     }
     this->isMetric = isMetric;
+    this->resetResponseCache();
+}
+
+/**
+ * @brief Forget ETag and max-age, the next request fetches full data
+ */
+void OpenWeatherMapClient::resetResponseCache() {
+    memset(&this->responseCache, 0, sizeof(HttpCacheDataStruct));
+}
+
+/**
+ * @brief Return max-age of the last response (0 = not sent by server)
+ * @return unsigned long 
+ */
+unsigned long OpenWeatherMapClient::getMaxAgeSec() {
+    return this->responseCache.maxAgeSec;
 }
 
 String OpenWeatherMapClient::getWeatherResults() {
     return result;
 }
 
-String OpenWeatherMapClient::getLat(int index) {
+float OpenWeatherMapClient::getLat(int index) {
     return weathers[index].lat;
 }
 
-String OpenWeatherMapClient::getLon(int index) {
+float OpenWeatherMapClient::getLon(int index) {
     return weathers[index].lon;
 }
 
-String OpenWeatherMapClient::getDt(int index) {
+long OpenWeatherMapClient::getDt(int index) {
     return weathers[index].dt;
 }
 
-String OpenWeatherMapClient::getCity(int index) {
+const char *OpenWeatherMapClient::getCity(int index) {
     return weathers[index].city;
 }
 
-String OpenWeatherMapClient::getCountry(int index) {
+const char *OpenWeatherMapClient::getCountry(int index) {
     return weathers[index].country;
 }
 
-String OpenWeatherMapClient::getTemp(int index) {
+float OpenWeatherMapClient::getTemp(int index) {
     return weathers[index].temp;
 }
 
-String OpenWeatherMapClient::getTempRounded(int index) {
+int OpenWeatherMapClient::getTempRounded(int index) {
     return roundValue(getTemp(index));
 }
 
-String OpenWeatherMapClient::getHumidity(int index) {
+float OpenWeatherMapClient::getHumidity(int index) {
     return weathers[index].humidity;
 }
 
-String OpenWeatherMapClient::getHumidityRounded(int index) {
+int OpenWeatherMapClient::getHumidityRounded(int index) {
     return roundValue(getHumidity(index));
 }
 
-String OpenWeatherMapClient::getCondition(int index) {
+const char *OpenWeatherMapClient::getCondition(int index) {
     return weathers[index].condition;
 }
 
-String OpenWeatherMapClient::getWind(int index) {
+float OpenWeatherMapClient::getWind(int index) {
     return weathers[index].wind;
 }
 
-String OpenWeatherMapClient::getWindRounded(int index) {
+int OpenWeatherMapClient::getWindRounded(int index) {
     return roundValue(getWind(index));
 }
 
-String OpenWeatherMapClient::getWeatherId(int index) {
+int OpenWeatherMapClient::getWeatherId(int index) {
     return weathers[index].weatherId;
 }
 
-String OpenWeatherMapClient::getDescription(int index) {
+const char *OpenWeatherMapClient::getDescription(int index) {
     return weathers[index].description;
 }
 
-String OpenWeatherMapClient::getIcon(int index) {
+const char *OpenWeatherMapClient::getIcon(int index) {
     return weathers[index].icon;
 }
 
 boolean OpenWeatherMapClient::getCached() {
-    return weathers[0].cached;
+    return this->cached;
 }
 
 String OpenWeatherMapClient::getMyCityIDs() {
@@ -183,13 +241,13 @@ String OpenWeatherMapClient::getMyCityIDs() {
 }
 
 String OpenWeatherMapClient::getError() {
-    return weathers[0].error;
+    return this->error;
 }
 
-String OpenWeatherMapClient::getWeatherIcon(int index)
+const char *OpenWeatherMapClient::getWeatherIcon(int index)
 {
-    int id = getWeatherId(index).toInt();
-    String W = ")";
+    int id = getWeatherId(index);
+    const char *W = ")";
     switch(id)
     {
         case 800: W = "B"; break;
@@ -5,6 +5,11 @@
 #include "../Global/DebugController.h"
 #include "JsonRequestClient.h"
 
+// Number of cities that can be requested at once
+#define WEATHER_MAX_CITIES          5
+// Size of the filter document that keeps only the used keys of the weather response
+#define WEATHER_FILTER_SIZE         384
+
 class OpenWeatherMapClient {
 private:
     String myCityIDs = "";
@@ -17,25 +22,28 @@ private:
     String result;
 
     typedef struct {
-        String lat;
-        String lon;
-        String dt;
-        String city;
-        String country;
-        String temp;
-        String humidity;
-        String condition;
-        String wind;
-        String weatherId;
-        String description;
-        String icon;
-        boolean cached;
-        String error;
+        float lat;
+        float lon;
+        long dt;
+        float temp;
+        float humidity;
+        float wind;
+        int weatherId;
+        char city[24];
+        char country[4];
+        char condition[16];
+        char description[32];
+        char icon[4];
     } weather;
 
-    weather weathers[5];
+    weather weathers[WEATHER_MAX_CITIES];
+    boolean cached = false;
+    String error = "";
+    HttpCacheDataStruct responseCache;
 
-    String roundValue(String value);
+    static int roundValue(float value);
+    static void copyJsonString(char *target, size_t maxLen, JsonVariantConst value);
+    static void buildResponseFilter(JsonDocument &filter);
     DebugController *debugController;
     JsonRequestClient *jsonRequestClient;
 
@@ -47,27 +55,29 @@ public:
     void updateCityIdList(int CityIDs[], int cityCount);
     void updateLanguage(String language);
     void setMetric(boolean isMetric);
+    void resetResponseCache();
+    unsigned long getMaxAgeSec();
 
     String getWeatherResults();
 
-    String getLat(int index);
-    String getLon(int index);
-    String getDt(int index);
-    String getCity(int index);
-    String getCountry(int index);
-    String getTemp(int index);
-    String getTempRounded(int index);
-    String getHumidity(int index);
-    String getHumidityRounded(int index);
-    String getCondition(int index);
-    String getWind(int index);
-    String getWindRounded(int index);
-    String getWeatherId(int index);
-    String getDescription(int index);
-    String getIcon(int index);
+    float getLat(int index);
+    float getLon(int index);
+    long getDt(int index);
+    const char *getCity(int index);
+    const char *getCountry(int index);
+    float getTemp(int index);
+    int getTempRounded(int index);
+    float getHumidity(int index);
+    int getHumidityRounded(int index);
+    const char *getCondition(int index);
+    float getWind(int index);
+    int getWindRounded(int index);
+    int getWeatherId(int index);
+    const char *getDescription(int index);
+    const char *getIcon(int index);
     boolean getCached();
     String getMyCityIDs();
-    String getWeatherIcon(int index);
+    const char *getWeatherIcon(int index);
     String getError();
     String getTempSymbol();
     String getTempSymbol(boolean forHTML);
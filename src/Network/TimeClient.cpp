@@ -5,18 +5,52 @@ TimeClient::TimeClient(float utcOffset, DebugController * debugController) {
     this->debugController = debugController;
 }
 
+static const char *ntpServers[] = { TIME_NTP_SERVERS };
+static const int ntpServerCount = sizeof(ntpServers) / sizeof(ntpServers[0]);
+static_assert(ntpServerCount <= NTP_SERVER_MAX, "Too many TIME_NTP_SERVERS, increase NTP_SERVER_MAX");
+
+/**
+ * @brief Poll time synchronization, the request is sent and read in separate loop runs
+ * @param snycDelayMinutes      Minutes between synchronizations
+ * @return true                 If a synchronization was completed (or failed) in this call
+ * @return false 
+ */
 bool TimeClient::handleSync(int snycDelayMinutes) {
+    this->handleSlew();
+    if (this->syncState == TIME_SYNC_STATE_WAITING) {
+        if (!this->handleUpdateTime()) {
+            return false;
+        }
+        this->syncState = TIME_SYNC_STATE_IDLE;
+        this->lastEpoch = this->getCurrentEpoch();
+        this->debugController->printLn("Local time: " + this->getAmPmFormattedTime());
+        return true;
+    }
+
     //Get Time Update
-    if((this->getMinutesFromLast(this->lastEpoch) >= snycDelayMinutes) || this->lastEpoch == 0) {
+    if((this->getMinutesFromLast(this->lastEpoch) >= snycDelayMinutes) || this->lastEpoch == 0
+        || (!this->isTimeValid() && (this->getSecondsFromLast(this->lastEpoch) >= TIME_RETRY_SECONDS))
+    ) {
         this->debugController->printLn("Updating Time...");
-        this->updateTime();
+        if (this->startUpdateTime()) {
+            this->syncState = TIME_SYNC_STATE_WAITING;
+            return false;
+        }
         this->lastEpoch = this->getCurrentEpoch();
-        this->debugController->printLn("Local time: " + this->getAmPmFormattedTime());
         return true;
     }
     return false;
 }
 
+/**
+ * @brief Check if a synchronization is running
+ * @return true 
+ * @return false 
+ */
+bool TimeClient::isSyncing() {
+    return this->syncState != TIME_SYNC_STATE_IDLE;
+}
+
 int TimeClient::getMinutesFromLast(long lastEpochToUse) {
     return this->getSecondsFromLast(lastEpochToUse) / 60;
 }
@@ -34,49 +68,166 @@ long TimeClient::getLastEpoch() {
     return this->lastEpoch;
 }
 
-void TimeClient::updateTime() {
-    WiFiClient client;
-    
-    if (!client.connect(ntpServerName, httpPort)) {
-        this->debugController->printLn("connection failed");
+bool TimeClient::isTimeValid() {
+    return this->localEpoc != 0;
+}
+
+/**
+ * @brief Send time request to the first server with known address
+ * @return true         If request was sent
+ * @return false 
+ */
+bool TimeClient::startUpdateTime() {
+    if (!this->udpStarted) {
+        this->udpStarted = this->syncUdp.begin(NTP_LOCAL_PORT) == 1;
+    }
+    this->resolveNextServer();
+    for (int i = 0; i < ntpServerCount; i++) {
+        if (this->sendRequest(i)) {
+            return true;
+        }
+    }
+    this->debugController->printLn("connection failed");
+    return false;
+}
+
+/**
+ * @brief Read the response as soon as it is received, ask the next server on timeout
+ * @return true         If the request is finished (successful or not)
+ * @return false        Still waiting for response
+ */
+bool TimeClient::handleUpdateTime() {
+    if (this->readResponse()) {
+        return true;
+    }
+    if ((millis() - this->syncStartMillis) < TIME_RESPONSE_TIMEOUT_MS) {
+        return false;
+    }
+    this->debugController->printLn("Time response timed out: " + String(ntpServers[this->syncServerIdx]));
+    // Address may have changed, it is resolved again when a later sync starts
+    this->serverIps[this->syncServerIdx] = IPAddress();
+    for (int i = this->syncServerIdx + 1; i < ntpServerCount; i++) {
+        if (this->sendRequest(i)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief Resolve the address of one server without cached address (DNS lookup blocks),
+ * the servers take turns so a failing first server does not starve the others
+ */
+void TimeClient::resolveNextServer() {
+    for (int i = 0; i < ntpServerCount; i++) {
+        int serverIdx = (this->resolveServerIdx + i) % ntpServerCount;
+        if (this->serverIps[serverIdx].isSet()) {
+            continue;
+        }
+        this->resolveServerIdx = (serverIdx + 1) % ntpServerCount;
+        if (WiFi.hostByName(ntpServers[serverIdx], this->serverIps[serverIdx]) != 1) {
+            this->serverIps[serverIdx] = IPAddress();
+            this->debugController->printLn("Time server not resolved: " + String(ntpServers[serverIdx]));
+        }
         return;
     }
+}
+
+/**
+ * @brief Send SNTP request to the cached server address, the transmit timestamp is a nonce to match the response
+ * @param serverIdx     Index in TIME_NTP_SERVERS
+ * @return true         Request sent
+ * @return false 
+ */
+bool TimeClient::sendRequest(int serverIdx) {
+    if (!this->udpStarted || !this->serverIps[serverIdx].isSet()) {
+        return false;
+    }
+    // Drop late answers of previous requests
+    while (this->syncUdp.parsePacket() > 0) {
+        this->syncUdp.flush();
+    }
+
+    this->syncNonce = (uint32_t)micros() ^ ((uint32_t)millis() << 12);
+    TimeSyncMath::buildRequest(this->packetBuffer, this->syncNonce);
+    if (!this->syncUdp.beginPacket(this->serverIps[serverIdx], NTP_PORT)) {
+        this->serverIps[serverIdx] = IPAddress();
+        return false;
+    }
+    this->syncUdp.write(this->packetBuffer, NTP_PACKET_SIZE);
+    if (!this->syncUdp.endPacket()) {
+        this->serverIps[serverIdx] = IPAddress();
+        return false;
+    }
+    this->syncServerIdx = serverIdx;
+    this->syncStartMillis = millis();
+    return true;
+}
+
+/**
+ * @brief Read and apply a received SNTP response
+ * @return true         Valid response applied
+ * @return false        Nothing (valid) received
+ */
+bool TimeClient::readResponse() {
+    int size = this->syncUdp.parsePacket();
+    if (size <= 0) {
+        return false;
+    }
+    unsigned long receiveMillis = millis();
+    // Read too late (loop was blocked), the round trip is unknown
+    if ((size < NTP_PACKET_SIZE) || ((receiveMillis - this->syncStartMillis) > TIME_RESPONSE_TIMEOUT_MS)) {
+        this->syncUdp.flush();
+        return false;
+    }
+    this->syncUdp.read(this->packetBuffer, NTP_PACKET_SIZE);
+    this->syncUdp.flush();
+
+    TimeSyncDataStruct result;
+    if (!TimeSyncMath::parseResponse(this->packetBuffer, this->syncNonce, receiveMillis - this->syncStartMillis, &result)) {
+        return false;
+    }
+    this->debugController->printLn("SNTP " + String(ntpServers[this->syncServerIdx]) + ": rtt " + String(result.roundTripMs) + " ms");
+    this->setTime(result.epoch, receiveMillis - result.epochMs, true);
+    return true;
+}
 
-    // This will send the request to the server
-    client.print(String("GET / HTTP/1.1\r\n") +
-                 String("Host: www.google.com\r\n") +
-                 String("Connection: close\r\n\r\n"));
-    int repeatCounter = 0;
-    while(!client.available() && repeatCounter < 10) {
-        delay(1000);
-        this->debugController->printLn(".");
-        repeatCounter++;
-    }
-
-    String line;
-
-    int size = 0;
-    client.setNoDelay(false);
-    while(client.connected()) {
-        while((size = client.available()) > 0) {
-            line = client.readStringUntil('\n');
-            line.toUpperCase();
-            // example:
-            // date: Thu, 19 Nov 2015 20:25:40 GMT
-            if (line.startsWith("DATE: ")) {
-                this->debugController->printLn(line.substring(23, 25) + ":" + line.substring(26, 28) + ":" +line.substring(29, 31));
-                int parsedHours = line.substring(23, 25).toInt();
-                int parsedMinutes = line.substring(26, 28).toInt();
-                int parsedSeconds = line.substring(29, 31).toInt();
-                this->debugController->printLn(String(parsedHours) + ":" + String(parsedMinutes) + ":" + String(parsedSeconds));
-
-                localEpoc = (parsedHours * 60 * 60 + parsedMinutes * 60 + parsedSeconds);
-                this->debugController->printLn(localEpoc);
-                localMillisAtUpdate = millis();
-                client.stop();
-            }
+/**
+ * @brief Set clock, differences up to TIME_SLEW_MAX_MS are slewed
+ * @param epoch             Unix time in seconds
+ * @param millisAtEpoch     millis() at the start of this second
+ * @param allowSlew         false = always set at once
+ */
+void TimeClient::setTime(long epoch, unsigned long millisAtEpoch, bool allowSlew) {
+    if (allowSlew && (this->localEpoc != 0)) {
+        long offsetMs = TimeSyncMath::getClockOffset(epoch, millisAtEpoch, this->localEpoc, this->localMillisAtUpdate);
+        if (TimeSyncMath::canSlew(offsetMs)) {
+            this->slewRemainingMs = offsetMs;
+            this->slewLastMillis = millis();
+            return;
         }
     }
+    this->localEpoc = epoch;
+    this->localMillisAtUpdate = millisAtEpoch;
+    this->slewRemainingMs = 0;
+}
+
+/**
+ * @brief Correct the clock step by step, it never runs more than 1/TIME_SLEW_RATE_DIVIDER faster or slower
+ */
+void TimeClient::handleSlew() {
+    if (this->slewRemainingMs == 0) {
+        return;
+    }
+    unsigned long now = millis();
+    long step = TimeSyncMath::getSlewStep(this->slewRemainingMs, now - this->slewLastMillis);
+    if (step == 0) {
+        return;
+    }
+    this->slewLastMillis = now;
+    // Clock behind (positive offset): move the reference point back, so more time has passed
+    this->localMillisAtUpdate -= step;
+    this->slewRemainingMs -= step;
 }
 
 void TimeClient::setUtcOffset(float utcOffset) {
@@ -169,7 +320,7 @@ String TimeClient::getAmPmFormattedTime() {
 }
 
 long TimeClient::getCurrentEpoch() {
-    return localEpoc + ((millis() - localMillisAtUpdate) / 1000);
+    return localEpoc + ((long)(millis() - localMillisAtUpdate) / 1000);
 }
 
 long TimeClient::getCurrentEpochWithUtcOffset() {
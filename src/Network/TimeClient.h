@@ -1,30 +1,61 @@
 #pragma once
 #include <ESP8266WiFi.h>
+#include <WiFiUdp.h>
+#include "Configuration.h"
 #include "../Global/DebugController.h"
+#include "TimeSyncMath.h"
 
-#define NTP_PACKET_SIZE 48
+#define NTP_PORT                    123
+#define NTP_LOCAL_PORT              2390
+#define NTP_SERVER_MAX              4               // Max. entries in TIME_NTP_SERVERS
+#define TIME_RESPONSE_TIMEOUT_MS    1500            // Wait for a server before the next one is asked
+#define TIME_RETRY_SECONDS          30              // Retry of a failed sync while the clock is not set yet
 
+#define TIME_SYNC_STATE_IDLE        0
+#define TIME_SYNC_STATE_WAITING     1
+
+/**
+ * @brief SNTP client, one UDP request/response per sync without blocking the loop.
+ * The round trip time is compensated, small differences are slewed so the clock does not jump.
+ * Server addresses are cached, only one missing address is resolved (blocking) when a sync starts.
+ */
 class TimeClient {
 private:
     float myUtcOffset = 0;
     long localEpoc = 0;
-    long localMillisAtUpdate;
-    const char* ntpServerName = "www.google.com";
-    const int httpPort = 80;    
-    byte packetBuffer[ NTP_PACKET_SIZE]; //buffer to hold incoming and outgoing packets
+    unsigned long localMillisAtUpdate = 0;
+    byte packetBuffer[NTP_PACKET_SIZE]; //buffer to hold incoming and outgoing packets
     DebugController * debugController;
     
     long lastEpoch = 0;
-    long firstEpoch = 0;
+    WiFiUDP syncUdp;
+    bool udpStarted = false;
+    int syncState = TIME_SYNC_STATE_IDLE;
+    int syncServerIdx = 0;
+    IPAddress serverIps[NTP_SERVER_MAX];
+    int resolveServerIdx = 0;
+    unsigned long syncStartMillis = 0;
+    uint32_t syncNonce = 0;
+    long slewRemainingMs = 0;
+    unsigned long slewLastMillis = 0;
+
+    void resolveNextServer();
+    bool sendRequest(int serverIdx);
+    bool readResponse();
+    void setTime(long epoch, unsigned long millisAtEpoch, bool allowSlew);
+    void handleSlew();
 
 public:
     TimeClient(float utcOffset, DebugController * debugController);
-    void updateTime();
+    bool startUpdateTime();
+    bool handleUpdateTime();
     bool handleSync(int snycDelayMinutes);
     int getMinutesFromLast(long lastEpochToUse);
     int getSecondsFromLast(long lastEpochToUse);
     void resetLastEpoch();
     long getLastEpoch();
+    bool isTimeValid();
+    bool isSyncing();
 
     
     
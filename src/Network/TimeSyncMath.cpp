@@ -0,0 +1,103 @@
+#include "TimeSyncMath.h"
+
+/**
+ * @brief Build SNTP request, the transmit timestamp is a nonce to match the response
+ * @param packet            Target with NTP_PACKET_SIZE bytes
+ * @param nonce             Random value, echoed by the server as originate timestamp
+ */
+void TimeSyncMath::buildRequest(byte *packet, uint32_t nonce) {
+    memset(packet, 0, NTP_PACKET_SIZE);
+    packet[0] = 0x23;   // LI = 0, Version = 4, Mode = 3 (client)
+    TimeSyncMath::writeUInt32(&packet[40], nonce);
+}
+
+/**
+ * @brief Check a SNTP response and calculate the time at its receive
+ * @param packet            Response with NTP_PACKET_SIZE bytes
+ * @param nonce             Nonce of the request
+ * @param elapsedMillis     Milliseconds from sending the request to the receive of the response
+ * @param result            Target
+ * @return true             Valid response
+ * @return false            Not our request or server not usable
+ */
+bool TimeSyncMath::parseResponse(const byte *packet, uint32_t nonce, unsigned long elapsedMillis, TimeSyncDataStruct *result) {
+    // Mode 4 (server), stratum 1...15 (0 = kiss of death) and our request echoed as originate timestamp
+    uint8_t mode = packet[0] & 0x07;
+    uint8_t stratum = packet[1];
+    if ((mode != 4) || (stratum == 0) || (stratum > 15) || (TimeSyncMath::readUInt32(&packet[24]) != nonce)) {
+        return false;
+    }
+
+    // Server receive (T2) and transmit (T3) timestamps, in milliseconds from the same second
+    uint32_t receiveSeconds = TimeSyncMath::readUInt32(&packet[32]);
+    uint32_t receiveMs = ((uint64_t)TimeSyncMath::readUInt32(&packet[36]) * 1000) >> 32;
+    uint32_t transmitSeconds = TimeSyncMath::readUInt32(&packet[40]);
+    uint32_t transmitMs = ((uint64_t)TimeSyncMath::readUInt32(&packet[44]) * 1000) >> 32;
+    long serverProcessingMs = ((long)(int32_t)(transmitSeconds - receiveSeconds) * 1000) + (long)transmitMs - (long)receiveMs;
+
+    // Half of the network round trip has passed since the server sent the response
+    result->roundTripMs = (long)elapsedMillis - _max(0L, serverProcessingMs);
+    long delayMs = _max(0L, result->roundTripMs) / 2;
+    result->epoch = (long)(transmitSeconds - NTP_UNIX_OFFSET);
+    result->epochMs = transmitMs + delayMs;
+    result->epoch += result->epochMs / 1000;
+    result->epochMs %= 1000;
+    return true;
+}
+
+/**
+ * @brief Difference of a new time to the running clock, both at the same millis()
+ * @param epoch                 New unix time in seconds
+ * @param millisAtEpoch         millis() at the start of this second
+ * @param localEpoch            Unix time of the running clock
+ * @param localMillisAtEpoch    millis() at the start of this second of the running clock
+ * @return long                 Milliseconds, positive = running clock is behind
+ */
+long TimeSyncMath::getClockOffset(long epoch, unsigned long millisAtEpoch, long localEpoch, unsigned long localMillisAtEpoch) {
+    return ((epoch - localEpoch) * 1000) - (long)(millisAtEpoch - localMillisAtEpoch);
+}
+
+/**
+ * @brief Check if a difference is corrected slowly instead of setting the clock at once
+ * @param offsetMs          Result of getClockOffset
+ * @return true 
+ * @return false 
+ */
+bool TimeSyncMath::canSlew(long offsetMs) {
+    return abs(offsetMs) <= TIME_SLEW_MAX_MS;
+}
+
+/**
+ * @brief Correction for the passed time, the clock never runs more than 1/TIME_SLEW_RATE_DIVIDER faster or slower
+ * @param remainingMs       Difference that is not corrected yet
+ * @param elapsedMillis     Milliseconds since the last correction
+ * @return long             Correction with the sign of remainingMs, 0 = wait for more time to pass
+ */
+long TimeSyncMath::getSlewStep(long remainingMs, unsigned long elapsedMillis) {
+    long step = (long)(elapsedMillis / TIME_SLEW_RATE_DIVIDER);
+    if (step > abs(remainingMs)) {
+        step = abs(remainingMs);
+    }
+    return remainingMs < 0 ? -step : step;
+}
+
+/**
+ * @brief Read big endian value from packet
+ * @param buffer        Source
+ * @return uint32_t 
+ */
+uint32_t TimeSyncMath::readUInt32(const byte *buffer) {
+    return ((uint32_t)buffer[0] << 24) | ((uint32_t)buffer[1] << 16) | ((uint32_t)buffer[2] << 8) | (uint32_t)buffer[3];
+}
+
+/**
+ * @brief Write big endian value to packet
+ * @param buffer        Target
+ * @param value         Value
+ */
+void TimeSyncMath::writeUInt32(byte *buffer, uint32_t value) {
+    buffer[0] = value >> 24;
+    buffer[1] = value >> 16;
+    buffer[2] = value >> 8;
+    buffer[3] = value;
+}
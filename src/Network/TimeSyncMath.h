@@ -0,0 +1,23 @@
+#pragma once
+#include <Arduino.h>
+#include "../DataStructs/TimeSyncDataStruct.h"
+
+#define NTP_PACKET_SIZE             48
+#define NTP_UNIX_OFFSET             2208988800UL    // Seconds from 1900 (NTP) to 1970 (Unix)
+#define TIME_SLEW_MAX_MS            2000            // Smaller differences are corrected slowly, larger ones are set at once
+#define TIME_SLEW_RATE_DIVIDER      20              // Slewed clock runs max. 1/x faster or slower (5%)
+
+/**
+ * @brief Stateless SNTP packet handling and clock arithmetic of the TimeClient
+ * Only depends on the data structs, so the calculation can also be checked on the host (env:native).
+ */
+class TimeSyncMath {
+public:
+    static void buildRequest(byte *packet, uint32_t nonce);
+    static bool parseResponse(const byte *packet, uint32_t nonce, unsigned long elapsedMillis, TimeSyncDataStruct *result);
+    static long getClockOffset(long epoch, unsigned long millisAtEpoch, long localEpoch, unsigned long localMillisAtEpoch);
+    static bool canSlew(long offsetMs);
+    static long getSlewStep(long remainingMs, unsigned long elapsedMillis);
+    static uint32_t readUInt32(const byte *buffer);
+    static void writeUInt32(byte *buffer, uint32_t value);
+};
@@ -11,6 +11,7 @@ void WebServer::setup() {
     static WebServer* obj = this;
     this->server = new ESP8266WebServer(this->globalDataController->getSystemSettings()->webserverPort);
     this->serverUpdater = new ESP8266HTTPUpdateServer();
+    this->events = new WebserverEvents(this->globalDataController);
 
     // Web routes
     this->server->on("/", []() { obj->handleMainPage(); });
@@ -19,6 +20,7 @@ void WebServer::setup() {
     this->server->on("/configurestation/show", []() { obj->handleConfigureStation(); });
     this->server->on("/configurestation/update", []() { obj->handleUpdateStation(); });
     this->server->on("/configureprinter/show", []() { obj->handleConfigurePrinter(); });
+    this->server->on("/configureprinter/get", []() { obj->handlePrinterConfigData(); });
     this->server->on("/configureprinter/edit", []() { obj->handleUpdatePrinter(); });
     this->server->on("/configureprinter/delete", []() { obj->handleDeletePrinter(); });
     this->server->on("/configureweather/show", []() { obj->handleConfigureWeather(); });
@@ -28,6 +30,18 @@ void WebServer::setup() {
     this->server->on("/configuredisplay/show", []() { obj->handleConfigureDisplay(); });
     this->server->on("/configuredisplay/update", []() { obj->handleUpdateDisplay(); });
     this->server->on("/update", HTTP_GET, []() { obj->handleUpdatePage(); });
+    this->server->on("/settings/backup", HTTP_GET, []() { obj->handleSettingsBackup(); });
+    this->server->on("/settings/restore", HTTP_POST, []() { obj->handleSettingsRestore(); }, []() { obj->handleSettingsRestoreUpload(); });
+    this->server->on("/display/frame.pbm", HTTP_GET, []() { obj->handleDisplayFrame(); });
+    this->server->on("/api/v1/printers", HTTP_GET, []() { obj->handleApiPrinters(); });
+    this->server->on("/api/v1/sensor", HTTP_GET, []() { obj->handleApiSensor(); });
+    this->server->on("/api/v1/weather", HTTP_GET, []() { obj->handleApiWeather(); });
+    this->server->on("/api/v1/system", HTTP_GET, []() { obj->handleApiSystem(); });
+    this->server->on("/api/v1/state", HTTP_GET, []() { obj->handleApiState(); });
+    this->server->on("/api/v1/printerclients", HTTP_GET, []() { obj->handleApiPrinterClients(); });
+    this->server->on("/events", HTTP_GET, []() { obj->handleEvents(); });
+
+    WebserverAssets::setup(this->server);
 
     this->server->onNotFound([]() { obj->redirectHome(); });
     this->serverUpdater->setup(
@@ -38,7 +52,8 @@ void WebServer::setup() {
     );
     
 
-    // Start the server
+    // Start the server, connections are kept open for further requests
+    this->server->keepAlive(true);
     this->server->begin();
     this->debugController->printLn("Server started");
 }
@@ -84,7 +99,28 @@ void WebServer::findMDNS() {
  * @brief Handle clients of webserver
  */
 void WebServer::handleClient() {
+    // Also called while waiting for printer responses, never nested
+    if (this->isHandlingClient) {
+        return;
+    }
+    this->isHandlingClient = true;
     this->server->handleClient();
+    this->events->handle();
+    this->isHandlingClient = false;
+
+    // Only one connection is served at a time, close it when idle for too long or
+    // another client is waiting (event streams stay open)
+    WiFiClient client = this->server->client();
+    if (client.connected() && (client.available() == 0) && !this->events->isStream(client)) {
+        if (this->clientIdleSince == 0) {
+            this->clientIdleSince = millis();
+        } else if (WebserverKeepAlive::shouldClose(millis() - this->clientIdleSince, this->server->getServer().hasClient())) {
+            client.stop();
+            this->clientIdleSince = 0;
+        }
+    } else {
+        this->clientIdleSince = 0;
+    }
 }
 
 /**
@@ -97,7 +133,51 @@ void WebServer::redirectTarget(String targetUri) {
     this->server->sendHeader("Pragma", "no-cache");
     this->server->sendHeader("Expires", "-1");
     this->server->send(302, "text/plain", "");
-    this->server->client().stop();
+}
+
+/**
+ * @brief Configuration must not change while a printer or weather request is running,
+ *        so the change is applied directly or kept until the request has finished
+ * @param action            Change to apply, must not access the request (copy the arguments)
+ */
+void WebServer::applyAfterSync(std::function<void()> action) {
+    if (!JsonRequestClient::isRequestRunning() && (this->deferredCount == 0)) {
+        action();
+        return;
+    }
+    if (this->deferredCount >= WEBSERVER_DEFERRED_MAX) {
+        this->globalDataController->getSystemSettings()->lastError = FPSTR(ERROR_MESSAGES_ERR4);
+        return;
+    }
+    this->deferredActions[this->deferredCount++] = action;
+    this->globalDataController->getSystemSettings()->lastOk = FPSTR(OK_MESSAGES_DEFERRED);
+}
+
+/**
+ * @brief Apply kept configuration changes in order, once no request is running anymore.
+ * Only called from the main loop, where no pointer to the printer list is held.
+ */
+void WebServer::handleDeferredActions() {
+    if (JsonRequestClient::isRequestRunning()) {
+        return;
+    }
+    for (uint8_t i=0; i<this->deferredCount; i++) {
+        this->deferredActions[i]();
+        this->deferredActions[i] = NULL;
+    }
+    this->deferredCount = 0;
+}
+
+/**
+ * @brief Runtime id of a printer, for changes that are applied later
+ * @param printerIdx        Index in the printer settings (as shown in the forms)
+ * @return uint32_t         Id or 0 if not found
+ */
+uint32_t WebServer::getPrinterId(int printerIdx) {
+    if ((printerIdx < 0) || (printerIdx >= this->globalDataController->getNumPrinters())) {
+        return 0;
+    }
+    return this->globalDataController->getPrinterSettings()[printerIdx].id;
 }
 
 /**
@@ -115,7 +195,13 @@ boolean WebServer::authentication() {
     SystemDataStruct *systemData = this->globalDataController->getSystemSettings();
     if (systemData->hasBasicAuth && (systemData->webserverUsername.length() >= 1 && systemData->webserverPassword.length() >= 1)
     ) {
-        return this->server->authenticate(systemData->webserverUsername.c_str(), systemData->webserverPassword.c_str());
+        // Expected header is only built again if the credentials have changed
+        if ((this->authUsername != systemData->webserverUsername) || (this->authPassword != systemData->webserverPassword)) {
+            this->authUsername = systemData->webserverUsername;
+            this->authPassword = systemData->webserverPassword;
+            this->authExpectedHeader = "Basic " + base64::encode(this->authUsername + ":" + this->authPassword, false);
+        }
+        return this->server->header("Authorization") == this->authExpectedHeader;
     } 
     return true; // Authentication not required
 }
@@ -124,9 +210,16 @@ boolean WebServer::authentication() {
  * @brief Send main page to client
  */
 void WebServer::handleMainPage() {
-    WebserverMemoryVariables::sendHeader(this->server, this->globalDataController, "Status", "Monitor", true);
-    WebserverMemoryVariables::sendMainPage(this->server, this->globalDataController);
-    WebserverMemoryVariables::sendFooter(this->server, this->globalDataController);
+#if WEBSERVER_SPA
+    // Rendered by the browser, the legacy page is only used without filesystem image
+    if (WebserverAssets::isAvailable(WEBSERVER_ASSET_SPA_INDEX)) {
+        return WebserverAssets::send(this->server, WEBSERVER_ASSET_SPA_INDEX);
+    }
+#endif
+    WebserverResponseWriter writer(this->server);
+    WebserverMemoryVariables::sendHeader(&writer, this->globalDataController, "Status", "Monitor");
+    WebserverMemoryVariables::sendMainPage(&writer, this->globalDataController);
+    WebserverMemoryVariables::sendFooter(&writer, this->globalDataController);
 }
 
 /**
@@ -136,9 +229,10 @@ void WebServer::handleConfigureSensor() {
     if (!this->authentication()) {
         return this->server->requestAuthentication();
     }
-    WebserverMemoryVariables::sendHeader(this->server, this->globalDataController, "Configure", "Sensor");
-    WebserverMemoryVariables::sendSensorConfigForm(this->server, this->globalDataController);
-    WebserverMemoryVariables::sendFooter(this->server, this->globalDataController);
+    WebserverResponseWriter writer(this->server);
+    WebserverMemoryVariables::sendHeader(&writer, this->globalDataController, "Configure", "Sensor");
+    WebserverMemoryVariables::sendSensorConfigForm(&writer, this->globalDataController);
+    WebserverMemoryVariables::sendFooter(&writer, this->globalDataController);
 }
 
 /**
@@ -148,14 +242,18 @@ void WebServer::handleUpdateSensor() {
     if (!this->authentication()) {
         return this->server->requestAuthentication();
     }
-    SensorDataStruct *sensorSettings = this->globalDataController->getSensorSettings();
-
-    sensorSettings->activated = this->server->hasArg("isSensor");
-    sensorSettings->showOnDisplay = this->server->hasArg("isShowDisplay");
-    sensorSettings->sensType = this->server->arg("s-type").toInt();
-    this->globalDataController->writeSettings();
-
-    this->globalDataController->getSystemSettings()->lastOk = FPSTR(OK_MESSAGES_SAVE4);
+    bool activated = this->server->hasArg("isSensor");
+    bool showOnDisplay = this->server->hasArg("isShowDisplay");
+    int sensType = this->server->arg("s-type").toInt();
+
+    this->applyAfterSync([this, activated, showOnDisplay, sensType]() {
+        SensorDataStruct *sensorSettings = this->globalDataController->getSensorSettings();
+        sensorSettings->activated = activated;
+        sensorSettings->showOnDisplay = showOnDisplay;
+        sensorSettings->sensType = sensType;
+        this->globalDataController->writeSettings(SETTINGS_SECTION_BASIC);
+        this->globalDataController->getSystemSettings()->lastOk = FPSTR(OK_MESSAGES_SAVE4);
+    });
     this->redirectHome();
 }
 
@@ -166,9 +264,21 @@ void WebServer::handleConfigurePrinter() {
     if (!this->authentication()) {
         return this->server->requestAuthentication();
     }
-    WebserverMemoryVariables::sendHeader(this->server, this->globalDataController, "Configure", "Printers");
-    WebserverMemoryVariables::sendPrinterConfigForm(this->server, this->globalDataController);
-    WebserverMemoryVariables::sendFooter(this->server, this->globalDataController);
+    WebserverResponseWriter writer(this->server);
+    WebserverMemoryVariables::sendHeader(&writer, this->globalDataController, "Configure", "Printers");
+    WebserverMemoryVariables::sendPrinterConfigForm(&writer, this->globalDataController);
+    WebserverMemoryVariables::sendFooter(&writer, this->globalDataController);
+}
+
+/**
+ * @brief Send configuration of a single printer as json for the edit modal
+ */
+void WebServer::handlePrinterConfigData() {
+    if (!this->authentication()) {
+        return this->server->requestAuthentication();
+    }
+    WebserverResponseWriter writer(this->server);
+    WebserverApi::sendPrinterConfig(&writer, this->globalDataController, this->server->arg("id").toInt());
 }
 
 /**
@@ -180,45 +290,55 @@ void WebServer::handleUpdatePrinter() {
         return this->server->requestAuthentication();
     }
 
-    PrinterDataStruct *targetPrinter = NULL;
-    int targetPrinterId = this->server->arg("id").toInt() - 1;
-    if (targetPrinterId >= 0) {
-        PrinterDataStruct *existPrinters = this->globalDataController->getPrinterSettings();
-        for(int i=0; i<this->globalDataController->getNumPrinters(); i++) {
-            if (i == targetPrinterId) {
-                targetPrinter = &(existPrinters[i]);
-                break;
+    // Printer data may be reallocated, so all arguments are copied for a later update.
+    // The printer is kept by its id, the index can change when an earlier change removes a printer.
+    int targetPrinterIdx = this->server->arg("id").toInt() - 1;
+    uint32_t targetPrinterId = this->getPrinterId(targetPrinterIdx);
+    String customName = this->server->arg("e-tname");
+    int apiType = this->server->arg("e-tapi").toInt();
+    String apiKey = this->server->arg("e-tapikey");
+    String remoteAddress = this->server->arg("e-taddr");
+    int remotePort = this->server->arg("e-tport").toInt();
+    bool hasPsuControl = this->server->hasArg("e-tpsu");
+    bool basicAuthNeeded = this->server->hasArg("e-tapipw");
+    String basicAuthUsername = this->server->arg("e-tapiuser");
+    String basicAuthPassword = this->server->arg("e-tapipass");
+
+    this->applyAfterSync([=]() {
+        PrinterDataStruct *targetPrinter = NULL;
+        if (targetPrinterIdx >= 0) {
+            int currentIdx = this->globalDataController->getPrinterIdxById(targetPrinterId);
+            if (currentIdx >= 0) {
+                targetPrinter = &(this->globalDataController->getPrinterSettings()[currentIdx]);
             }
+        } else {
+            targetPrinter = this->globalDataController->addPrinterSetting();
         }
-    } else {
-        targetPrinter = this->globalDataController->addPrinterSetting();
-    }
-    if (targetPrinter == NULL) {
-        this->globalDataController->getSystemSettings()->lastError = FPSTR(ERROR_MESSAGES_ERR1);
-        this->redirectTarget("/configureprinter/show");
-        return;
-    }
-    this->globalDataController->getSystemSettings()->lastError = "";
-
-    // Set data
-    MemoryHelper::stringToChar(this->server->arg("e-tname"), targetPrinter->customName, 20);
-    targetPrinter->apiType = this->server->arg("e-tapi").toInt();
-    MemoryHelper::stringToChar(this->server->arg("e-tapikey"), targetPrinter->apiKey, 60);
-    MemoryHelper::stringToChar(this->server->arg("e-taddr"), targetPrinter->remoteAddress, 60);
-    targetPrinter->remotePort = this->server->arg("e-tport").toInt();
-    targetPrinter->hasPsuControl = this->server->hasArg("e-tpsu");
-    targetPrinter->basicAuthNeeded = this->server->hasArg("e-tapipw");
-    MemoryHelper::stringToChar(this->server->arg("e-tapiuser"), targetPrinter->basicAuthUsername, 30);
-    MemoryHelper::stringToChar(this->server->arg("e-tapipass"), targetPrinter->basicAuthPassword, 60);
-
-    // Reset error data
-    MemoryHelper::stringToChar("", targetPrinter->error, 120);
-    targetPrinter->state = PRINTER_STATE_OFFLINE;
-
-    // Save
-    this->globalDataController->getSystemSettings()->lastOk = FPSTR(OK_MESSAGES_SAVE1);
-    this->globalDataController->writeSettings();
-    this->globalDataController->getDisplayClient()->postSetup(true);
+        if (targetPrinter == NULL) {
+            this->globalDataController->getSystemSettings()->lastError = FPSTR(ERROR_MESSAGES_ERR1);
+            return;
+        }
+        this->globalDataController->getSystemSettings()->lastError = "";
+
+        // Set data
+        MemoryHelper::stringToChar(customName, targetPrinter->customName, 20);
+        targetPrinter->apiType = apiType;
+        MemoryHelper::stringToChar(apiKey, targetPrinter->apiKey, 60);
+        MemoryHelper::stringToChar(remoteAddress, targetPrinter->remoteAddress, 60);
+        targetPrinter->remotePort = remotePort;
+        targetPrinter->hasPsuControl = hasPsuControl;
+        targetPrinter->basicAuthNeeded = basicAuthNeeded;
+        MemoryHelper::stringToChar(basicAuthUsername, targetPrinter->basicAuthUsername, 30);
+        MemoryHelper::stringToChar(basicAuthPassword, targetPrinter->basicAuthPassword, 60);
+
+        // Reset live data, only for the changed printer
+        BasePrinterClient::resetPrinterData(targetPrinter);
+
+        // Save
+        this->globalDataController->getSystemSettings()->lastOk = FPSTR(OK_MESSAGES_SAVE1);
+        this->globalDataController->writeSettings(SETTINGS_SECTION_PRINTERS);
+        this->globalDataController->getDisplayClient()->postSetup(true);
+    });
     this->redirectTarget("/configureprinter/show");
 }
 
@@ -226,15 +346,18 @@ void WebServer::handleUpdatePrinter() {
  * @brief Delete single configuration for Printer
  */
 void WebServer::handleDeletePrinter() {
-    int targetPrinterId = this->server->arg("id").toInt() - 1;
-    if (this->globalDataController->removePrinterSettingByIdx(targetPrinterId)) {
-        this->globalDataController->getSystemSettings()->lastOk = FPSTR(OK_MESSAGES_DELETEPRINTER);
-        this->globalDataController->getSystemSettings()->lastError = "";
-        this->globalDataController->writeSettings();
-        this->globalDataController->getDisplayClient()->postSetup(true);
-    } else {
-        this->globalDataController->getSystemSettings()->lastError = FPSTR(ERROR_MESSAGES_ERR2);
-    }    
+    uint32_t targetPrinterId = this->getPrinterId(this->server->arg("id").toInt() - 1);
+    this->applyAfterSync([this, targetPrinterId]() {
+        int currentIdx = this->globalDataController->getPrinterIdxById(targetPrinterId);
+        if (this->globalDataController->removePrinterSettingByIdx(currentIdx)) {
+            this->globalDataController->getSystemSettings()->lastOk = FPSTR(OK_MESSAGES_DELETEPRINTER);
+            this->globalDataController->getSystemSettings()->lastError = "";
+            this->globalDataController->writeSettings(SETTINGS_SECTION_PRINTERS);
+            this->globalDataController->getDisplayClient()->postSetup(true);
+        } else {
+            this->globalDataController->getSystemSettings()->lastError = FPSTR(ERROR_MESSAGES_ERR2);
+        }
+    });
     this->redirectTarget("/configureprinter/show");
 }
 
@@ -245,9 +368,10 @@ void WebServer::handleConfigureStation() {
     if (!this->authentication()) {
         return this->server->requestAuthentication();
     }
-    WebserverMemoryVariables::sendHeader(this->server, this->globalDataController, "Configure", "Station");
-    WebserverMemoryVariables::sendStationConfigForm(this->server, this->globalDataController);
-    WebserverMemoryVariables::sendFooter(this->server, this->globalDataController);
+    WebserverResponseWriter writer(this->server);
+    WebserverMemoryVariables::sendHeader(&writer, this->globalDataController, "Configure", "Station");
+    WebserverMemoryVariables::sendStationConfigForm(&writer, this->globalDataController);
+    WebserverMemoryVariables::sendFooter(&writer, this->globalDataController);
 }
 
 /**
@@ -258,26 +382,37 @@ void WebServer::handleUpdateStation() {
     if (!this->authentication()) {
         return this->server->requestAuthentication();
     }
-    SystemDataStruct *systemSettings = this->globalDataController->getSystemSettings();
-    ClockDataStruct *clockSettings = this->globalDataController->getClockSettings();
-
-    clockSettings->show = this->server->hasArg("isClockEnabled");
-    clockSettings->is24h = this->server->hasArg("is24hour");
+    bool show = this->server->hasArg("isClockEnabled");
+    bool is24h = this->server->hasArg("is24hour");
     String utcDataOffset = this->server->arg("utcoffset");
-    clockSettings->utcOffset = utcDataOffset.substring(0, utcDataOffset.indexOf("|")).toInt();
-    clockSettings->timezoneHash = utcDataOffset.substring(utcDataOffset.indexOf("|") + 1);
-    systemSettings->clockWeatherResyncMinutes = this->server->arg("refresh").toInt();
-    systemSettings->hasBasicAuth = this->server->hasArg("isBasicAuth");
-    systemSettings->useLedFlash = this->server->hasArg("useFlash");
-    systemSettings->webserverPassword = this->server->arg("stationpassword");
-    systemSettings->webserverUsername = this->server->arg("userid");
-    this->globalDataController->writeSettings();
-    this->globalDataController->getTimeClient()->setUtcOffset(clockSettings->utcOffset);
-    this->globalDataController->getTimeClient()->resetLastEpoch();
-    this->globalDataController->getDisplayClient()->postSetup(true);
-    this->findMDNS();
-    
-    this->globalDataController->getSystemSettings()->lastOk = FPSTR(OK_MESSAGES_SAVE3);
+    int refresh = this->server->arg("refresh").toInt();
+    bool hasBasicAuth = this->server->hasArg("isBasicAuth");
+    bool useLedFlash = this->server->hasArg("useFlash");
+    String webserverPassword = this->server->arg("stationpassword");
+    String webserverUsername = this->server->arg("userid");
+
+    this->applyAfterSync([=]() {
+        SystemDataStruct *systemSettings = this->globalDataController->getSystemSettings();
+        ClockDataStruct *clockSettings = this->globalDataController->getClockSettings();
+
+        clockSettings->show = show;
+        clockSettings->is24h = is24h;
+        clockSettings->utcOffset = utcDataOffset.substring(0, utcDataOffset.indexOf("|")).toInt();
+        clockSettings->timezoneHash = utcDataOffset.substring(utcDataOffset.indexOf("|") + 1);
+        systemSettings->clockWeatherResyncMinutes = refresh;
+        systemSettings->hasBasicAuth = hasBasicAuth;
+        systemSettings->useLedFlash = useLedFlash;
+        systemSettings->webserverPassword = webserverPassword;
+        systemSettings->webserverUsername = webserverUsername;
+        this->globalDataController->writeSettings(SETTINGS_SECTION_BASIC);
+        this->globalDataController->getTimeClient()->setUtcOffset(clockSettings->utcOffset);
+        this->globalDataController->getTimeClient()->resetLastEpoch();
+        this->globalDataController->resetWeatherSync();
+        this->globalDataController->getDisplayClient()->postSetup(true);
+        this->findMDNS();
+
+        this->globalDataController->getSystemSettings()->lastOk = FPSTR(OK_MESSAGES_SAVE3);
+    });
     this->redirectHome();
 }
 
@@ -288,9 +423,10 @@ void WebServer::handleConfigureWeather() {
     if (!this->authentication()) {
         return this->server->requestAuthentication();
     }
-    WebserverMemoryVariables::sendHeader(this->server, this->globalDataController, "Configure", "Weather");
-    WebserverMemoryVariables::sendWeatherConfigForm(this->server, this->globalDataController);
-    WebserverMemoryVariables::sendFooter(this->server, this->globalDataController);
+    WebserverResponseWriter writer(this->server);
+    WebserverMemoryVariables::sendHeader(&writer, this->globalDataController, "Configure", "Weather");
+    WebserverMemoryVariables::sendWeatherConfigForm(&writer, this->globalDataController);
+    WebserverMemoryVariables::sendFooter(&writer, this->globalDataController);
 }
 
 /**
@@ -300,19 +436,28 @@ void WebServer::handleUpdateWeather() {
     if (!this->authentication()) {
         return this->server->requestAuthentication();
     }
-    WeatherDataStruct *weatherSettings = this->globalDataController->getWeatherSettings();
-
-    weatherSettings->show = this->server->hasArg("isWeatherEnabled");
-    weatherSettings->apiKey = this->server->arg("openWeatherMapApiKey");
-    weatherSettings->cityId = this->server->arg("city1").toInt();
-    weatherSettings->isMetric = this->server->hasArg("metric");
-    weatherSettings->lang = this->server->arg("language");
-    this->globalDataController->writeSettings();
-    this->globalDataController->getWeatherClient()->updateWeatherApiKey(weatherSettings->apiKey);
-    this->globalDataController->getWeatherClient()->updateLanguage(weatherSettings->lang);
-    this->globalDataController->getWeatherClient()->setMetric(weatherSettings->isMetric);
-    this->globalDataController->getWeatherClient()->updateCityId(weatherSettings->cityId);
-    this->globalDataController->getSystemSettings()->lastOk = FPSTR(OK_MESSAGES_SAVE2);
+    bool show = this->server->hasArg("isWeatherEnabled");
+    String apiKey = this->server->arg("openWeatherMapApiKey");
+    int cityId = this->server->arg("city1").toInt();
+    bool isMetric = this->server->hasArg("metric");
+    String lang = this->server->arg("language");
+
+    this->applyAfterSync([=]() {
+        WeatherDataStruct *weatherSettings = this->globalDataController->getWeatherSettings();
+
+        weatherSettings->show = show;
+        weatherSettings->apiKey = apiKey;
+        weatherSettings->cityId = cityId;
+        weatherSettings->isMetric = isMetric;
+        weatherSettings->lang = lang;
+        this->globalDataController->writeSettings(SETTINGS_SECTION_BASIC);
+        this->globalDataController->getWeatherClient()->updateWeatherApiKey(weatherSettings->apiKey);
+        this->globalDataController->getWeatherClient()->updateLanguage(weatherSettings->lang);
+        this->globalDataController->getWeatherClient()->setMetric(weatherSettings->isMetric);
+        this->globalDataController->getWeatherClient()->updateCityId(weatherSettings->cityId);
+        this->globalDataController->resetWeatherSync();
+        this->globalDataController->getSystemSettings()->lastOk = FPSTR(OK_MESSAGES_SAVE2);
+    });
     this->redirectHome();
 }
 
@@ -323,9 +468,10 @@ void WebServer::handleConfigureDisplay() {
     if (!this->authentication()) {
         return this->server->requestAuthentication();
     }
-    WebserverMemoryVariables::sendHeader(this->server, this->globalDataController, "Configure", "Display");
-    WebserverMemoryVariables::sendDisplayConfigForm(this->server, this->globalDataController);
-    WebserverMemoryVariables::sendFooter(this->server, this->globalDataController);
+    WebserverResponseWriter writer(this->server);
+    WebserverMemoryVariables::sendHeader(&writer, this->globalDataController, "Configure", "Display");
+    WebserverMemoryVariables::sendDisplayConfigForm(&writer, this->globalDataController);
+    WebserverMemoryVariables::sendFooter(&writer, this->globalDataController);
 }
 
 /**
@@ -335,31 +481,40 @@ void WebServer::handleUpdateDisplay() {
     if (!this->authentication()) {
         return this->server->requestAuthentication();
     }
+    int displayType = this->server->arg("d-type").toInt();
+    bool invertDisplay = this->server->hasArg("invDisp");
+    bool showWeatherSensorSplited = this->server->hasArg("splitWeather");
+    bool automaticSwitchEnabled = this->server->hasArg("automaticSwitchEnable");
+    bool automaticSwitchActiveOnlyEnabled = this->server->hasArg("automaticSwitchActivEnable");
+    int automaticSwitchDelay = this->server->arg("automaticSwitchDelay").toInt() * 1000;
+    int automaticInactiveOff = this->server->arg("automaticOff").toInt();
+
+    this->applyAfterSync([=]() {
+        DisplayDataStruct *displaySettings = this->globalDataController->getDisplaySettings();
+        boolean flipOld = displaySettings->invertDisplay;
+
+        int oldType = displaySettings->displayType;
+        displaySettings->displayType = displayType;
+        displaySettings->invertDisplay = invertDisplay;
+        displaySettings->showWeatherSensorSplited = showWeatherSensorSplited;
+        displaySettings->automaticSwitchEnabled = automaticSwitchEnabled;
+        displaySettings->automaticSwitchActiveOnlyEnabled = automaticSwitchActiveOnlyEnabled;
+        displaySettings->automaticSwitchDelay = automaticSwitchDelay;
+        displaySettings->automaticInactiveOff = automaticInactiveOff;
+        this->globalDataController->writeSettings(SETTINGS_SECTION_BASIC);
+
+        if (displaySettings->invertDisplay != flipOld) {
+            this->globalDataController->getDisplayClient()->flipDisplayUpdate();
+        }
 
-    DisplayDataStruct *displaySettings = this->globalDataController->getDisplaySettings();
-    boolean flipOld = displaySettings->invertDisplay;
-
-    int oldType = displaySettings->displayType;
-    displaySettings->displayType = this->server->arg("d-type").toInt();
-    displaySettings->invertDisplay = this->server->hasArg("invDisp");
-    displaySettings->showWeatherSensorSplited = this->server->hasArg("splitWeather");
-    displaySettings->automaticSwitchEnabled = this->server->hasArg("automaticSwitchEnable");
-    displaySettings->automaticSwitchActiveOnlyEnabled = this->server->hasArg("automaticSwitchActivEnable");
-    displaySettings->automaticSwitchDelay = this->server->arg("automaticSwitchDelay").toInt() * 1000;
-    displaySettings->automaticInactiveOff = this->server->arg("automaticOff").toInt();
-    this->globalDataController->writeSettings();
-
-    if (displaySettings->invertDisplay != flipOld) {
-        this->globalDataController->getDisplayClient()->flipDisplayUpdate();
-    }
-    
-    if (oldType == displaySettings->displayType) {
-        this->globalDataController->getDisplayClient()->postSetup(true);
-        this->globalDataController->getSystemSettings()->lastOk = FPSTR(OK_MESSAGES_SAVE5);
-    } else {
-        this->globalDataController->reinitDisplay();
-        this->globalDataController->getSystemSettings()->lastOk = FPSTR(OK_MESSAGES_SAVE6);
-    }
+        if (oldType == displaySettings->displayType) {
+            this->globalDataController->getDisplayClient()->postSetup(true);
+            this->globalDataController->getSystemSettings()->lastOk = FPSTR(OK_MESSAGES_SAVE5);
+        } else {
+            this->globalDataController->reinitDisplay();
+            this->globalDataController->getSystemSettings()->lastOk = FPSTR(OK_MESSAGES_SAVE6);
+        }
+    });
     this->redirectHome();
 }
 
@@ -370,11 +525,13 @@ void WebServer::handleSystemReset() {
     if (!this->authentication()) {
         return this->server->requestAuthentication();
     }
-    this->debugController->printLn("Reset System Configuration");
-    if (this->globalDataController->resetConfig()) {
-        redirectHome();
-        ESP.restart();
-    }
+    redirectHome();
+    this->applyAfterSync([this]() {
+        this->debugController->printLn("Reset System Configuration");
+        if (this->globalDataController->resetConfig()) {
+            ESP.restart();
+        }
+    });
 }
 
 /**
@@ -384,12 +541,14 @@ void WebServer::handleWifiReset() {
     if (!this->authentication()) {
         return this->server->requestAuthentication();
     }
-    //WiFiManager
-    //Local intialization. Once its business is done, there is no need to keep it around
     redirectHome();
-    WiFiManager wifiManager;
-    wifiManager.resetSettings();
-    ESP.restart();
+    this->applyAfterSync([]() {
+        //WiFiManager
+        //Local intialization. Once its business is done, there is no need to keep it around
+        WiFiManager wifiManager;
+        wifiManager.resetSettings();
+        ESP.restart();
+    });
 }
 
 /**
@@ -399,7 +558,141 @@ void WebServer::handleUpdatePage() {
     if (!this->authentication()) {
         return this->server->requestAuthentication();
     }
-    WebserverMemoryVariables::sendHeader(this->server, this->globalDataController, "Firmware", "Update");
-    WebserverMemoryVariables::sendUpdateForm(this->server, this->globalDataController);
-    WebserverMemoryVariables::sendFooter(this->server, this->globalDataController);
+    WebserverResponseWriter writer(this->server);
+    WebserverMemoryVariables::sendHeader(&writer, this->globalDataController, "Firmware", "Update");
+    WebserverMemoryVariables::sendUpdateForm(&writer, this->globalDataController);
+    WebserverMemoryVariables::sendFooter(&writer, this->globalDataController);
+}
+
+/**
+ * @brief Send all settings as text file, e.g. to restore them after a filesystem image upload
+ */
+void WebServer::handleSettingsBackup() {
+    if (!this->authentication()) {
+        return this->server->requestAuthentication();
+    }
+    WebserverResponseWriter writer(this->server);
+    this->server->sendHeader("Content-Disposition", "attachment; filename=\"printbuddy-settings.txt\"");
+    writer.begin(200, "text/plain");
+    this->globalDataController->sendSettingsBackup(&writer);
+    writer.end();
+}
+
+/**
+ * @brief Store the uploaded settings backup in a temporary file
+ */
+void WebServer::handleSettingsRestoreUpload() {
+    HTTPUpload &upload = this->server->upload();
+    if (upload.status == UPLOAD_FILE_START) {
+        this->restoreFile = this->authentication() ? LittleFS.open(SETTINGS_RESTORE_FILE, "w") : File();
+    } else if ((upload.status == UPLOAD_FILE_WRITE) && this->restoreFile) {
+        if ((this->restoreFile.size() + upload.currentSize) > SETTINGS_RESTORE_MAX_SIZE) {
+            this->restoreFile.close();
+            LittleFS.remove(SETTINGS_RESTORE_FILE);
+        } else {
+            this->restoreFile.write(upload.buf, upload.currentSize);
+        }
+    } else if ((upload.status == UPLOAD_FILE_END) || (upload.status == UPLOAD_FILE_ABORTED)) {
+        if (this->restoreFile) {
+            this->restoreFile.close();
+        }
+        if (upload.status == UPLOAD_FILE_ABORTED) {
+            LittleFS.remove(SETTINGS_RESTORE_FILE);
+        }
+    }
+}
+
+/**
+ * @brief Import the uploaded settings backup and reboot to apply it
+ */
+void WebServer::handleSettingsRestore() {
+    if (!this->authentication()) {
+        return this->server->requestAuthentication();
+    }
+    this->redirectHome();
+    this->applyAfterSync([this]() {
+        if (!this->globalDataController->restoreSettings(SETTINGS_RESTORE_FILE)) {
+            this->globalDataController->getSystemSettings()->lastError = FPSTR(ERROR_MESSAGES_ERR3);
+            return;
+        }
+        this->debugController->printLn("Settings restored, restarting");
+        ESP.restart();
+    });
+}
+
+/**
+ * @brief Send the frame buffer of the display as image (binary PBM)
+ */
+void WebServer::handleDisplayFrame() {
+    if (!this->authentication()) {
+        return this->server->requestAuthentication();
+    }
+    BaseDisplayClient *displayClient = this->globalDataController->getDisplayClient();
+    size_t dumpSize = displayClient->getFrameBufferDumpSize();
+    if (dumpSize == 0) {
+        this->server->send(404, "text/plain", "Display has no frame buffer");
+        return;
+    }
+    this->server->sendHeader("Cache-Control", "no-cache, no-store");
+    this->server->setContentLength(dumpSize);
+    this->server->send(200, "image/x-portable-bitmap", "");
+    WiFiClient client = this->server->client();
+    displayClient->sendFrameBuffer(&client);
+}
+
+/**
+ * @brief Send state of all printers as json
+ */
+void WebServer::handleApiPrinters() {
+    WebserverResponseWriter writer(this->server);
+    WebserverApi::sendPrinters(&writer, this->globalDataController);
+}
+
+/**
+ * @brief Send sensor data as json
+ */
+void WebServer::handleApiSensor() {
+    WebserverResponseWriter writer(this->server);
+    WebserverApi::sendSensor(&writer, this->globalDataController);
+}
+
+/**
+ * @brief Send current weather as json
+ */
+void WebServer::handleApiWeather() {
+    WebserverResponseWriter writer(this->server);
+    WebserverApi::sendWeather(&writer, this->globalDataController);
+}
+
+/**
+ * @brief Send system state as json
+ */
+void WebServer::handleApiSystem() {
+    WebserverResponseWriter writer(this->server);
+    WebserverApi::sendSystem(&writer, this->globalDataController);
+}
+
+/**
+ * @brief Send state of printers, sensor and weather as json, only changes when called with ?since=<version>
+ */
+void WebServer::handleApiState() {
+    WebserverResponseWriter writer(this->server);
+    WebserverApi::sendState(&writer, this->globalDataController, this->server->arg("since"));
+}
+
+/**
+ * @brief Send supported printer apis as json
+ */
+void WebServer::handleApiPrinterClients() {
+    WebserverResponseWriter writer(this->server);
+    WebserverApi::sendPrinterClients(&writer, this->globalDataController);
+}
+
+/**
+ * @brief Open event stream with changes of printer, sensor and weather data
+ */
+void WebServer::handleEvents() {
+    if (!this->events->addClient(this->server->client())) {
+        this->server->send(503, "text/plain", "Too many event streams");
+    }
 }
@@ -4,16 +4,33 @@
 #include <ESP8266HTTPUpdateServer.h>
 #include <WiFiManager.h>
 #include <ESP8266mDNS.h>
+#include <base64.h>
 #include "../Global/GlobalDataController.h"
 #include "WebserverMemoryVariables.h"
+#include "WebserverApi.h"
+#include "WebserverEvents.h"
+#include "WebserverKeepAlive.h"
+#include "JsonRequestClient.h"
 #include "../../include/MemoryHelper.h"
 
+// Configuration changes that are kept until the running printer or weather request has finished
+#define WEBSERVER_DEFERRED_MAX              4
+
 class WebServer {
 private:
     GlobalDataController *globalDataController;
     ESP8266WebServer *server;
     ESP8266HTTPUpdateServer *serverUpdater;
+    WebserverEvents *events;
     DebugController *debugController;
+    unsigned long clientIdleSince = 0;
+    bool isHandlingClient = false;
+    std::function<void()> deferredActions[WEBSERVER_DEFERRED_MAX];
+    uint8_t deferredCount = 0;
+    File restoreFile;
+    String authUsername = "";
+    String authPassword = "";
+    String authExpectedHeader = "";
 
 public:
     WebServer(GlobalDataController *globalDataController, DebugController *debugController);
@@ -24,11 +41,15 @@ public:
     boolean authentication();
     void redirectHome();
     void redirectTarget(String targetUri);
+    void applyAfterSync(std::function<void()> action);
+    void handleDeferredActions();
+    uint32_t getPrinterId(int printerIdx);
     void handleSystemReset();
     void handleWifiReset(); 
     
     void handleMainPage();
     void handleConfigurePrinter();
+    void handlePrinterConfigData();
     void handleUpdatePrinter();
     void handleDeletePrinter();
     void handleConfigureStation();
@@ -40,4 +61,16 @@ public:
     void handleConfigureDisplay();
     void handleUpdateDisplay();
     void handleUpdatePage();
+    void handleSettingsBackup();
+    void handleSettingsRestore();
+    void handleSettingsRestoreUpload();
+    void handleDisplayFrame();
+
+    void handleApiPrinters();
+    void handleApiSensor();
+    void handleApiWeather();
+    void handleApiSystem();
+    void handleApiState();
+    void handleApiPrinterClients();
+    void handleEvents();
 };
@@ -0,0 +1,340 @@
+#include "WebserverApi.h"
+
+/**
+ * @brief Send all configured printers as json array
+ * @param writer                    Send out instance
+ * @param globalDataController      Access to global data
+ */
+void WebserverApi::sendPrinters(WebserverResponseWriter *writer, GlobalDataController *globalDataController) {
+    DynamicJsonDocument jsonDoc(WEBSERVER_API_JSON_SIZE);
+    PrinterDataStruct *printers = globalDataController->getPrinterSettings();
+
+    writer->begin(200, "application/json");
+    writer->print('[');
+    for (int i = 0; i < globalDataController->getNumPrinters(); i++) {
+        if (i > 0) {
+            writer->print(',');
+        }
+        jsonDoc.clear();
+        WebserverApi::fillPrinter(jsonDoc.to<JsonObject>(), i + 1, &printers[i], globalDataController);
+        serializeJson(jsonDoc, *writer);
+    }
+    writer->print(']');
+    writer->end();
+}
+
+/**
+ * @brief Send internal sensor data as json
+ * @param writer                    Send out instance
+ * @param globalDataController      Access to global data
+ */
+void WebserverApi::sendSensor(WebserverResponseWriter *writer, GlobalDataController *globalDataController) {
+    DynamicJsonDocument jsonDoc(WEBSERVER_API_JSON_SIZE);
+    WebserverApi::fillSensor(jsonDoc.to<JsonObject>(), globalDataController->getSensorSettings(), globalDataController);
+    WebserverApi::sendDocument(writer, &jsonDoc);
+}
+
+/**
+ * @brief Send current weather as json
+ * @param writer                    Send out instance
+ * @param globalDataController      Access to global data
+ */
+void WebserverApi::sendWeather(WebserverResponseWriter *writer, GlobalDataController *globalDataController) {
+    DynamicJsonDocument jsonDoc(WEBSERVER_API_JSON_SIZE);
+    WebserverApi::fillWeather(jsonDoc.to<JsonObject>(), globalDataController);
+    WebserverApi::sendDocument(writer, &jsonDoc);
+}
+
+/**
+ * @brief Send system state as json
+ * @param writer                    Send out instance
+ * @param globalDataController      Access to global data
+ */
+void WebserverApi::sendSystem(WebserverResponseWriter *writer, GlobalDataController *globalDataController) {
+    DynamicJsonDocument jsonDoc(WEBSERVER_API_JSON_SIZE);
+    WebserverApi::fillSystem(jsonDoc.to<JsonObject>(), globalDataController);
+    WebserverApi::sendDocument(writer, &jsonDoc);
+}
+
+/**
+ * @brief Send state of printers, sensor and weather, as delta only the parts changed since the given version
+ * The version is sent as "<boot id>-<version>" (boot id in hex), the current one is always in header X-State-Version.
+ * Unchanged state is answered with 304 and an empty body. A version of another boot (or a newer one) is answered
+ * with the complete state, as the versions restart with every boot.
+ * @param writer                    Send out instance
+ * @param globalDataController      Access to global data
+ * @param sinceToken                Last version known by the client, empty for the complete state
+ */
+void WebserverApi::sendState(WebserverResponseWriter *writer, GlobalDataController *globalDataController, String sinceToken) {
+    uint32_t stateVersion = globalDataController->getStateVersion();
+    String stateToken = String(globalDataController->getStateBootId(), HEX) + "-" + String(stateVersion);
+    int separatorPos = sinceToken.indexOf('-');
+    bool isDelta = (separatorPos > 0)
+        && (strtoul(sinceToken.substring(0, separatorPos).c_str(), NULL, 16) == globalDataController->getStateBootId());
+    uint32_t sinceVersion = isDelta ? strtoul(sinceToken.substring(separatorPos + 1).c_str(), NULL, 10) : 0;
+    if (isDelta && (sinceVersion > stateVersion)) {
+        isDelta = false;
+    }
+    writer->getServer()->sendHeader("X-State-Version", stateToken);
+    if (isDelta && (sinceVersion == stateVersion)) {
+        writer->begin(304, "application/json", 0);
+        writer->end();
+        return;
+    }
+
+    DynamicJsonDocument jsonDoc(WEBSERVER_API_JSON_SIZE);
+    PrinterDataStruct *printers = globalDataController->getPrinterSettings();
+    bool isFirst = true;
+
+    writer->begin(200, "application/json");
+    writer->print(F("{\"version\":\""));
+    writer->print(stateToken);
+    writer->print(F("\",\"delta\":"));
+    writer->print(isDelta ? F("true") : F("false"));
+    writer->print(F(",\"printerCount\":"));
+    writer->print(globalDataController->getNumPrinters());
+    writer->print(F(",\"printers\":["));
+    for (int i = 0; i < globalDataController->getNumPrinters(); i++) {
+        if (isDelta && (globalDataController->getPrinterStateVersion(i) <= sinceVersion)) {
+            continue;
+        }
+        if (!isFirst) {
+            writer->print(',');
+        }
+        isFirst = false;
+        jsonDoc.clear();
+        WebserverApi::fillPrinter(jsonDoc.to<JsonObject>(), i + 1, &printers[i], globalDataController);
+        serializeJson(jsonDoc, *writer);
+    }
+    writer->print(']');
+    if (!isDelta || (globalDataController->getSensorStateVersion() > sinceVersion)) {
+        jsonDoc.clear();
+        WebserverApi::fillSensor(jsonDoc.to<JsonObject>(), globalDataController->getSensorSettings(), globalDataController);
+        writer->print(F(",\"sensor\":"));
+        serializeJson(jsonDoc, *writer);
+    }
+    if (!isDelta || (globalDataController->getWeatherStateVersion() > sinceVersion)) {
+        jsonDoc.clear();
+        WebserverApi::fillWeather(jsonDoc.to<JsonObject>(), globalDataController);
+        writer->print(F(",\"weather\":"));
+        serializeJson(jsonDoc, *writer);
+    }
+    writer->print('}');
+    writer->end();
+}
+
+/**
+ * @brief Send all supported printer apis as json array (id is the apiType of a printer)
+ * @param writer                    Send out instance
+ * @param globalDataController      Access to global data
+ */
+void WebserverApi::sendPrinterClients(WebserverResponseWriter *writer, GlobalDataController *globalDataController) {
+    DynamicJsonDocument jsonDoc(WEBSERVER_API_JSON_SIZE);
+    JsonArray clients = jsonDoc.to<JsonArray>();
+    BasePrinterClient** printerInstances = globalDataController->getRegisteredPrinterClients();
+    for (int i = 0; i < globalDataController->getRegisteredPrinterClientsNum(); i++) {
+        if (printerInstances[i] != NULL) {
+            JsonObject client = clients.createNestedObject();
+            client["id"] = i;
+            client["type"] = printerInstances[i]->getClientType();
+            client["needApiKey"] = printerInstances[i]->clientNeedApiKey();
+        }
+    }
+    WebserverApi::sendDocument(writer, &jsonDoc);
+}
+
+/**
+ * @brief Send configuration of a single printer for the edit modal, including credentials.
+ * Only to be used behind authentication!
+ * @param writer                    Send out instance
+ * @param globalDataController      Access to global data
+ * @param id                        Id of printer (1...n)
+ */
+void WebserverApi::sendPrinterConfig(WebserverResponseWriter *writer, GlobalDataController *globalDataController, int id) {
+    if ((id < 1) || (id > globalDataController->getNumPrinters())) {
+        writer->begin(404, "application/json", 2);
+        writer->print(F("{}"));
+        writer->end();
+        return;
+    }
+
+    PrinterDataStruct *printer = &(globalDataController->getPrinterSettings()[id - 1]);
+    DynamicJsonDocument jsonDoc(WEBSERVER_API_JSON_SIZE);
+    jsonDoc["id"] = id;
+    jsonDoc["name"] = (const char *)printer->customName;
+    jsonDoc["apiType"] = printer->apiType;
+    jsonDoc["apiKey"] = (const char *)printer->apiKey;
+    jsonDoc["address"] = (const char *)printer->remoteAddress;
+    jsonDoc["port"] = printer->remotePort;
+    jsonDoc["basicAuth"] = printer->basicAuthNeeded;
+    jsonDoc["user"] = (const char *)printer->basicAuthUsername;
+    jsonDoc["password"] = (const char *)printer->basicAuthPassword;
+    WebserverApi::sendDocument(writer, &jsonDoc);
+}
+
+/**
+ * @brief Fill json object with printer data (credentials are never included)
+ * @param target                    Target object
+ * @param id                        Id of printer (1...n)
+ * @param printer                   Handle to printer data
+ * @param globalDataController      Access to global data
+ */
+void WebserverApi::fillPrinter(JsonObject target, int id, PrinterDataStruct *printer, GlobalDataController *globalDataController) {
+    target["id"] = id;
+    target["name"] = (const char *)printer->customName;
+    target["type"] = globalDataController->getPrinterClientType(printer);
+    target["state"] = printer->state;
+    target["stateText"] = ViewFormatter::getPrinterStateAsText(printer->state);
+    target["isPrinting"] = printer->isPrinting;
+    target["hasPsuControl"] = printer->hasPsuControl;
+    target["isPSUoff"] = printer->isPSUoff;
+    target["lastSyncEpoch"] = printer->lastSyncEpoch;
+    target["cachedEpoch"] = printer->cachedEpoch;
+    target["error"] = (const char *)printer->error;
+
+    JsonObject job = target.createNestedObject("job");
+    job["fileName"] = (const char *)printer->fileName;
+    job["fileSize"] = printer->fileSize;
+    job["completion"] = printer->progressCompletion;
+    job["filepos"] = printer->progressFilepos;
+    job["printTime"] = printer->progressPrintTime;
+    job["printTimeLeft"] = printer->progressPrintTimeLeft;
+    job["estimatedPrintTime"] = printer->estimatedPrintTime;
+    job["averagePrintTime"] = printer->averagePrintTime;
+    job["lastPrintTime"] = printer->lastPrintTime;
+    job["filamentLength"] = printer->filamentLength;
+
+    JsonObject temperature = target.createNestedObject("temperature");
+    temperature["tool"] = printer->toolTemp;
+    temperature["toolTarget"] = printer->toolTargetTemp;
+    temperature["bed"] = printer->bedTemp;
+    temperature["bedTarget"] = printer->bedTargetTemp;
+}
+
+/**
+ * @brief Fill json object with sensor data
+ * @param target                    Target object
+ * @param sensor                    Handle to sensor data
+ * @param globalDataController      Access to global data
+ */
+void WebserverApi::fillSensor(JsonObject target, SensorDataStruct *sensor, GlobalDataController *globalDataController) {
+    target["activated"] = sensor->activated;
+    target["type"] = globalDataController->getSensorClientType(sensor);
+    target["isRunning"] = sensor->sensorIsRuning;
+    target["lastSyncEpoch"] = sensor->lastSyncEpoch;
+    target["cachedEpoch"] = sensor->cachedEpoch;
+    target["error"] = (const char *)sensor->error;
+    target["temperature"] = sensor->temperature;
+    target["humidity"] = sensor->humidity;
+    target["pressure"] = sensor->pressure;
+    target["airQuality"] = sensor->airQuality;
+    target["gasResistance"] = sensor->gasResistance;
+    target["altitude"] = sensor->altitude;
+    target["sampleCount"] = sensor->sampleCount;
+    WebserverApi::fillSensorStats(target.createNestedObject("temperatureStats"), &sensor->temperatureStats);
+    WebserverApi::fillSensorStats(target.createNestedObject("humidityStats"), &sensor->humidityStats);
+    WebserverApi::fillSensorStats(target.createNestedObject("pressureStats"), &sensor->pressureStats);
+}
+
+/**
+ * @brief Fill json object with rolling min/max/avg of a sensor value
+ * @param target                    Target object
+ * @param stats                     Handle to statistic
+ */
+void WebserverApi::fillSensorStats(JsonObject target, SensorStatsDataStruct *stats) {
+    target["min"] = stats->min;
+    target["max"] = stats->max;
+    target["avg"] = stats->avg;
+}
+
+/**
+ * @brief Fill json object with current weather
+ * @param target                    Target object
+ * @param globalDataController      Access to global data
+ */
+void WebserverApi::fillWeather(JsonObject target, GlobalDataController *globalDataController) {
+    OpenWeatherMapClient *weatherClient = globalDataController->getWeatherClient();
+    WeatherDataStruct *weatherSettings = globalDataController->getWeatherSettings();
+
+    target["show"] = weatherSettings->show;
+    target["isMetric"] = weatherSettings->isMetric;
+    target["cityId"] = weatherSettings->cityId;
+
+    // Last known weather restored on boot, until the first weather sync
+    WarmStartWeatherDataStruct *cachedWeather = globalDataController->getCachedWeather();
+    if (cachedWeather != NULL) {
+        target["cachedEpoch"] = cachedWeather->syncEpoch;
+        target["error"] = "";
+        target["city"] = cachedWeather->city;
+        target["country"] = cachedWeather->country;
+        target["temperature"] = cachedWeather->temperature;
+        target["humidity"] = cachedWeather->humidity;
+        target["wind"] = cachedWeather->wind;
+        target["condition"] = cachedWeather->condition;
+        target["description"] = cachedWeather->description;
+        target["icon"] = cachedWeather->icon;
+        target["weatherId"] = cachedWeather->weatherId;
+        return;
+    }
+    target["cachedEpoch"] = 0;
+    target["error"] = weatherClient->getError();
+    target["city"] = weatherClient->getCity(0);
+    target["country"] = weatherClient->getCountry(0);
+    target["temperature"] = weatherClient->getTemp(0);
+    target["humidity"] = weatherClient->getHumidity(0);
+    target["wind"] = weatherClient->getWind(0);
+    target["condition"] = weatherClient->getCondition(0);
+    target["description"] = weatherClient->getDescription(0);
+    target["icon"] = weatherClient->getIcon(0);
+    target["weatherId"] = weatherClient->getWeatherId(0);
+}
+
+/**
+ * @brief Fill json object with system state
+ * @param target                    Target object
+ * @param globalDataController      Access to global data
+ */
+void WebserverApi::fillSystem(JsonObject target, GlobalDataController *globalDataController) {
+    uint32_t heapFree = 0;
+    uint16_t heapMax = 0;
+    uint8_t heapFrag = 0;
+    EspController::getHeap(&heapFree, &heapMax, &heapFrag);
+
+    target["version"] = globalDataController->getSystemSettings()->version;
+    target["uptime"] = millis() / 1000;
+    target["epoch"] = globalDataController->getTimeClient()->getCurrentEpoch();
+    target["wifiQuality"] = EspController::getWifiQuality();
+    target["chipId"] = ESP.getChipId();
+    target["coreVersion"] = ESP.getCoreVersion();
+    target["printersPrinting"] = globalDataController->numPrintersPrinting();
+
+    JsonObject boot = target.createNestedObject("boot");
+    boot["quickConnect"] = globalDataController->getSystemSettings()->bootQuickConnect;
+    boot["wifiMillis"] = globalDataController->getSystemSettings()->bootWifiMillis;
+    boot["firstDataMillis"] = globalDataController->getSystemSettings()->bootDataMillis;
+
+    JsonObject heap = target.createNestedObject("heap");
+    heap["free"] = heapFree;
+    heap["maxBlock"] = heapMax;
+    heap["fragmentation"] = heapFrag;
+
+    DisplayRenderStatsDataStruct *renderStats = globalDataController->getDisplayClient()->getRenderStats();
+    if (renderStats != NULL) {
+        JsonObject display = target.createNestedObject("display");
+        display["renderedFrames"] = renderStats->renderedFrames;
+        display["avgFrameMicros"] = renderStats->avgFrameMicros;
+        display["maxFrameMicros"] = renderStats->maxFrameMicros;
+        display["flushedBytes"] = renderStats->flushedBytes;
+    }
+}
+
+/**
+ * @brief Send json document with known content length
+ * @param writer                    Send out instance
+ * @param jsonDoc                   Document to send
+ */
+void WebserverApi::sendDocument(WebserverResponseWriter *writer, JsonDocument *jsonDoc) {
+    writer->begin(200, "application/json", measureJson(*jsonDoc));
+    serializeJson(*jsonDoc, *writer);
+    writer->end();
+}
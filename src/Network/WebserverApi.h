@@ -0,0 +1,33 @@
+#pragma once
+#include <Arduino.h>
+#include <ArduinoJson.h>
+#include <ESP8266WebServer.h>
+#include "../Global/GlobalDataController.h"
+#include "WebserverResponseWriter.h"
+
+// Size of the json document for a single object (printer, sensor, ...)
+#define WEBSERVER_API_JSON_SIZE     1024
+
+/**
+ * @brief Class to send device state as json (/api/v1/...)
+ * Every object is serialized directly into the response writer.
+ */
+class WebserverApi {
+public:
+    static void sendPrinters(WebserverResponseWriter *writer, GlobalDataController *globalDataController);
+    static void sendSensor(WebserverResponseWriter *writer, GlobalDataController *globalDataController);
+    static void sendWeather(WebserverResponseWriter *writer, GlobalDataController *globalDataController);
+    static void sendSystem(WebserverResponseWriter *writer, GlobalDataController *globalDataController);
+    static void sendState(WebserverResponseWriter *writer, GlobalDataController *globalDataController, String sinceToken);
+    static void sendPrinterClients(WebserverResponseWriter *writer, GlobalDataController *globalDataController);
+    static void sendPrinterConfig(WebserverResponseWriter *writer, GlobalDataController *globalDataController, int id);
+
+    static void fillPrinter(JsonObject target, int id, PrinterDataStruct *printer, GlobalDataController *globalDataController);
+    static void fillSensor(JsonObject target, SensorDataStruct *sensor, GlobalDataController *globalDataController);
+    static void fillSensorStats(JsonObject target, SensorStatsDataStruct *stats);
+    static void fillWeather(JsonObject target, GlobalDataController *globalDataController);
+    static void fillSystem(JsonObject target, GlobalDataController *globalDataController);
+
+private:
+    static void sendDocument(WebserverResponseWriter *writer, JsonDocument *jsonDoc);
+};
@@ -0,0 +1,111 @@
+#include "WebserverAssets.h"
+
+WebserverAssetDataStruct WebserverAssets::assets[WEBSERVER_ASSET_COUNT] = {
+    { "/www/app.css", "/www/app.css.gz", "text/css", WEBSERVER_ASSET_CACHE_CONTROL, false, "" },
+    { "/www/app.js", "/www/app.js.gz", "application/javascript", WEBSERVER_ASSET_CACHE_CONTROL, false, "" },
+    { "/www/index.html", "/www/index.html.gz", "text/html", WEBSERVER_ASSET_CACHE_REVALIDATE, false, "" }
+};
+
+/**
+ * @brief Check the assets on the filesystem and register their routes
+ * @param server            Webserver instance
+ */
+void WebserverAssets::setup(ESP8266WebServer *server) {
+    static ESP8266WebServer *assetServer = server;
+    static const char *headerKeys[] = { "If-None-Match" };
+    server->collectHeaders(headerKeys, 1);
+
+    for (int i = 0; i < WEBSERVER_ASSET_COUNT; i++) {
+        WebserverAssets::assets[i].isAvailable = WebserverAssets::calculateEtag(&WebserverAssets::assets[i]);
+    }
+    server->on(WebserverAssets::assets[WEBSERVER_ASSET_APP_CSS].uri, HTTP_GET, []() {
+        WebserverAssets::send(assetServer, WEBSERVER_ASSET_APP_CSS);
+    });
+    server->on(WebserverAssets::assets[WEBSERVER_ASSET_APP_JS].uri, HTTP_GET, []() {
+        WebserverAssets::send(assetServer, WEBSERVER_ASSET_APP_JS);
+    });
+    server->on(WebserverAssets::assets[WEBSERVER_ASSET_SPA_INDEX].uri, HTTP_GET, []() {
+        WebserverAssets::send(assetServer, WEBSERVER_ASSET_SPA_INDEX);
+    });
+}
+
+/**
+ * @brief Check if an asset is on the filesystem, otherwise it must be sent inline
+ * @param assetId           Id of asset
+ * @return true 
+ * @return false 
+ */
+bool WebserverAssets::isAvailable(int assetId) {
+    return WebserverAssets::assets[assetId].isAvailable;
+}
+
+/**
+ * @brief Version of an asset for the url (same as the ETag)
+ * @param assetId           Id of asset
+ * @return const char* 
+ */
+const char *WebserverAssets::getVersion(int assetId) {
+    return WebserverAssets::assets[assetId].etag;
+}
+
+/**
+ * @brief Send gzipped asset, 304 when the client has the current version
+ * @param server            Webserver instance
+ * @param assetId           Id of asset
+ */
+void WebserverAssets::send(ESP8266WebServer *server, int assetId) {
+    WebserverAssetDataStruct *asset = &WebserverAssets::assets[assetId];
+    String etag = "\"" + String(asset->etag) + "\"";
+
+    if (!asset->isAvailable) {
+        server->send(404, "text/plain", "Asset not found");
+        return;
+    }
+    server->sendHeader("ETag", etag);
+    server->sendHeader("Cache-Control", asset->cacheControl);
+    if (server->header("If-None-Match") == etag) {
+        server->send(304, asset->contentType, "");
+        return;
+    }
+
+    File f = LittleFS.open(asset->fileName, "r");
+    if (!f) {
+        server->send(404, "text/plain", "Asset not found");
+        return;
+    }
+    server->sendHeader("Content-Encoding", "gzip");
+    server->setContentLength(f.size());
+    server->send(200, asset->contentType, "");
+
+    char buffer[256];
+    size_t readBytes;
+    while ((readBytes = f.readBytes(buffer, sizeof(buffer))) > 0) {
+        server->sendContent(buffer, readBytes);
+    }
+    f.close();
+}
+
+/**
+ * @brief Calculate ETag from the content of the asset file (FNV-1a)
+ * @param asset             Asset to check
+ * @return true             Asset file found
+ * @return false 
+ */
+bool WebserverAssets::calculateEtag(WebserverAssetDataStruct *asset) {
+    File f = LittleFS.open(asset->fileName, "r");
+    if (!f) {
+        return false;
+    }
+    uint32_t hash = 2166136261UL;
+    uint8_t buffer[64];
+    size_t readBytes;
+    while ((readBytes = f.read(buffer, sizeof(buffer))) > 0) {
+        for (size_t i = 0; i < readBytes; i++) {
+            hash ^= buffer[i];
+            hash *= 16777619UL;
+        }
+    }
+    f.close();
+    snprintf(asset->etag, sizeof(asset->etag), "%08x", (unsigned int)hash);
+    return true;
+}
@@ -0,0 +1,32 @@
+#pragma once
+#include <Arduino.h>
+#include <ESP8266WebServer.h>
+#include <LittleFS.h>
+#include "../DataStructs/WebserverAssetDataStruct.h"
+
+#define WEBSERVER_ASSET_APP_CSS     0
+#define WEBSERVER_ASSET_APP_JS      1
+#define WEBSERVER_ASSET_SPA_INDEX   2
+#define WEBSERVER_ASSET_COUNT       3
+
+// Assets are versioned by url (?v=<etag>), so the client can cache them forever
+#define WEBSERVER_ASSET_CACHE_CONTROL   "public, max-age=31536000, immutable"
+// Entry pages keep their url, the client must revalidate them (ETag)
+#define WEBSERVER_ASSET_CACHE_REVALIDATE    "no-cache"
+
+/**
+ * @brief Serves the gzipped static assets from LittleFS with strong ETags and long max-age
+ */
+class WebserverAssets {
+private:
+    static WebserverAssetDataStruct assets[WEBSERVER_ASSET_COUNT];
+
+public:
+    static void setup(ESP8266WebServer *server);
+    static bool isAvailable(int assetId);
+    static const char *getVersion(int assetId);
+    static void send(ESP8266WebServer *server, int assetId);
+
+private:
+    static bool calculateEtag(WebserverAssetDataStruct *asset);
+};
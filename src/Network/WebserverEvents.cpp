@@ -0,0 +1,209 @@
+#include "WebserverEvents.h"
+
+static const char EVENTS_RESPONSE_HEADER[] PROGMEM = "HTTP/1.1 200 OK\r\n"
+    "Content-Type: text/event-stream\r\n"
+    "Cache-Control: no-cache\r\n"
+    "Connection: keep-alive\r\n"
+    "\r\n"
+    "retry: 5000\n\n";
+static const char EVENTS_KEEPALIVE[] PROGMEM = ":\n\n";
+
+/**
+ * @brief Construct a new Webserver Events object
+ * @param globalDataController      Access to global data
+ */
+WebserverEvents::WebserverEvents(GlobalDataController *globalDataController) {
+    this->globalDataController = globalDataController;
+}
+
+/**
+ * @brief Take over the connection of the current request as event stream
+ * @param client            Client of the current request
+ * @return true             Stream opened
+ * @return false            No free slot
+ */
+bool WebserverEvents::addClient(WiFiClient client) {
+    for (int i = 0; i < WEBSERVER_EVENTS_MAX_CLIENTS; i++) {
+        if (this->clients[i].connected()) {
+            continue;
+        }
+        this->clients[i] = client;
+        this->clients[i].setNoDelay(true);
+        this->clients[i].write_P(EVENTS_RESPONSE_HEADER, strlen_P(EVENTS_RESPONSE_HEADER));
+
+        // New client needs the complete state, send everything with next check
+        this->sendAll = true;
+        this->lastCheckMillis = 0;
+        return true;
+    }
+    return false;
+}
+
+/**
+ * @brief Check if the connection is one of the open streams
+ * @param client            Connection to check
+ * @return true             Connection is an open stream
+ * @return false 
+ */
+bool WebserverEvents::isStream(WiFiClient &client) {
+    for (int i = 0; i < WEBSERVER_EVENTS_MAX_CLIENTS; i++) {
+        if (this->clients[i].connected()
+            && (this->clients[i].remotePort() == client.remotePort())
+            && (this->clients[i].remoteIP() == client.remoteIP())
+        ) {
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * @brief Send changed data to all open streams, called from main loop
+ */
+void WebserverEvents::handle() {
+    if ((this->lastCheckMillis > 0) && (millis() - this->lastCheckMillis < WEBSERVER_EVENTS_CHECK_MILLIS)) {
+        return;
+    }
+    this->lastCheckMillis = millis();
+    if (this->getNumClients() == 0) {
+        return;
+    }
+
+    if (this->sendAll || (this->globalDataController->getStateVersion() != this->sentStateVersion)) {
+        for (int i = 0; i < this->globalDataController->getNumPrinters(); i++) {
+            if (this->hasChanged(this->globalDataController->getPrinterStateVersion(i))) {
+                this->publishPrinter(i);
+            }
+        }
+        if (this->globalDataController->getSensorSettings()->activated && this->hasChanged(this->globalDataController->getSensorStateVersion())) {
+            this->publishSensor();
+        }
+        if (this->globalDataController->getWeatherSettings()->show && this->hasChanged(this->globalDataController->getWeatherStateVersion())) {
+            this->publishWeather();
+        }
+        this->sentStateVersion = this->globalDataController->getStateVersion();
+        this->sendAll = false;
+    }
+
+    if (millis() - this->lastSendMillis >= WEBSERVER_EVENTS_KEEPALIVE_MILLIS) {
+        char keepAlive[4];
+        strcpy_P(keepAlive, EVENTS_KEEPALIVE);
+        this->sendToClients(keepAlive, strlen(keepAlive));
+    }
+}
+
+/**
+ * @brief Number of open streams, closed streams are released
+ * @return int 
+ */
+int WebserverEvents::getNumClients() {
+    int numClients = 0;
+    for (int i = 0; i < WEBSERVER_EVENTS_MAX_CLIENTS; i++) {
+        if (this->clients[i].connected()) {
+            numClients++;
+        } else if (this->clients[i]) {
+            this->clients[i].stop();
+            this->clients[i] = WiFiClient();
+        }
+    }
+    return numClients;
+}
+
+/**
+ * @brief Send printer event if the data of the printer has changed
+ * @param idx               Index of printer
+ */
+void WebserverEvents::publishPrinter(int idx) {
+    PrinterDataStruct *printer = &this->globalDataController->getPrinterSettings()[idx];
+    PrinterViewDataStruct *printerView = this->globalDataController->getViewModel()->getPrinter(idx);
+    StaticJsonDocument<JSON_OBJECT_SIZE(10)> jsonDoc;
+
+    jsonDoc["id"] = idx + 1;
+    jsonDoc["state"] = printer->state;
+    jsonDoc["stateText"] = (const char *)printerView->stateText;
+    jsonDoc["progress"] = (const char *)printerView->progress;
+    jsonDoc["printTime"] = (const char *)printerView->printTime;
+    jsonDoc["printTimeLeft"] = (const char *)printerView->printTimeLeft;
+    jsonDoc["toolTemp"] = (const char *)printerView->toolTemp;
+    jsonDoc["toolTargetTemp"] = (const char *)printerView->toolTargetTemp;
+    jsonDoc["bedTemp"] = (const char *)printerView->bedTemp;
+    jsonDoc["bedTargetTemp"] = (const char *)printerView->bedTargetTemp;
+    this->publish("printer", &jsonDoc);
+}
+
+/**
+ * @brief Send sensor event if the sensor data has changed
+ */
+void WebserverEvents::publishSensor() {
+    SensorViewDataStruct *sensorView = this->globalDataController->getViewModel()->getSensor();
+    StaticJsonDocument<JSON_OBJECT_SIZE(7)> jsonDoc;
+
+    jsonDoc["temperature"] = (const char *)sensorView->temperature;
+    jsonDoc["temperatureRange"] = (const char *)sensorView->temperatureRange;
+    jsonDoc["humidityRange"] = (const char *)sensorView->humidityRange;
+    jsonDoc["humidity"] = (const char *)sensorView->humidity;
+    jsonDoc["pressure"] = (const char *)sensorView->pressure;
+    jsonDoc["airQuality"] = (const char *)sensorView->airQuality;
+    jsonDoc["altitude"] = (const char *)sensorView->altitude;
+    this->publish("sensor", &jsonDoc);
+}
+
+/**
+ * @brief Send weather event if the weather has changed
+ */
+void WebserverEvents::publishWeather() {
+    WeatherViewDataStruct *weatherView = this->globalDataController->getViewModel()->getWeather();
+    StaticJsonDocument<JSON_OBJECT_SIZE(4)> jsonDoc;
+
+    jsonDoc["temperature"] = (const char *)weatherView->temperature;
+    jsonDoc["humidity"] = (const char *)weatherView->humidity;
+    jsonDoc["wind"] = (const char *)weatherView->wind;
+    jsonDoc["description"] = (const char *)weatherView->description;
+    this->publish("weather", &jsonDoc);
+}
+
+/**
+ * @brief Send event to all streams
+ * @param eventName         Name of event
+ * @param jsonDoc           Event data
+ */
+void WebserverEvents::publish(const char *eventName, JsonDocument *jsonDoc) {
+    char eventBuffer[WEBSERVER_EVENTS_BUFFER_SIZE];
+    size_t headerLen = snprintf(eventBuffer, sizeof(eventBuffer), "event: %s\ndata: ", eventName);
+    size_t dataLen = serializeJson(*jsonDoc, eventBuffer + headerLen, sizeof(eventBuffer) - headerLen - 2);
+
+    eventBuffer[headerLen + dataLen] = '\n';
+    eventBuffer[headerLen + dataLen + 1] = '\n';
+    this->sendToClients(eventBuffer, headerLen + dataLen + 2);
+}
+
+/**
+ * @brief Write data to all open streams. A write would block until the stream has room, so a stream
+ * without room for the data (e.g. a sleeping browser) is closed. The browser connects again and gets
+ * the complete state.
+ * @param data 
+ * @param length 
+ */
+void WebserverEvents::sendToClients(const char *data, size_t length) {
+    for (int i = 0; i < WEBSERVER_EVENTS_MAX_CLIENTS; i++) {
+        if (!this->clients[i].connected()) {
+            continue;
+        }
+        if ((size_t)this->clients[i].availableForWrite() < length) {
+            this->clients[i].stop();
+            continue;
+        }
+        this->clients[i].write(data, length);
+    }
+    this->lastSendMillis = millis();
+}
+
+/**
+ * @brief Check if data with the given state version was changed after the last sent events
+ * @param stateVersion      State version of data
+ * @return true             Must be sent
+ * @return false 
+ */
+bool WebserverEvents::hasChanged(uint32_t stateVersion) {
+    return this->sendAll || (stateVersion > this->sentStateVersion);
+}
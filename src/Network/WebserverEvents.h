@@ -0,0 +1,44 @@
+#pragma once
+#include <Arduino.h>
+#include <ESP8266WiFi.h>
+#include <ArduinoJson.h>
+#include "../Global/GlobalDataController.h"
+
+// Open /events streams at the same time, more clients get a 503
+#define WEBSERVER_EVENTS_MAX_CLIENTS        2
+// Check interval for changed data
+#define WEBSERVER_EVENTS_CHECK_MILLIS       1000
+// Send a comment line when nothing was sent (keeps proxies and the browser connection alive)
+#define WEBSERVER_EVENTS_KEEPALIVE_MILLIS   15000
+// Size of one event ("event: ...\ndata: {...}\n\n")
+#define WEBSERVER_EVENTS_BUFFER_SIZE        400
+
+/**
+ * @brief Server-Sent Events stream (/events) with changes of printer, sensor and weather data
+ * Every event contains the preformatted values of one printer, the sensor or the weather,
+ * an event is only sent when the state version of its data is newer than the last sent one.
+ */
+class WebserverEvents {
+private:
+    GlobalDataController *globalDataController;
+    WiFiClient clients[WEBSERVER_EVENTS_MAX_CLIENTS];
+    uint32_t sentStateVersion = 0;
+    bool sendAll = true;
+    unsigned long lastCheckMillis = 0;
+    unsigned long lastSendMillis = 0;
+
+public:
+    WebserverEvents(GlobalDataController *globalDataController);
+    bool addClient(WiFiClient client);
+    void handle();
+    int getNumClients();
+    bool isStream(WiFiClient &client);
+
+private:
+    void publishPrinter(int idx);
+    void publishSensor();
+    void publishWeather();
+    void publish(const char *eventName, JsonDocument *jsonDoc);
+    void sendToClients(const char *data, size_t length);
+    bool hasChanged(uint32_t stateVersion);
+};
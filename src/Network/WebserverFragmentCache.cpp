@@ -0,0 +1,72 @@
+#include "WebserverFragmentCache.h"
+
+WebserverFragmentDataStruct WebserverFragmentCache::fragments[WEBSERVER_FRAGMENT_SLOTS] = {};
+size_t WebserverFragmentCache::cachedSize = 0;
+
+/**
+ * @brief Send fragment from cache, if missing or outdated it is rendered and stored
+ * @param writer            Send out instance
+ * @param slot              Slot of fragment
+ * @param version           Current state version of the fragment content
+ * @param render            Sends out the fragment to writer
+ */
+void WebserverFragmentCache::send(WebserverResponseWriter *writer, int slot, uint32_t version, std::function<void()> render) {
+    if ((slot < 0) || (slot >= WEBSERVER_FRAGMENT_SLOTS)) {
+        render();
+        return;
+    }
+    WebserverFragmentDataStruct *fragment = &WebserverFragmentCache::fragments[slot];
+    if ((fragment->content != NULL) && (fragment->version == version)) {
+        writer->write(fragment->content, fragment->length);
+        return;
+    }
+    WebserverFragmentCache::release(slot);
+
+    if (!writer->beginCapture(WEBSERVER_FRAGMENT_MAX_SIZE)) {
+        render();
+        return;
+    }
+    render();
+    size_t length = 0;
+    uint8_t *content = writer->endCapture(&length);
+    if (content == NULL) {
+        // Too large for caching
+        render();
+        return;
+    }
+    writer->write(content, length);
+
+    if (WebserverFragmentCache::cachedSize + length > WEBSERVER_FRAGMENT_CACHE_SIZE) {
+        free(content);
+        return;
+    }
+    fragment->content = content;
+    fragment->length = length;
+    fragment->version = version;
+    WebserverFragmentCache::cachedSize += length;
+}
+
+/**
+ * @brief Release all fragments of unused slots (e.g. after a printer was removed)
+ * @param usedSlots         Number of slots in use
+ */
+void WebserverFragmentCache::trim(int usedSlots) {
+    for (int i = _max(usedSlots, 0); i < WEBSERVER_FRAGMENT_SLOTS; i++) {
+        WebserverFragmentCache::release(i);
+    }
+}
+
+/**
+ * @brief Release the fragment of a slot
+ * @param slot              Slot of fragment
+ */
+void WebserverFragmentCache::release(int slot) {
+    WebserverFragmentDataStruct *fragment = &WebserverFragmentCache::fragments[slot];
+    if (fragment->content != NULL) {
+        free(fragment->content);
+        WebserverFragmentCache::cachedSize -= fragment->length;
+    }
+    fragment->content = NULL;
+    fragment->length = 0;
+    fragment->version = 0;
+}
@@ -0,0 +1,30 @@
+#pragma once
+#include <Arduino.h>
+#include <functional>
+#include "../Configuration.h"
+#include "../DataStructs/WebserverFragmentDataStruct.h"
+#include "WebserverResponseWriter.h"
+
+// One slot for the dashboard card of every printer
+#define WEBSERVER_FRAGMENT_SLOTS        MAX_PRINTERS
+// Maximum size of a single fragment, larger ones are always rendered directly
+#define WEBSERVER_FRAGMENT_MAX_SIZE     2048
+// Maximum size of all cached fragments together
+#define WEBSERVER_FRAGMENT_CACHE_SIZE   6144
+
+/**
+ * @brief Keeps rendered html fragments in memory until their state version changes
+ * A cached fragment is sent with a single copy instead of rendering all templates again.
+ */
+class WebserverFragmentCache {
+private:
+    static WebserverFragmentDataStruct fragments[WEBSERVER_FRAGMENT_SLOTS];
+    static size_t cachedSize;
+
+public:
+    static void send(WebserverResponseWriter *writer, int slot, uint32_t version, std::function<void()> render);
+    static void trim(int usedSlots);
+
+private:
+    static void release(int slot);
+};
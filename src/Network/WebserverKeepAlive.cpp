@@ -0,0 +1,15 @@
+#include "WebserverKeepAlive.h"
+
+/**
+ * @brief Check if the idle connection has to be closed for the next client
+ * @param idleMillis        Time since the last request on the connection
+ * @param clientWaiting     Another connection is waiting to be accepted
+ * @return true             Close the connection
+ * @return false            Keep it for further requests
+ */
+bool WebserverKeepAlive::shouldClose(unsigned long idleMillis, bool clientWaiting) {
+    if (clientWaiting) {
+        return idleMillis > WEBSERVER_KEEPALIVE_BUSY_IDLE_MILLIS;
+    }
+    return idleMillis > WEBSERVER_KEEPALIVE_IDLE_MILLIS;
+}
@@ -0,0 +1,17 @@
+#pragma once
+#include <Arduino.h>
+
+// Idle keep-alive connection is closed after this time, so queued clients are not blocked
+#define WEBSERVER_KEEPALIVE_IDLE_MILLIS         2000
+// Idle time after that the connection is closed when another client is waiting (next request of a page comes earlier)
+#define WEBSERVER_KEEPALIVE_BUSY_IDLE_MILLIS    20
+
+/**
+ * @brief Decides when an idle keep-alive connection of the web server is closed
+ * The server handles only one connection at a time. Without other dependencies, so the
+ * policy can also be checked on the host (env:native).
+ */
+class WebserverKeepAlive {
+public:
+    static bool shouldClose(unsigned long idleMillis, bool clientWaiting);
+};
@@ -4,23 +4,23 @@ String WebserverMemoryVariables::rowExtraClass = "";
 
 /**
  * @brief Send out header for webpage
- * @param server                    Send out instancce
+ * @param writer                    Send out instancce
  * @param globalDataController      Access to global data
  */
-void WebserverMemoryVariables::sendHeader(ESP8266WebServer *server, GlobalDataController *globalDataController, String pageLabel, String pageTitle) {
-    WebserverMemoryVariables::sendHeader(server, globalDataController, pageLabel, pageTitle, false);
+void WebserverMemoryVariables::sendHeader(WebserverResponseWriter *writer, GlobalDataController *globalDataController, String pageLabel, String pageTitle) {
+    WebserverMemoryVariables::sendHeader(writer, globalDataController, pageLabel, pageTitle, false);
 }
 
 /**
  * @brief Send out header for webpage
- * @param server                    Send out instancce
+ * @param writer                    Send out instancce
  * @param globalDataController      Access to global data
  * @param pageLabel                 Title label
  * @param pageTitle                 Title
  * @param refresh                   if true, auto refresh in header is set
  */
 void WebserverMemoryVariables::sendHeader(
-    ESP8266WebServer *server,
+    WebserverResponseWriter *writer,
     GlobalDataController *globalDataController,
     String pageLabel,
     String pageTitle,
@@ -29,65 +29,83 @@ void WebserverMemoryVariables::sendHeader(
     globalDataController->ledOnOff(true);
     int8_t rssi = EspController::getWifiQuality();
 
-    server->sendHeader("Cache-Control", "no-cache, no-store");
-    server->sendHeader("Pragma", "no-cache");
-    server->sendHeader("Expires", "-1");
-    server->setContentLength(CONTENT_LENGTH_UNKNOWN);
-    server->send(200, "text/html", "");
+    writer->begin(200, "text/html");
 
-    server->sendContent(String(FPSTR(HEADER_BLOCK1)));
+    writer->print(FPSTR(HEADER_BLOCK1));
     if (refresh) {
-        server->sendContent("<meta http-equiv=\"refresh\" content=\"30\">");
+        writer->print("<meta http-equiv=\"refresh\" content=\"30\">");
     }
-    server->sendContent(String(FPSTR(HEADER_BLOCK2)));
-    server->sendContent("<span class='bx--header__name--prefix'>PrintBuddy&nbsp;</span>V" + String(globalDataController->getSystemSettings()->version));
-    server->sendContent(String(FPSTR(HEADER_BLOCK3)));
-    server->sendContent(String(FPSTR(MENUE_ITEMS)));
-    server->sendContent(String(FPSTR(HEADER_BLOCK4)));
+    writer->print(FPSTR(HEADER_BLOCK2));
+    if (WebserverAssets::isAvailable(WEBSERVER_ASSET_APP_CSS) && WebserverAssets::isAvailable(WEBSERVER_ASSET_APP_JS)) {
+        WebserverTemplate::send(writer, HEADER_BLOCK2_ASSETS, [&](const char *token) {
+            WebserverTemplate::sendText(writer, WebserverAssets::getVersion(strcmp(token, "CSSVERSION") == 0 ? WEBSERVER_ASSET_APP_CSS : WEBSERVER_ASSET_APP_JS));
+        });
+    } else {
+        writer->print("<style>");
+        writer->print(FPSTR(ASSET_APP_CSS));
+        writer->print("</style><script>");
+        writer->print(FPSTR(ASSET_APP_JS));
+        writer->print("</script>");
+    }
+    writer->print(FPSTR(HEADER_BLOCK2_BODY));
+    writer->print("<span class='bx--header__name--prefix'>PrintBuddy&nbsp;</span>V" + String(globalDataController->getSystemSettings()->version));
+    writer->print(FPSTR(HEADER_BLOCK3));
+    writer->print(FPSTR(MENUE_ITEMS));
+    writer->print(FPSTR(HEADER_BLOCK4));
 
     uint32_t heapFree = 0;
     uint16_t heapMax = 0;
     uint8_t heapFrag = 0;
     EspController::getHeap(&heapFree, &heapMax, &heapFrag);
 
-    server->sendContent("<div>WiFi Signal Strength: " + String(rssi) + "%</div>");
-    server->sendContent("<div>ESP ChipID: " + String(ESP.getChipId()) + "</div>");
-    server->sendContent("<div>ESP CoreVersion: " + String(ESP.getCoreVersion()) + "</div>");
-    server->sendContent("<div>Heap (frag/free/max): " + String(heapFrag) + "% |" +  String(heapFree) + " b|" + String(heapMax) + " b</div>");
-    server->sendContent(String(FPSTR(HEADER_BLOCK5)));
-    server->sendContent(pageLabel);
-    server->sendContent("</h4><h1 id='page-title' class='page-header__title'>");
-    server->sendContent(pageTitle);
-    server->sendContent("</h1>");
-
-    TimeClient *timeCli = globalDataController->getTimeClient();
-    String displayTime = timeCli->getAmPmHours() + ":" + timeCli->getMinutes() + ":" + timeCli->getSeconds() + " " + timeCli->getAmPm();
-    if (globalDataController->getClockSettings()->is24h) {
-        displayTime = timeCli->getHours() + ":" + timeCli->getMinutes() + ":" + timeCli->getSeconds();
+    writer->print("<div>WiFi Signal Strength: " + String(rssi) + "%</div>");
+    writer->print("<div>ESP ChipID: " + String(ESP.getChipId()) + "</div>");
+    writer->print("<div>ESP CoreVersion: " + String(ESP.getCoreVersion()) + "</div>");
+    writer->print("<div>Heap (frag/free/max): " + String(heapFrag) + "% |" +  String(heapFree) + " b|" + String(heapMax) + " b</div>");
+    SystemDataStruct *systemSettings = globalDataController->getSystemSettings();
+    writer->print(
+        "<div>Boot (WiFi/first data): " + String(systemSettings->bootWifiMillis) + " ms|"
+        + (systemSettings->bootDataMillis > 0 ? String(systemSettings->bootDataMillis) + " ms" : String("pending"))
+        + (systemSettings->bootQuickConnect ? " (quick connect)" : "") + "</div>"
+    );
+    DisplayRenderStatsDataStruct *renderStats = globalDataController->getDisplayClient()->getRenderStats();
+    if (renderStats != NULL) {
+        writer->print(
+            "<div>Display frames (cnt/avg/max/flushed): " + String(renderStats->renderedFrames) + " |" + String(renderStats->avgFrameMicros)
+            + " us|" + String(renderStats->maxFrameMicros) + " us|" + String(renderStats->flushedBytes) + " b <a href='/display/frame.pbm'>[frame]</a></div>"
+        );
     }
-    server->sendContent("<div style='position:absolute;right:0;top:0;text-align:right'>Current time<br>" + displayTime + "</div></div>");
+    writer->print(FPSTR(HEADER_BLOCK5));
+    WebserverTemplate::sendText(writer, pageLabel);
+    writer->print("</h4><h1 id='page-title' class='page-header__title'>");
+    WebserverTemplate::sendText(writer, pageTitle);
+    writer->print("</h1>");
+
+    writer->print("<div style='position:absolute;right:0;top:0;text-align:right'>Current time<br>");
+    writer->print(globalDataController->getTimeView()->clockLong);
+    writer->print("</div></div>");
 
     if (globalDataController->getSystemSettings()->lastError.length() > 0) {
-        String errorBlock = FPSTR(HEADER_BLOCK_ERROR);
-        errorBlock.replace("%ERRORMSG%", globalDataController->getSystemSettings()->lastError);
-        server->sendContent(errorBlock);
+        WebserverTemplate::send(writer, HEADER_BLOCK_ERROR, [&](const char *token) {
+            WebserverTemplate::sendText(writer, globalDataController->getSystemSettings()->lastError);
+        });
     }
     if (globalDataController->getSystemSettings()->lastOk.length() > 0) {
-        String okBlock = FPSTR(HEADER_BLOCK_OK);
-        okBlock.replace("%OKMSG%", globalDataController->getSystemSettings()->lastOk);
-        server->sendContent(okBlock);
+        WebserverTemplate::send(writer, HEADER_BLOCK_OK, [&](const char *token) {
+            WebserverTemplate::sendText(writer, globalDataController->getSystemSettings()->lastOk);
+        });
         globalDataController->getSystemSettings()->lastOk = "";
     }
 }
 
 /**
  * @brief send out footer content for webpage
- * @param server                    Send out instancce
+ * @param writer                    Send out instancce
  * @param globalDataController      Access to global data
  */
-void WebserverMemoryVariables::sendFooter(ESP8266WebServer *server, GlobalDataController *globalDataController) {
+void WebserverMemoryVariables::sendFooter(WebserverResponseWriter *writer, GlobalDataController *globalDataController) {
     WebserverMemoryVariables::sendModalDanger(
-        server,
+        writer,
         "resetSettingsModal",
         FPSTR(GLOBAL_TEXT_WARNING),
         FPSTR(GLOBAL_TEXT_TRESET),
@@ -97,7 +115,7 @@ void WebserverMemoryVariables::sendFooter(ESP8266WebServer *server, GlobalDataCo
         "onclick='openUrl(\"/systemreset\")'"
     );
     WebserverMemoryVariables::sendModalDanger(
-        server,
+        writer,
         "resetWifiModal",
         FPSTR(GLOBAL_TEXT_WARNING),
         FPSTR(GLOBAL_TEXT_TFWIFI),
@@ -106,258 +124,292 @@ void WebserverMemoryVariables::sendFooter(ESP8266WebServer *server, GlobalDataCo
         FPSTR(GLOBAL_TEXT_RESET),
         "onclick='openUrl(\"/forgetwifi\")'"
     );
-    server->sendContent(String(FPSTR(FOOTER_BLOCK)));
-    server->sendContent("");
-    server->client().stop();
+    writer->print(FPSTR(FOOTER_BLOCK));
+    writer->end();
     globalDataController->ledOnOff(false);
 }
 
 /**
  * @brief Send out main page
- * @param server                    Send out instancce
+ * @param writer                    Send out instancce
  * @param globalDataController      Access to global data
  */
-void WebserverMemoryVariables::sendMainPage(ESP8266WebServer *server, GlobalDataController *globalDataController) {
-    String rowStart = FPSTR(FORM_ITEM_ROW_START);
-    rowStart.replace("%ROWEXTRACLASS%", "");
-
+void WebserverMemoryVariables::sendMainPage(WebserverResponseWriter *writer, GlobalDataController *globalDataController) {
     // Show weather and sensordata
-    OpenWeatherMapClient *weatherClient = globalDataController->getWeatherClient();
-    if ((globalDataController->getWeatherSettings()->show && weatherClient->getCity(0) != "") || globalDataController->getSensorSettings()->activated) {
-        server->sendContent(rowStart);
-        String startBlock = FPSTR(MAINPAGE_ROW_WEATHER_AND_SENSOR_START);
-        String displayBlock = FPSTR(MAINPAGE_ROW_WEATHER_AND_SENSOR_BLOCK);   
-        if (!globalDataController->getWeatherSettings()->show || weatherClient->getCity(0) == "") {
-            startBlock.replace("%ICON%", "");
-            server->sendContent(startBlock);
+    WeatherViewDataStruct *weatherView = globalDataController->getViewModel()->getWeather();
+    if ((globalDataController->getWeatherSettings()->show && weatherView->isValid) || globalDataController->getSensorSettings()->activated) {
+        WebserverMemoryVariables::sendRowStart(writer, "");
+        if (!globalDataController->getWeatherSettings()->show || !weatherView->isValid) {
+            WebserverTemplate::send(writer, MAINPAGE_ROW_WEATHER_AND_SENSOR_START, [&](const char *token) {});
             if (globalDataController->getWeatherSettings()->show) {
-                displayBlock = FPSTR(MAINPAGE_ROW_WEATHER_ERROR_BLOCK);
-                if (weatherClient->getError() != "") {
-                    displayBlock.replace("%ERRORMSG%", "Weather Error: " + weatherClient->getError());
-                } else {
-                    displayBlock.replace("%ERRORMSG%", "");
-                }
-            } else {
-                displayBlock = "";
+                WebserverTemplate::send(writer, MAINPAGE_ROW_WEATHER_ERROR_BLOCK, [&](const char *token) {
+                    if (strlen(weatherView->error) > 0) {
+                        writer->print("Weather Error: ");
+                        WebserverTemplate::sendText(writer, weatherView->error);
+                    }
+                });
             }
         } else {
-            startBlock.replace("%ICON%", weatherClient->getIcon(0));
-            server->sendContent(startBlock);
-            displayBlock.replace("%BTITLE%", weatherClient->getCity(0) + ", " + weatherClient->getCountry(0));
-            displayBlock.replace("%BLABEL%", "Lat: " + weatherClient->getLat(0) + ", Lon: " + weatherClient->getLon(0));
-            displayBlock.replace("%TEMPICON%", FPSTR(ICON32_TEMP));
-            displayBlock.replace("%TEMPERATURE%", weatherClient->getTempRounded(0) + weatherClient->getTempSymbol(true));
-            displayBlock.replace("%ICONA%", FPSTR(ICON16_WIND));
-            displayBlock.replace("%ICONB%", FPSTR(ICON16_HUMIDITY));
-            displayBlock.replace("%TEXTA%", weatherClient->getWind(0) + " " + weatherClient->getSpeedSymbol() + " Winds");
-            displayBlock.replace("%TEXTB%", weatherClient->getHumidity(0) + "% Humidity");
-            displayBlock.replace("%EXTRABLOCK%", "Condition: " + weatherClient->getDescription(0));
+            WebserverTemplate::send(writer, MAINPAGE_ROW_WEATHER_AND_SENSOR_START, [&](const char *token) {
+                WebserverTemplate::sendText(writer, weatherView->icon);
+            });
+            WebserverTemplate::send(writer, MAINPAGE_ROW_WEATHER_AND_SENSOR_BLOCK, [&](const char *token) {
+                if (strcmp(token, "BLOCKID") == 0) {
+                    writer->print("wb");
+                } else if (strcmp(token, "BTITLE") == 0) {
+                    WebserverTemplate::sendText(writer, weatherView->city);
+                    writer->print(", ");
+                    WebserverTemplate::sendText(writer, weatherView->country);
+                } else if (strcmp(token, "BLABEL") == 0) {
+                    if (weatherView->isCached) {
+                        writer->print("Cached data, waiting for update");
+                    } else {
+                        WebserverTemplate::sendText(writer, weatherView->location);
+                    }
+                } else if (strcmp(token, "TEMPICON") == 0) {
+                    WebserverTemplate::sendText_P(writer, ICON32_TEMP);
+                } else if (strcmp(token, "TEMPERATURE") == 0) {
+                    WebserverMemoryVariables::sendValueSpan(writer, "temperature", weatherView->temperatureHtml);
+                } else if (strcmp(token, "ICONA") == 0) {
+                    WebserverTemplate::sendText_P(writer, ICON16_WIND);
+                } else if (strcmp(token, "ICONB") == 0) {
+                    WebserverTemplate::sendText_P(writer, ICON16_HUMIDITY);
+                } else if (strcmp(token, "TEXTA") == 0) {
+                    WebserverMemoryVariables::sendValueSpan(writer, "wind", weatherView->wind);
+                    writer->print(" Winds");
+                } else if (strcmp(token, "TEXTB") == 0) {
+                    WebserverMemoryVariables::sendValueSpan(writer, "humidity", weatherView->humidity);
+                    writer->print(" Humidity");
+                } else if (strcmp(token, "EXTRABLOCK") == 0) {
+                    writer->print("Condition: ");
+                    WebserverMemoryVariables::sendValueSpan(writer, "description", weatherView->description);
+                }
+            });
         }
-        server->sendContent(displayBlock);
         
         // Sensor data 
         if (globalDataController->getSensorSettings()->activated) {
             BaseSensorClient *refClient = globalDataController->getSensorClient(globalDataController->getSensorSettings());
             if (refClient != NULL) {
-                displayBlock = FPSTR(MAINPAGE_ROW_WEATHER_AND_SENSOR_BLOCK);
-                displayBlock.replace("%TEMPICON%", FPSTR(ICON32_TEMP));
-                displayBlock.replace("%BTITLE%", "Sensor");
-                displayBlock.replace("%BLABEL%", refClient->getType());
-
-                displayBlock.replace("%TEMPERATURE%", String(globalDataController->getSensorSettings()->temperature, 1) + "&#176;C");
+                SensorViewDataStruct *sensorView = globalDataController->getViewModel()->getSensor();
 
-                bool aSet = false;
-                bool bSet = false;
+                // Humidity is shown in first line, pressure in first or second line
+                PGM_P iconA = NULL;
+                PGM_P iconB = NULL;
+                String textA = "";
+                String textB = "";
                 if (refClient->hasHumidity()) {
-                    displayBlock.replace("%ICONA%", FPSTR(ICON16_HUMIDITY));
-                    displayBlock.replace("%TEXTA%",  String(globalDataController->getSensorSettings()->humidity, 1) + "% Humidity");
-                    aSet = true;
+                    iconA = ICON16_HUMIDITY;
+                    textA = "<span data-pb='humidity'>" + String(sensorView->humidity) + "</span>% Humidity";
                 }
                 if (refClient->hasPressure()) {
-                    if (!aSet) {
-                        displayBlock.replace("%ICONA%", FPSTR(ICON16_PRESSURE));
-                        displayBlock.replace("%TEXTA%",  String(globalDataController->getSensorSettings()->pressure, 1) + " hPa");
-                        aSet = true;
-                    } else if (!bSet) {
-                        displayBlock.replace("%ICONB%", FPSTR(ICON16_PRESSURE));
-                        displayBlock.replace("%TEXTB%",  String(globalDataController->getSensorSettings()->pressure, 1) + " hPa");
-                        bSet = true;
+                    if (iconA == NULL) {
+                        iconA = ICON16_PRESSURE;
+                        textA = "<span data-pb='pressure'>" + String(sensorView->pressure) + "</span> hPa";
+                    } else {
+                        iconB = ICON16_PRESSURE;
+                        textB = "<span data-pb='pressure'>" + String(sensorView->pressure) + "</span> hPa";
                     }
                 }
-                String extraTextBlock = "";
-                if (refClient->hasAirQuality()) {
-                    extraTextBlock += "Air quality: " + String(refClient->airQualityAsString(globalDataController->getSensorSettings()));
-                }
-                if (refClient->hasAltitude()) {
-                    if (extraTextBlock.length() > 0) {
-                        extraTextBlock += " | ";
-                    }
-                    extraTextBlock += "Altitude: " + String(globalDataController->getSensorSettings()->altitude, 1) +  "m";
-                }
 
-                // displayBlock.replace("%EXTRABLOCK%", "");
-                displayBlock.replace("%ICONA%", "");
-                displayBlock.replace("%TEXTA%",  "");
-                displayBlock.replace("%ICONB%", "");
-                displayBlock.replace("%TEXTB%",  "");
-                displayBlock.replace("%EXTRABLOCK%", extraTextBlock);
-                server->sendContent(displayBlock);
+                WebserverTemplate::send(writer, MAINPAGE_ROW_WEATHER_AND_SENSOR_BLOCK, [&](const char *token) {
+                    if (strcmp(token, "BLOCKID") == 0) {
+                        writer->print("sb");
+                    } else if (strcmp(token, "BTITLE") == 0) {
+                        writer->print("Sensor");
+                    } else if (strcmp(token, "BLABEL") == 0) {
+                        WebserverTemplate::sendText(writer, sensorView->type);
+                    } else if (strcmp(token, "TEMPICON") == 0) {
+                        WebserverTemplate::sendText_P(writer, ICON32_TEMP);
+                    } else if (strcmp(token, "TEMPERATURE") == 0) {
+                        WebserverMemoryVariables::sendValueSpan(writer, "temperature", sensorView->temperature);
+                        writer->print("&#176;C");
+                    } else if ((strcmp(token, "ICONA") == 0) && (iconA != NULL)) {
+                        WebserverTemplate::sendText_P(writer, iconA);
+                    } else if ((strcmp(token, "ICONB") == 0) && (iconB != NULL)) {
+                        WebserverTemplate::sendText_P(writer, iconB);
+                    } else if (strcmp(token, "TEXTA") == 0) {
+                        WebserverTemplate::sendText(writer, textA);
+                    } else if (strcmp(token, "TEXTB") == 0) {
+                        WebserverTemplate::sendText(writer, textB);
+                    } else if (strcmp(token, "EXTRABLOCK") == 0) {
+                        if (refClient->hasAirQuality()) {
+                            writer->print("Air quality: ");
+                            WebserverMemoryVariables::sendValueSpan(writer, "airQuality", sensorView->airQuality);
+                        }
+                        if (refClient->hasAltitude()) {
+                            if (refClient->hasAirQuality()) {
+                                writer->print(" | ");
+                            }
+                            writer->print("Altitude: ");
+                            WebserverMemoryVariables::sendValueSpan(writer, "altitude", sensorView->altitude);
+                            writer->print("m");
+                        }
+                    }
+                });
             }
         }
 
-        server->sendContent(FPSTR(MAINPAGE_ROW_WEATHER_AND_SENSOR_END));
-        server->sendContent(FPSTR(FORM_ITEM_ROW_END));
+        writer->print(FPSTR(MAINPAGE_ROW_WEATHER_AND_SENSOR_END));
+        writer->print(FPSTR(FORM_ITEM_ROW_END));
     }
 
     // Show all printer states
     int totalPrinters = globalDataController->getNumPrinters();
     PrinterDataStruct *printerConfigs = globalDataController->getPrinterSettings();
-    String lineData = "";
     int colCnt = 0;
-    server->sendContent(rowStart);
+    WebserverFragmentCache::trim(totalPrinters);
+    WebserverMemoryVariables::sendRowStart(writer, "");
 
-    // Show all errors if printers have one
+    // Cards are only rendered again if the printer state has changed
     for(int i=0; i<totalPrinters; i++) {
         if (colCnt >= 3) {
-            server->sendContent(FPSTR(FORM_ITEM_ROW_END));
-            server->sendContent(rowStart);
+            writer->print(FPSTR(FORM_ITEM_ROW_END));
+            WebserverMemoryVariables::sendRowStart(writer, "");
             colCnt = 0;
         }
+        WebserverFragmentCache::send(writer, i, globalDataController->getPrinterStateVersion(i), [&]() {
+            WebserverMemoryVariables::sendPrinterCard(writer, i, &printerConfigs[i], globalDataController);
+        });
+        colCnt++;
+    }
+    while(colCnt < 3) {
+        writer->print("<div class='bx--col bx--col--auto'></div>");
+        colCnt++;
+    }
+    writer->print(FPSTR(FORM_ITEM_ROW_END));
+    writer->print(FPSTR(MAINPAGE_EVENTS_SCRIPT));
+}
 
-        if ((printerConfigs[i].state == PRINTER_STATE_ERROR) || (printerConfigs[i].state == PRINTER_STATE_OFFLINE)) {
-            server->sendContent(FPSTR(MAINPAGE_ROW_PRINTER_BLOCK_S_ERROROFFLINE));
-        }
-        else if (printerConfigs[i].state == PRINTER_STATE_STANDBY) {
-            server->sendContent(FPSTR(MAINPAGE_ROW_PRINTER_BLOCK_S_STANDBY));
-        }
-        else {
-            server->sendContent(FPSTR(MAINPAGE_ROW_PRINTER_BLOCK_S_PRINTING));
+/**
+ * @brief Send out the dashboard card of a printer
+ * @param writer                    Send out instancce
+ * @param i                         Index of printer
+ * @param printerConfig             Handle to printer data
+ * @param globalDataController      Access to global data
+ */
+void WebserverMemoryVariables::sendPrinterCard(WebserverResponseWriter *writer, int i, PrinterDataStruct *printerConfig, GlobalDataController *globalDataController) {
+    PrinterViewDataStruct *printerView = globalDataController->getViewModel()->getPrinter(i);
+
+    PGM_P blockStart = MAINPAGE_ROW_PRINTER_BLOCK_S_PRINTING;
+    if ((printerConfig->state == PRINTER_STATE_ERROR) || (printerConfig->state == PRINTER_STATE_OFFLINE)) {
+        blockStart = MAINPAGE_ROW_PRINTER_BLOCK_S_ERROROFFLINE;
+    }
+    else if (printerConfig->state == PRINTER_STATE_STANDBY) {
+        blockStart = MAINPAGE_ROW_PRINTER_BLOCK_S_STANDBY;
+    }
+    WebserverTemplate::send(writer, blockStart, [&](const char *token) {
+        writer->print(strcmp(token, "ID") == 0 ? i + 1 : printerConfig->state);
+    });
+
+    WebserverTemplate::send(writer, MAINPAGE_ROW_PRINTER_BLOCK_TITLE, [&](const char *token) {
+        if (strcmp(token, "NAME") == 0) {
+            WebserverTemplate::sendText(writer, printerConfig->customName);
+        } else if (strcmp(token, "API") == 0) {
+            WebserverTemplate::sendText(writer, printerView->clientType);
         }
+    });
+    WebserverMemoryVariables::sendPrinterLine(writer, "Host", "host", printerView->host);
+    WebserverMemoryVariables::sendPrinterLine(writer, "State", "stateText", printerView->stateText);
 
-        lineData = FPSTR(MAINPAGE_ROW_PRINTER_BLOCK_TITLE);
-        lineData.replace("%NAME%", String(printerConfigs[i].customName));
-        lineData.replace("%API%", globalDataController->getPrinterClientType(&printerConfigs[i]));
-        server->sendContent(lineData);
+    if (printerConfig->state == PRINTER_STATE_ERROR) {
+        WebserverMemoryVariables::sendPrinterLine(writer, "Reason", "error", printerConfig->error);
+    }
+    else if (printerConfig->state == PRINTER_STATE_OFFLINE) {
+        WebserverMemoryVariables::sendPrinterLine(writer, "Reason", "error", "Not reachable");
+    } else {
+        if ((printerConfig->state == PRINTER_STATE_PRINTING) || (printerConfig->state == PRINTER_STATE_PAUSED)) {
+            WebserverTemplate::send(writer, MAINPAGE_ROW_PRINTER_BLOCK_PROG, [&](const char *token) {
+                WebserverTemplate::sendText(writer, printerView->progress);
+            });
+            writer->print(FPSTR(MAINPAGE_ROW_PRINTER_BLOCK_HR));
 
-        lineData = FPSTR(MAINPAGE_ROW_PRINTER_BLOCK_LINE);
-        lineData.replace("%T%", "Host");
-        lineData.replace("%V%", String(printerConfigs[i].remoteAddress) + ":" + String(printerConfigs[i].remotePort));
-        server->sendContent(lineData);
+            WebserverMemoryVariables::sendPrinterLine(writer, "Printing Time", "printTime", printerView->printTime);
+            WebserverMemoryVariables::sendPrinterLine(writer, "Est. Print Time Left", "printTimeLeft", printerView->printTimeLeft);
 
-        String currentState = globalDataController->getPrinterStateAsText(&printerConfigs[i]);
-        if (printerConfigs[i].isPSUoff && printerConfigs[i].hasPsuControl) {  
-            currentState += ", PSU off";
-        }
-        lineData = FPSTR(MAINPAGE_ROW_PRINTER_BLOCK_LINE);
-        lineData.replace("%T%", "State");
-        lineData.replace("%V%", currentState);
-        server->sendContent(lineData);
+            writer->print(FPSTR(MAINPAGE_ROW_PRINTER_BLOCK_HR));
 
-        if (printerConfigs[i].state == PRINTER_STATE_ERROR) {
-            lineData = FPSTR(MAINPAGE_ROW_PRINTER_BLOCK_LINE);
-            lineData.replace("%T%", "Reason");
-            lineData.replace("%V%", String(printerConfigs[i].error));
-            server->sendContent(lineData);
+            if (strlen(printerConfig->fileName) > 0) {
+                WebserverMemoryVariables::sendPrinterLine(writer, "File", "fileName", printerConfig->fileName);
+            }
+            if (strlen(printerView->fileSize) > 0) {
+                WebserverMemoryVariables::sendPrinterLine(writer, "Filesize", "fileSize", printerView->fileSize);
+            }
+            if (strlen(printerView->filament) > 0) {
+                WebserverMemoryVariables::sendPrinterLine(writer, "Filament", "filament", printerView->filament);
+            }
         }
-        else if (printerConfigs[i].state == PRINTER_STATE_OFFLINE) {
-            lineData = FPSTR(MAINPAGE_ROW_PRINTER_BLOCK_LINE);
-            lineData.replace("%T%", "Reason");
-            lineData.replace("%V%", "Not reachable");
-            server->sendContent(lineData);
-        } else {
-            if ((printerConfigs[i].state == PRINTER_STATE_PRINTING) || (printerConfigs[i].state == PRINTER_STATE_PAUSED)) {
-                lineData = FPSTR(MAINPAGE_ROW_PRINTER_BLOCK_PROG);
-                lineData.replace("%P%",  String(printerConfigs[i].progressCompletion) + "%");
-                server->sendContent(lineData);
-                server->sendContent(FPSTR(MAINPAGE_ROW_PRINTER_BLOCK_HR));
-
-                int val = printerConfigs[i].progressPrintTime;
-                int hours = globalDataController->numberOfHours(val);
-                int minutes = globalDataController->numberOfMinutes(val);
-                int seconds = globalDataController->numberOfSeconds(val);
-                lineData = FPSTR(MAINPAGE_ROW_PRINTER_BLOCK_LINE);
-                lineData.replace("%T%", "Printing Time");
-                lineData.replace("%V%", globalDataController->zeroPad(hours) + ":" + globalDataController->zeroPad(minutes) + ":" + globalDataController->zeroPad(seconds));
-                server->sendContent(lineData);
-
-                val = printerConfigs[i].progressPrintTimeLeft;
-                hours = globalDataController->numberOfHours(val);
-                minutes = globalDataController->numberOfMinutes(val);
-                seconds = globalDataController->numberOfSeconds(val);
-                lineData = FPSTR(MAINPAGE_ROW_PRINTER_BLOCK_LINE);
-                lineData.replace("%T%", "Est. Print Time Left");
-                lineData.replace("%V%", globalDataController->zeroPad(hours) + ":" + globalDataController->zeroPad(minutes) + ":" + globalDataController->zeroPad(seconds));
-                server->sendContent(lineData);
-
-                server->sendContent(FPSTR(MAINPAGE_ROW_PRINTER_BLOCK_HR));
-
-                if (String(printerConfigs[i].fileName).length() > 0) {
-                    lineData = FPSTR(MAINPAGE_ROW_PRINTER_BLOCK_LINE);
-                    lineData.replace("%T%", "File");
-                    lineData.replace("%V%", String(printerConfigs[i].fileName));
-                    server->sendContent(lineData);
-                }
 
-                float fileSize = printerConfigs[i].fileSize;
-                if (fileSize > 0) {
-                    lineData = FPSTR(MAINPAGE_ROW_PRINTER_BLOCK_LINE);
-                    lineData.replace("%T%", "Filesize");
-                    lineData.replace("%V%", String(fileSize) + " KB");
-                    server->sendContent(lineData);
-                }
+        writer->print(FPSTR(MAINPAGE_ROW_PRINTER_BLOCK_HR));
+        WebserverMemoryVariables::sendPrinterLine(
+            writer,
+            "Tool Temperature",
+            "tool",
+            (String(printerView->toolTemp) + "&#176; C [" + printerView->toolTargetTemp + "]").c_str()
+        );
 
-                int filamentLength = printerConfigs[i].filamentLength;
-                if (filamentLength > 0) {
-                    float fLength = float(filamentLength) / 1000;
-                    lineData = FPSTR(MAINPAGE_ROW_PRINTER_BLOCK_LINE);
-                    lineData.replace("%T%", "Filament");
-                    lineData.replace("%V%", String(fLength) + " m");
-                    server->sendContent(lineData);
-                }
-            }
+        if (printerConfig->bedTemp > 0 ) {
+            WebserverMemoryVariables::sendPrinterLine(
+                writer,
+                "Bed Temperature",
+                "bed",
+                (String(printerView->bedTemp) + "&#176; C [" + printerView->bedTargetTemp + "]").c_str()
+            );
+        }
+    }
 
-            server->sendContent(FPSTR(MAINPAGE_ROW_PRINTER_BLOCK_HR));
-            lineData = FPSTR(MAINPAGE_ROW_PRINTER_BLOCK_LINE);
-            lineData.replace("%T%", "Tool Temperature");
-            lineData.replace("%V%", String(printerConfigs[i].toolTemp) + "&#176; C [" + String(printerConfigs[i].toolTargetTemp) + "]");
-            server->sendContent(lineData);
-
-            if (printerConfigs[i].bedTemp > 0 ) {
-                lineData = FPSTR(MAINPAGE_ROW_PRINTER_BLOCK_LINE);
-                lineData.replace("%T%", "Bed Temperature");
-                lineData.replace("%V%", String(printerConfigs[i].bedTemp) + "&#176; C [" + String(printerConfigs[i].bedTargetTemp) + "]");
-                server->sendContent(lineData);
-            }
+    writer->print(FPSTR(MAINPAGE_ROW_PRINTER_BLOCK_E));
+}
+
+/**
+ * @brief Send out a single line of a printer block on main page
+ * @param writer                    Send out instancce
+ * @param title                     Title of value
+ * @param key                       Key of value in printer events
+ * @param value                     Value
+ */
+void WebserverMemoryVariables::sendPrinterLine(WebserverResponseWriter *writer, const char *title, const char *key, const char *value) {
+    WebserverTemplate::send(writer, MAINPAGE_ROW_PRINTER_BLOCK_LINE, [&](const char *token) {
+        if (strcmp(token, "T") == 0) {
+            WebserverTemplate::sendText(writer, title);
+        } else if (strcmp(token, "K") == 0) {
+            WebserverTemplate::sendText(writer, key);
+        } else {
+            WebserverTemplate::sendText(writer, value);
         }
+    });
+}
 
-        server->sendContent(FPSTR(MAINPAGE_ROW_PRINTER_BLOCK_E));
-        colCnt++;
-    }
-    while(colCnt < 3) {
-        server->sendContent("<div class='bx--col bx--col--auto'></div>");
-        colCnt++;
-    }
-    server->sendContent(FPSTR(FORM_ITEM_ROW_END));    
+/**
+ * @brief Send out a value which is updated in place by events
+ * @param writer                    Send out instancce
+ * @param key                       Key of value in events
+ * @param value                     Value
+ */
+void WebserverMemoryVariables::sendValueSpan(WebserverResponseWriter *writer, const char *key, const char *value) {
+    WebserverTemplate::send(writer, MAINPAGE_VALUE_SPAN, [&](const char *token) {
+        WebserverTemplate::sendText(writer, strcmp(token, "K") == 0 ? key : value);
+    });
 }
 
 /**
  * @brief Send out upload form for updates
- * @param server                    Send out instancce
+ * @param writer                    Send out instancce
  * @param globalDataController      Access to global data
  */
-void WebserverMemoryVariables::sendUpdateForm(ESP8266WebServer *server, GlobalDataController *globalDataController) {
-    server->sendContent(FPSTR(UPDATE_FORM));
+void WebserverMemoryVariables::sendUpdateForm(WebserverResponseWriter *writer, GlobalDataController *globalDataController) {
+    writer->print(FPSTR(UPDATE_FORM));
 }
 
 /**
  * @brief Send out configuration for weather
- * @param server                    Send out instancce
+ * @param writer                    Send out instancce
  * @param globalDataController      Access to global data
  */
-void WebserverMemoryVariables::sendWeatherConfigForm(ESP8266WebServer *server, GlobalDataController *globalDataController) {    
-    server->sendContent(FPSTR(WEATHER_FORM_START));
+void WebserverMemoryVariables::sendWeatherConfigForm(WebserverResponseWriter *writer, GlobalDataController *globalDataController) {    
+    writer->print(FPSTR(WEATHER_FORM_START));
     WebserverMemoryVariables::sendFormCheckbox(
-        server,
+        writer,
         FPSTR(WEATHER_FORM1_ID),
         globalDataController->getWeatherSettings()->show,
         FPSTR(WEATHER_FORM1_LABEL),
@@ -365,7 +417,7 @@ void WebserverMemoryVariables::sendWeatherConfigForm(ESP8266WebServer *server, G
         ""
     );
     WebserverMemoryVariables::sendFormCheckbox(
-        server,
+        writer,
         FPSTR(WEATHER_FORM2_ID),
         globalDataController->getWeatherSettings()->isMetric,
         FPSTR(WEATHER_FORM2_LABEL_ON),
@@ -374,7 +426,7 @@ void WebserverMemoryVariables::sendWeatherConfigForm(ESP8266WebServer *server, G
         ""
     );
     WebserverMemoryVariables::sendFormInput(
-        server,
+        writer,
         FPSTR(WEATHER_FORM3_ID),
         FPSTR(WEATHER_FORM3_LABEL),
         globalDataController->getWeatherSettings()->apiKey,
@@ -386,9 +438,9 @@ void WebserverMemoryVariables::sendWeatherConfigForm(ESP8266WebServer *server, G
         ""
     );
     WebserverMemoryVariables::sendFormInput(
-        server,
+        writer,
         FPSTR(WEATHER_FORM4_ID),
-        globalDataController->getWeatherClient()->getCity(0) + FPSTR(WEATHER_FORM4_LABEL),
+        String(globalDataController->getWeatherClient()->getCity(0)) + FPSTR(WEATHER_FORM4_LABEL),
         String(globalDataController->getWeatherSettings()->cityId),
         "",
         120,
@@ -398,42 +450,29 @@ void WebserverMemoryVariables::sendWeatherConfigForm(ESP8266WebServer *server, G
         ""
     );
     WebserverMemoryVariables::sendFormSelect(
-        server,
+        writer,
         FPSTR(WEATHER_FORM5_ID),
         FPSTR(WEATHER_FORM5_LABEL),
         String(globalDataController->getWeatherSettings()->lang),
         "",
-        FPSTR(WEATHER_FORM5_OPTIONS),
+        WEATHER_FORM5_OPTIONS,
         true,
         ""
     );
-    WebserverMemoryVariables::sendFormSubmitButton(server, true);
-    server->sendContent(FPSTR(WEATHER_FORM_END));
+    WebserverMemoryVariables::sendFormSubmitButton(writer, true);
+    writer->print(FPSTR(WEATHER_FORM_END));
 }
 
 /**
  * @brief Send out configuration for sensor
- * @param server                    Send out instancce
+ * @param writer                    Send out instancce
  * @param globalDataController      Access to global data
  */
-void WebserverMemoryVariables::sendSensorConfigForm(ESP8266WebServer *server, GlobalDataController *globalDataController) {
-    server->sendContent(FPSTR(SENSOR_CONFIG_FORM_START));
-
-    String optionData = "";
-    BaseSensorClient** sensorInstances = globalDataController->getRegisteredSensorClients();
-    for (int i=0; i<globalDataController->getRegisteredSensorClientsNum(); i++) {
-        if (sensorInstances[i] == NULL) {
-            continue;
-        }
-        optionData += "<option class='bx--select-option' value='" + String(i) + "'";
-        if (i == globalDataController->getSensorSettings()->sensType) {
-            optionData += " selected";
-        }
-        optionData += ">" + sensorInstances[i]->getType() + "</option>";
-    }  
+void WebserverMemoryVariables::sendSensorConfigForm(WebserverResponseWriter *writer, GlobalDataController *globalDataController) {
+    writer->print(FPSTR(SENSOR_CONFIG_FORM_START));
 
     WebserverMemoryVariables::sendFormCheckboxEvent(
-        server,
+        writer,
         FPSTR(SENSOR_CONFIG_FORM1_ID),
         globalDataController->getSensorSettings()->activated,
         FPSTR(SENSOR_CONFIG_FORM1_LABEL),
@@ -443,7 +482,7 @@ void WebserverMemoryVariables::sendSensorConfigForm(ESP8266WebServer *server, Gl
     );
     WebserverMemoryVariables::rowExtraClass = "data-sh='sens'";
     WebserverMemoryVariables::sendFormCheckbox(
-        server,
+        writer,
         FPSTR(SENSOR_CONFIG_FORM2_ID),
         globalDataController->getSensorSettings()->showOnDisplay,
         FPSTR(SENSOR_CONFIG_FORM2_LABEL),
@@ -452,48 +491,61 @@ void WebserverMemoryVariables::sendSensorConfigForm(ESP8266WebServer *server, Gl
     );
     WebserverMemoryVariables::rowExtraClass = "data-sh='sens'";
     WebserverMemoryVariables::sendFormSelect(
-        server,
+        writer,
         FPSTR(SENSOR_CONFIG_FORM3_ID),
         FPSTR(SENSOR_CONFIG_FORM3_LABEL),
         "",
         "",
-        optionData,
+        [&]() {
+            BaseSensorClient** sensorInstances = globalDataController->getRegisteredSensorClients();
+            for (int i=0; i<globalDataController->getRegisteredSensorClientsNum(); i++) {
+                if (sensorInstances[i] != NULL) {
+                    WebserverMemoryVariables::sendSelectOption(
+                        writer,
+                        i,
+                        i == globalDataController->getSensorSettings()->sensType,
+                        "",
+                        sensorInstances[i]->getType()
+                    );
+                }
+            }
+        },
         true,
         ""
     );
 
-    WebserverMemoryVariables::sendFormSubmitButton(server, true);
-    server->sendContent(FPSTR(SENSOR_CONFIG_FORM_END));
+    WebserverMemoryVariables::sendFormSubmitButton(writer, true);
+    writer->print(FPSTR(SENSOR_CONFIG_FORM_END));
 }
 
 /**
  * @brief Send out configuration for display
- * @param server                    Send out instancce
+ * @param writer                    Send out instancce
  * @param globalDataController      Access to global data
  */
-void WebserverMemoryVariables::sendDisplayConfigForm(ESP8266WebServer *server, GlobalDataController *globalDataController) {
-    server->sendContent(FPSTR(DISPLAY_CONFIG_FORM_START));
-
-    String optionData = "";
-    BaseDisplayClient** displayInstances = globalDataController->getRegisteredDisplayClients();
-    for (int i=0; i<globalDataController->getRegisteredDisplayClientsNum(); i++) {
-        if (displayInstances[i] == NULL) {
-            continue;
-        }
-        optionData += "<option class='bx--select-option' value='" + String(i) + "'";
-        if (i == globalDataController->getDisplaySettings()->displayType) {
-            optionData += " selected";
-        }
-        optionData += ">" + displayInstances[i]->getType() + "</option>";
-    } 
+void WebserverMemoryVariables::sendDisplayConfigForm(WebserverResponseWriter *writer, GlobalDataController *globalDataController) {
+    writer->print(FPSTR(DISPLAY_CONFIG_FORM_START));
 
     WebserverMemoryVariables::sendFormSelect(
-        server,
+        writer,
         FPSTR(DISPLAY_CONFIG_FORM1_ID),
         FPSTR(DISPLAY_CONFIG_FORM1_LABEL),
         "",
         "onchange=\"if(this.selectedIndex != undefined){var e=document.getElementById('" + String(FPSTR(DISPLAY_CONFIG_FORM1_ID)) + "');var val=e.value;if(val==0){showhideDir('oled',false);showhideDir('nextion',true);}else{showhideDir('oled',true);showhideDir('nextion',false);}}\"",
-        optionData,
+        [&]() {
+            BaseDisplayClient** displayInstances = globalDataController->getRegisteredDisplayClients();
+            for (int i=0; i<globalDataController->getRegisteredDisplayClientsNum(); i++) {
+                if (displayInstances[i] != NULL) {
+                    WebserverMemoryVariables::sendSelectOption(
+                        writer,
+                        i,
+                        i == globalDataController->getDisplaySettings()->displayType,
+                        "",
+                        displayInstances[i]->getType()
+                    );
+                }
+            }
+        },
         true,
         ""
     );
@@ -501,7 +553,7 @@ void WebserverMemoryVariables::sendDisplayConfigForm(ESP8266WebServer *server, G
     // Oled configurations
     WebserverMemoryVariables::rowExtraClass = "data-sh='oled'";
     WebserverMemoryVariables::sendFormCheckbox(
-        server,
+        writer,
         FPSTR(DISPLAY_CONFIG_FORM2_ID),
         globalDataController->getDisplaySettings()->invertDisplay,
         FPSTR(DISPLAY_CONFIG_FORM2_LABEL),
@@ -512,7 +564,7 @@ void WebserverMemoryVariables::sendDisplayConfigForm(ESP8266WebServer *server, G
     // Nextion configutations
     WebserverMemoryVariables::rowExtraClass = "data-sh='nextion'";
     WebserverMemoryVariables::sendFormCheckbox(
-        server,
+        writer,
         FPSTR(DISPLAY_CONFIG_FORM3_ID),
         globalDataController->getDisplaySettings()->showWeatherSensorSplited,
         FPSTR(DISPLAY_CONFIG_FORM3_LABEL),
@@ -522,7 +574,7 @@ void WebserverMemoryVariables::sendDisplayConfigForm(ESP8266WebServer *server, G
 
     WebserverMemoryVariables::rowExtraClass = "data-sh='nextion'";
     WebserverMemoryVariables::sendFormCheckbox(
-        server,
+        writer,
         FPSTR(DISPLAY_CONFIG_FORM4_ID),
         globalDataController->getDisplaySettings()->automaticSwitchEnabled,
         FPSTR(DISPLAY_CONFIG_FORM4_LABEL),
@@ -532,7 +584,7 @@ void WebserverMemoryVariables::sendDisplayConfigForm(ESP8266WebServer *server, G
 
     WebserverMemoryVariables::rowExtraClass = "data-sh='nextion'";
     WebserverMemoryVariables::sendFormCheckbox(
-        server,
+        writer,
         FPSTR(DISPLAY_CONFIG_FORM5_ID),
         globalDataController->getDisplaySettings()->automaticSwitchActiveOnlyEnabled,
         FPSTR(DISPLAY_CONFIG_FORM5_LABEL),
@@ -542,7 +594,7 @@ void WebserverMemoryVariables::sendDisplayConfigForm(ESP8266WebServer *server, G
 
     WebserverMemoryVariables::rowExtraClass = "data-sh='nextion'";
     WebserverMemoryVariables::sendFormInput(
-        server,
+        writer,
         FPSTR(DISPLAY_CONFIG_FORM6_ID),
         FPSTR(DISPLAY_CONFIG_FORM6_LABEL),
         String(globalDataController->getDisplaySettings()->automaticSwitchDelay/1000),
@@ -556,7 +608,7 @@ void WebserverMemoryVariables::sendDisplayConfigForm(ESP8266WebServer *server, G
 
     WebserverMemoryVariables::rowExtraClass = "data-sh='nextion'";
     WebserverMemoryVariables::sendFormInput(
-        server,
+        writer,
         FPSTR(DISPLAY_CONFIG_FORM7_ID),
         FPSTR(DISPLAY_CONFIG_FORM7_LABEL),
         String(globalDataController->getDisplaySettings()->automaticInactiveOff),
@@ -568,19 +620,19 @@ void WebserverMemoryVariables::sendDisplayConfigForm(ESP8266WebServer *server, G
         ""
     );
 
-    WebserverMemoryVariables::sendFormSubmitButton(server, true);
-    server->sendContent(FPSTR(DISPLAY_CONFIG_FORM_END));
+    WebserverMemoryVariables::sendFormSubmitButton(writer, true);
+    writer->print(FPSTR(DISPLAY_CONFIG_FORM_END));
 }
 
 /**
  * @brief Send out configuration for station
- * @param server                    Send out instancce
+ * @param writer                    Send out instancce
  * @param globalDataController      Access to global data
  */
-void WebserverMemoryVariables::sendStationConfigForm(ESP8266WebServer *server, GlobalDataController *globalDataController) {
-    server->sendContent(FPSTR(STATION_CONFIG_FORM_START));
+void WebserverMemoryVariables::sendStationConfigForm(WebserverResponseWriter *writer, GlobalDataController *globalDataController) {
+    writer->print(FPSTR(STATION_CONFIG_FORM_START));
     WebserverMemoryVariables::sendFormCheckbox(
-        server,
+        writer,
         FPSTR(STATION_CONFIG_FORM1_ID),
         globalDataController->getClockSettings()->show,
         FPSTR(STATION_CONFIG_FORM1_LABEL),
@@ -588,7 +640,7 @@ void WebserverMemoryVariables::sendStationConfigForm(ESP8266WebServer *server, G
         ""
     );
     WebserverMemoryVariables::sendFormCheckbox(
-        server,
+        writer,
         FPSTR(STATION_CONFIG_FORM2_ID),
         globalDataController->getClockSettings()->is24h,
         FPSTR(STATION_CONFIG_FORM2_LABEL),
@@ -596,7 +648,7 @@ void WebserverMemoryVariables::sendStationConfigForm(ESP8266WebServer *server, G
         ""
     );
     WebserverMemoryVariables::sendFormCheckbox(
-        server,
+        writer,
         FPSTR(STATION_CONFIG_FORM4_ID),
         globalDataController->getSystemSettings()->useLedFlash,
         FPSTR(STATION_CONFIG_FORM4_LABEL),
@@ -604,27 +656,27 @@ void WebserverMemoryVariables::sendStationConfigForm(ESP8266WebServer *server, G
         ""
     );
     WebserverMemoryVariables::sendFormSelect(
-        server,
+        writer,
         FPSTR(STATION_CONFIG_FORM5_ID),
         FPSTR(STATION_CONFIG_FORM5_LABEL),
         String(globalDataController->getSystemSettings()->clockWeatherResyncMinutes),
         "",
-        FPSTR(STATION_CONFIG_FORM5_OPTIONS),
+        STATION_CONFIG_FORM5_OPTIONS,
         true,
         ""
     );
     WebserverMemoryVariables::sendFormSelect(
-        server,
+        writer,
         FPSTR(STATION_CONFIG_FORM6_ID),
         FPSTR(STATION_CONFIG_FORM6_LABEL),
         String(globalDataController->getClockSettings()->utcOffset) + "|" + globalDataController->getClockSettings()->timezoneHash,
         "",
-        "",
+        PSTR(""),
         true,
         ""
     );
     WebserverMemoryVariables::sendFormCheckboxEvent(
-        server,
+        writer,
         FPSTR(STATION_CONFIG_FORM7_ID),
         globalDataController->getSystemSettings()->hasBasicAuth,
         FPSTR(STATION_CONFIG_FORM7_LABEL),
@@ -634,7 +686,7 @@ void WebserverMemoryVariables::sendStationConfigForm(ESP8266WebServer *server, G
     );
     WebserverMemoryVariables::rowExtraClass = "data-sh='uspw'";
     WebserverMemoryVariables::sendFormInput(
-        server,
+        writer,
         FPSTR(STATION_CONFIG_FORM8_ID),
         FPSTR(STATION_CONFIG_FORM8_LABEL),
         globalDataController->getSystemSettings()->webserverUsername,
@@ -647,7 +699,7 @@ void WebserverMemoryVariables::sendStationConfigForm(ESP8266WebServer *server, G
     );
     WebserverMemoryVariables::rowExtraClass = "data-sh='uspw'";
     WebserverMemoryVariables::sendFormInput(
-        server,
+        writer,
         FPSTR(STATION_CONFIG_FORM9_ID),
         FPSTR(STATION_CONFIG_FORM9_LABEL),
         globalDataController->getSystemSettings()->webserverPassword,
@@ -658,198 +710,223 @@ void WebserverMemoryVariables::sendStationConfigForm(ESP8266WebServer *server, G
         true,
         ""
     );
-    WebserverMemoryVariables::sendFormSubmitButton(server, true);
-    server->sendContent(FPSTR(STATION_CONFIG_FORM_END));
+    WebserverMemoryVariables::sendFormSubmitButton(writer, true);
+    writer->print(FPSTR(STATION_CONFIG_FORM_END));
 }
 
 /**
  * @brief Send out configuration for printer
- * @param server                    Send out instancce
+ * @param writer                    Send out instancce
  * @param globalDataController      Access to global data
  */
-void WebserverMemoryVariables::sendPrinterConfigForm(ESP8266WebServer *server, GlobalDataController *globalDataController) {   
+void WebserverMemoryVariables::sendPrinterConfigForm(WebserverResponseWriter *writer, GlobalDataController *globalDataController) {   
     int totalPrinters = globalDataController->getNumPrinters();
     PrinterDataStruct *printerConfigs = globalDataController->getPrinterSettings();
 
     // Show all errors if printers have one
     for(int i=0; i<totalPrinters; i++) {
         if (printerConfigs[i].state == PRINTER_STATE_ERROR) {
-            String errorBlock = FPSTR(HEADER_BLOCK_ERROR);
-            errorBlock.replace("%ERRORMSG%", "[" + String(printerConfigs[i].customName) + "] " + String(printerConfigs[i].error));
-            server->sendContent(errorBlock);
+            WebserverTemplate::send(writer, HEADER_BLOCK_ERROR, [&](const char *token) {
+                writer->print("[");
+                WebserverTemplate::sendText(writer, printerConfigs[i].customName);
+                writer->print("] ");
+                WebserverTemplate::sendText(writer, printerConfigs[i].error);
+            });
         }
     }
 
     // Show printers
-    server->sendContent(FPSTR(CONFPRINTER_FORM_START));
+    writer->print(FPSTR(CONFPRINTER_FORM_START));
     for(int i=0; i<totalPrinters; i++) {
-        String printerEntryRow = FPSTR(CONFPRINTER_FORM_ROW);
-        printerEntryRow.replace("%ID%", String(i+1));
-        printerEntryRow.replace("%NAME%", String(printerConfigs[i].customName));
-        printerEntryRow.replace("%TYPE%", globalDataController->getPrinterClientType(&printerConfigs[i]));
-
-        String state = FPSTR(CONFPRINTER_FORM_ROW_OK);
-        if ((printerConfigs[i].state == PRINTER_STATE_OFFLINE) || (printerConfigs[i].state == PRINTER_STATE_ERROR)) {
-            state = FPSTR(CONFPRINTER_FORM_ROW_ERROR);
-        }
-        state.replace("%STATUS%", globalDataController->getPrinterStateAsText(&printerConfigs[i]));
-        printerEntryRow.replace("%STATE%", state);
-        server->sendContent(printerEntryRow);
+        WebserverTemplate::send(writer, CONFPRINTER_FORM_ROW, [&](const char *token) {
+            if (strcmp(token, "ID") == 0) {
+                writer->print(String(i + 1));
+            } else if (strcmp(token, "NAME") == 0) {
+                WebserverTemplate::sendText(writer, printerConfigs[i].customName);
+            } else if (strcmp(token, "TYPE") == 0) {
+                WebserverTemplate::sendText(writer, globalDataController->getViewModel()->getPrinter(i)->clientType);
+            } else if (strcmp(token, "STATE") == 0) {
+                PGM_P stateTemplate = CONFPRINTER_FORM_ROW_OK;
+                if ((printerConfigs[i].state == PRINTER_STATE_OFFLINE) || (printerConfigs[i].state == PRINTER_STATE_ERROR)) {
+                    stateTemplate = CONFPRINTER_FORM_ROW_ERROR;
+                }
+                WebserverTemplate::send(writer, stateTemplate, [&](const char *token) {
+                    WebserverTemplate::sendText(writer, ViewFormatter::getPrinterStateAsText(printerConfigs[i].state));
+                });
+            }
+        });
     }
 
-    // Generate all modals
-    for(int i=0; i<totalPrinters; i++) {
-        WebserverMemoryVariables::sendPrinterConfigFormAEModal(server, i + 1, &printerConfigs[i], globalDataController);
-        String textForDelete = FPSTR(GLOBAL_TEXT_CDPRINTER);
-        textForDelete.replace("%PRINTERNAME%", String(printerConfigs[i].customName));
-        WebserverMemoryVariables::sendModalDanger(
-            server,
-            "deletePrinterModal-" + String(i + 1),
-            FPSTR(GLOBAL_TEXT_WARNING),
-            FPSTR(GLOBAL_TEXT_TDPRINTER),
-            textForDelete,
-            FPSTR(GLOBAL_TEXT_ABORT),
-            FPSTR(GLOBAL_TEXT_DELETE),
-            "onclick='openUrl(\"/configureprinter/delete?id=" + String(i + 1) + "\")'"
-        );
-    }
-    WebserverMemoryVariables::sendPrinterConfigFormAEModal(server, 0, NULL, globalDataController);
-    server->sendContent(FPSTR(CONFPRINTER_FORM_END));
+    // Single add/edit and delete modal, printer values are loaded on demand by editPrinter()/deletePrinter()
+    WebserverMemoryVariables::sendPrinterConfigFormAEModal(writer, globalDataController);
+    String textForDelete = FPSTR(GLOBAL_TEXT_CDPRINTER);
+    textForDelete.replace("%PRINTERNAME%", "<span data-pname></span>");
+    WebserverMemoryVariables::sendModalDanger(
+        writer,
+        "deletePrinterModal",
+        FPSTR(GLOBAL_TEXT_WARNING),
+        FPSTR(GLOBAL_TEXT_TDPRINTER),
+        textForDelete,
+        FPSTR(GLOBAL_TEXT_ABORT),
+        FPSTR(GLOBAL_TEXT_DELETE),
+        "onclick='openUrl(\"/configureprinter/delete?id=\" + $(\"#deletePrinterModal\").data(\"pid\"))'"
+    );
+    writer->print(FPSTR(CONFPRINTER_FORM_END));
 } 
 
 /**
- * @brief Modal for printer edit/add
+ * @brief Modal for printer edit/add, filled with defaults for a new printer.
+ * Values of an existing printer are requested from /configureprinter/get when the modal is opened.
  * 
- * @param server 
- * @param id 
- * @param forPrinter 
+ * @param writer 
  * @param globalDataController      Access to global data
  */
-void WebserverMemoryVariables::sendPrinterConfigFormAEModal(ESP8266WebServer *server, int id, PrinterDataStruct *forPrinter, GlobalDataController *globalDataController) {
+void WebserverMemoryVariables::sendPrinterConfigFormAEModal(WebserverResponseWriter *writer, GlobalDataController *globalDataController) {
     
-    String modalData = FPSTR(CONFPRINTER_FORM_ADDEDIT_START);
-    modalData.replace("%ID%", String(id));
-    if (id == 0) {
-        modalData.replace("%TITLE%", FPSTR(CONFPRINTER_FORM_ADDEDIT_TA));
-    } else {
-        modalData.replace("%TITLE%", FPSTR(CONFPRINTER_FORM_ADDEDIT_TE));
-    }
-    server->sendContent(modalData);
-    
-    String optionData = "";
-    BasePrinterClient** printerInstances = globalDataController->getRegisteredPrinterClients();
-    for (int i=0; i<globalDataController->getRegisteredPrinterClientsNum(); i++) {
-        if (printerInstances[i] == NULL) {
-            continue;
-        }
-        optionData += "<option class='bx--select-option' value='" + String(i) + "'";
-        
-        if (printerInstances[i]->clientNeedApiKey()) {
-            optionData += " data-need-api='true'";
+    String modalId = "0";
+    WebserverTemplate::send(writer, CONFPRINTER_FORM_ADDEDIT_START, [&](const char *token) {
+        if (strcmp(token, "ID") == 0) {
+            writer->print(modalId);
+        } else if ((strcmp(token, "TITLE") == 0) || (strcmp(token, "TITLEADD") == 0)) {
+            writer->print(FPSTR(CONFPRINTER_FORM_ADDEDIT_TA));
+        } else if (strcmp(token, "TITLEEDIT") == 0) {
+            writer->print(FPSTR(CONFPRINTER_FORM_ADDEDIT_TE));
         }
-        if ((forPrinter != NULL) && (forPrinter->apiType == i)) {
-            optionData += " selected='selected'";
-        }
-        optionData += ">" + printerInstances[i]->getClientType() + "</option>";
-    }
+    });
     
     WebserverMemoryVariables::sendFormInput(
-        server,
+        writer,
         FPSTR(CONFPRINTER_FORM_ADDEDIT1_ID),
         FPSTR(CONFPRINTER_FORM_ADDEDIT1_LABEL),
-        id > 0 ? String(forPrinter->customName) : "",
+        "",
         FPSTR(CONFPRINTER_FORM_ADDEDIT1_PH),
         20,
         "",
         false,
         false,
-        String(id)
+        modalId
     );
     WebserverMemoryVariables::sendFormSelect(
-        server,
+        writer,
         FPSTR(CONFPRINTER_FORM_ADDEDIT2_ID),
         FPSTR(CONFPRINTER_FORM_ADDEDIT2_LABEL),
         "",
-        "onchange='apiTypeSelect(\"" + String(FPSTR(CONFPRINTER_FORM_ADDEDIT2_ID)) + "\", \"apacapi-" + String(id) + "\")'",
-        optionData,
+        "onchange='apiTypeSelect(\"" + String(FPSTR(CONFPRINTER_FORM_ADDEDIT2_ID)) + "-" + modalId + "\", \"apacapi-" + modalId + "\")'",
+        [&]() {
+            BasePrinterClient** printerInstances = globalDataController->getRegisteredPrinterClients();
+            for (int i=0; i<globalDataController->getRegisteredPrinterClientsNum(); i++) {
+                if (printerInstances[i] != NULL) {
+                    WebserverMemoryVariables::sendSelectOption(
+                        writer,
+                        i,
+                        false,
+                        printerInstances[i]->clientNeedApiKey() ? "data-need-api='true'" : "",
+                        printerInstances[i]->getClientType()
+                    );
+                }
+            }
+        },
         false,
-        String(id)
+        modalId
     );
-    WebserverMemoryVariables::rowExtraClass = "data-sh='apacapi-" + String(id) + "'";
+    WebserverMemoryVariables::rowExtraClass = "data-sh='apacapi-" + modalId + "'";
     WebserverMemoryVariables::sendFormInput(
-        server,
+        writer,
         FPSTR(CONFPRINTER_FORM_ADDEDIT3_ID),
         FPSTR(CONFPRINTER_FORM_ADDEDIT3_LABEL),
-        id > 0 ? String(forPrinter->apiKey) : "",
+        "",
         FPSTR(CONFPRINTER_FORM_ADDEDIT3_PH),
         60,
         "",
         false,
         false,
-        String(id)
+        modalId
     );
     WebserverMemoryVariables::sendFormInput(
-        server,
+        writer,
         FPSTR(CONFPRINTER_FORM_ADDEDIT4_ID),
         FPSTR(CONFPRINTER_FORM_ADDEDIT4_LABEL),
-        id > 0 ? String(forPrinter->remoteAddress) : "",
+        "",
         FPSTR(CONFPRINTER_FORM_ADDEDIT4_PH),
         60,
         "",
         false,
         false,
-        String(id)
+        modalId
     );
     WebserverMemoryVariables::sendFormInput(
-        server,
+        writer,
         FPSTR(CONFPRINTER_FORM_ADDEDIT5_ID),
         FPSTR(CONFPRINTER_FORM_ADDEDIT5_LABEL),
-        id > 0 ? String(forPrinter->remotePort) : "80",
+        "80",
         "",
         5,
         "onkeypress='return isNumberKey(event)'",
         false,
         false,
-        String(id)
+        modalId
     );
     WebserverMemoryVariables::sendFormCheckboxEvent(
-        server,
+        writer,
         FPSTR(CONFPRINTER_FORM_ADDEDIT6_ID),
-        id > 0 ? forPrinter->basicAuthNeeded : true,
+        true,
         FPSTR(CONFPRINTER_FORM_ADDEDIT6_LABEL),
-        "showhide('" + String(FPSTR(CONFPRINTER_FORM_ADDEDIT6_ID)) + "-" + String(id) + "', 'apac-" + String(id) + "')",
+        "showhide('" + String(FPSTR(CONFPRINTER_FORM_ADDEDIT6_ID)) + "-" + modalId + "', 'apac-" + modalId + "')",
         false,
-        String(id)
+        modalId
     );
-    WebserverMemoryVariables::rowExtraClass = "data-sh='apac-" + String(id) + "'";
+    WebserverMemoryVariables::rowExtraClass = "data-sh='apac-" + modalId + "'";
     WebserverMemoryVariables::sendFormInput(
-        server,
-        FPSTR(STATION_CONFIG_FORM7_ID),
-        FPSTR(STATION_CONFIG_FORM7_LABEL),
-        id > 0 ? String(forPrinter->basicAuthUsername) : "",
+        writer,
+        FPSTR(CONFPRINTER_FORM_ADDEDIT7_ID),
+        FPSTR(CONFPRINTER_FORM_ADDEDIT7_LABEL),
+        "",
         FPSTR(CONFPRINTER_FORM_ADDEDIT7_PH),
         30,
         "",
         false,
         false,
-        String(id)
+        modalId
     );
-    WebserverMemoryVariables::rowExtraClass = "data-sh='apac-" + String(id) + "'";
+    WebserverMemoryVariables::rowExtraClass = "data-sh='apac-" + modalId + "'";
     WebserverMemoryVariables::sendFormInput(
-        server,
-        FPSTR(STATION_CONFIG_FORM8_ID),
-        FPSTR(STATION_CONFIG_FORM8_LABEL),
-        id > 0 ? String(forPrinter->basicAuthPassword) : "",
+        writer,
+        FPSTR(CONFPRINTER_FORM_ADDEDIT8_ID),
+        FPSTR(CONFPRINTER_FORM_ADDEDIT8_LABEL),
+        "",
         FPSTR(CONFPRINTER_FORM_ADDEDIT8_PH),
         120,
         "",
         true,
         false,
-        String(id)
+        modalId
     );
-    modalData = FPSTR(CONFPRINTER_FORM_ADDEDIT_END);
-    modalData.replace("%ID%", String(id));
-    server->sendContent(modalData);
+    WebserverTemplate::send(writer, CONFPRINTER_FORM_ADDEDIT_END, [&](const char *token) {
+        writer->print(modalId);
+    });
+}
+
+/**
+ * @brief Send out a single option of a select
+ * @param writer                    Send out instancce
+ * @param value                     Value of option
+ * @param isSelected                True if option is preselected
+ * @param attributes                Additional attributes
+ * @param text                      Text of option
+ */
+void WebserverMemoryVariables::sendSelectOption(WebserverResponseWriter *writer, int value, bool isSelected, const char *attributes, String text) {
+    WebserverTemplate::send(writer, FORM_ITEM_SELECT_OPTION, [&](const char *token) {
+        if (strcmp(token, "VALUE") == 0) {
+            writer->print(String(value));
+        } else if (strcmp(token, "ATTRIBUTES") == 0) {
+            WebserverTemplate::sendText(writer, attributes);
+            if (isSelected) {
+                writer->print(" selected");
+            }
+        } else if (strcmp(token, "TEXT") == 0) {
+            WebserverTemplate::sendText(writer, text);
+        }
+    });
 }
 
 
@@ -876,32 +953,32 @@ void WebserverMemoryVariables::sendPrinterConfigFormAEModal(ESP8266WebServer *se
 
 /**
  * @brief Send out an single checkbox form row
- * @param server                    Send out instancce
+ * @param writer                    Send out instancce
  * @param formId                    Form id/name
  * @param isChecked                 Checkbox checked
  * @param label                     Text for activated/deactivated
  * @param inRow                     Extend the field with row div
  */
-void WebserverMemoryVariables::sendFormCheckbox(ESP8266WebServer *server, String formId, bool isChecked, String label, bool inRow, String uniqueId = "") {
-    WebserverMemoryVariables::sendFormCheckboxEvent(server, formId, isChecked, label, "", inRow, uniqueId);
+void WebserverMemoryVariables::sendFormCheckbox(WebserverResponseWriter *writer, String formId, bool isChecked, String label, bool inRow, String uniqueId = "") {
+    WebserverMemoryVariables::sendFormCheckboxEvent(writer, formId, isChecked, label, "", inRow, uniqueId);
 }
 
 /**
  * @brief Send out an single checkbox form row
- * @param server                    Send out instancce
+ * @param writer                    Send out instancce
  * @param formId                    Form id/name
  * @param isChecked                 Checkbox checked
  * @param labelOn                   Text for activated
  * @param labelOff                  Text for deactivated
  * @param inRow                     Extend the field with row div
  */
-void WebserverMemoryVariables::sendFormCheckbox(ESP8266WebServer *server, String formId, bool isChecked, String labelOn, String labelOff, bool inRow, String uniqueId = "") {
-    WebserverMemoryVariables::sendFormCheckboxEvent(server, formId, isChecked, labelOn, labelOff, "", inRow, uniqueId);
+void WebserverMemoryVariables::sendFormCheckbox(WebserverResponseWriter *writer, String formId, bool isChecked, String labelOn, String labelOff, bool inRow, String uniqueId = "") {
+    WebserverMemoryVariables::sendFormCheckboxEvent(writer, formId, isChecked, labelOn, labelOff, "", inRow, uniqueId);
 }
 
 /**
  * @brief Send out an single checkbox form row with onChangeEvent
- * @param server                    Send out instancce
+ * @param writer                    Send out instancce
  * @param formId                    Form id/name
  * @param isChecked                 Checkbox checked
  * @param label                     Text for activated/deactivated
@@ -909,7 +986,7 @@ void WebserverMemoryVariables::sendFormCheckbox(ESP8266WebServer *server, String
  * @param inRow                     Extend the field with row div
  */
 void WebserverMemoryVariables::sendFormCheckboxEvent(
-    ESP8266WebServer *server,
+    WebserverResponseWriter *writer,
     String formId,
     bool isChecked,
     String label,
@@ -917,14 +994,21 @@ void WebserverMemoryVariables::sendFormCheckboxEvent(
     bool inRow,
     String uniqueId = ""
 ) {
-    String onAdd = FPSTR(FORM_ITEM_CHECKBOX_ON);
-    String offAdd = FPSTR(FORM_ITEM_CHECKBOX_OFF);
-    WebserverMemoryVariables::sendFormCheckboxEvent(server, formId, isChecked, label + onAdd, label + offAdd, onChange, inRow, uniqueId);
+    WebserverMemoryVariables::sendFormCheckboxEvent(
+        writer,
+        formId,
+        isChecked,
+        label + FPSTR(FORM_ITEM_CHECKBOX_ON),
+        label + FPSTR(FORM_ITEM_CHECKBOX_OFF),
+        onChange,
+        inRow,
+        uniqueId
+    );
 }
 
 /**
  * @brief Send out an single checkbox form row with onChangeEvent
- * @param server                    Send out instancce
+ * @param writer                    Send out instancce
  * @param formId                    Form id/name
  * @param isChecked                 Checkbox checked
  * @param labelOn                   Text for activated
@@ -933,7 +1017,7 @@ void WebserverMemoryVariables::sendFormCheckboxEvent(
  * @param inRow                     Extend the field with row div
  */
 void WebserverMemoryVariables::sendFormCheckboxEvent(
-    ESP8266WebServer *server,
+    WebserverResponseWriter *writer,
     String formId,
     bool isChecked,
     String labelOn,
@@ -942,27 +1026,25 @@ void WebserverMemoryVariables::sendFormCheckboxEvent(
     bool inRow,
     String uniqueId = ""
 ) {
-    String isCheckedText = "";
-    String onChangeText = "";
-    if (isChecked) {
-        isCheckedText = "checked='checked'";
-    }
-    if (onChange.length() > 0) {
-        onChangeText = "onchange=\"" + onChange + "\"";
-    }
-    String form = FPSTR(FORM_ITEM_CHECKBOX);
-    form.replace("%FORMID%", formId);
-    form.replace("%CHECKED%", isCheckedText);
-    form.replace("%LABELON%", labelOn);
-    form.replace("%LABELOFF%", labelOff);
-    form.replace("%ONCHANGE%", onChangeText);
-    WebserverMemoryVariables::sendForm(server, formId, form, inRow, uniqueId);
+    WebserverMemoryVariables::sendForm(writer, formId, FORM_ITEM_CHECKBOX, inRow, uniqueId, [&](const char *token) {
+        if ((strcmp(token, "CHECKED") == 0) && isChecked) {
+            writer->print("checked='checked'");
+        } else if (strcmp(token, "LABELON") == 0) {
+            WebserverTemplate::sendText(writer, labelOn);
+        } else if (strcmp(token, "LABELOFF") == 0) {
+            WebserverTemplate::sendText(writer, labelOff);
+        } else if ((strcmp(token, "ONCHANGE") == 0) && (onChange.length() > 0)) {
+            writer->print("onchange=\"");
+            writer->print(onChange);
+            writer->print("\"");
+        }
+    });
 }
 
 
 /**
  * @brief Send out an single input field form row
- * @param server                    Send out instancce
+ * @param writer                    Send out instancce
  * @param formId                    Form id/name
  * @param label                     Text for label head
  * @param value                     Value in field
@@ -974,7 +1056,7 @@ void WebserverMemoryVariables::sendFormCheckboxEvent(
  * @param uniqueId                  Unique key for ids
  */
 void WebserverMemoryVariables::sendFormInput(
-    ESP8266WebServer *server,
+    WebserverResponseWriter *writer,
     String formId,
     String label,
     String value,
@@ -985,133 +1067,161 @@ void WebserverMemoryVariables::sendFormInput(
     bool inRow,
     String uniqueId = ""
 ) {
-    String form = FPSTR(FORM_ITEM_INPUT);
-    form.replace("%FORMID%", formId);
-    form.replace("%LABEL%", label);
-    form.replace("%VALUE%", value);
-    form.replace("%MAXLEN%", String(maxLen));
-    form.replace("%EVENTS%", events);
-    form.replace("%PLACEHOLDER%", placeholder);
-    if (isPassword) {
-        form.replace("%FIELDTYPE%", "password");
-    }
-    else {
-        form.replace("%FIELDTYPE%", "text");
-    }
-    WebserverMemoryVariables::sendForm(server, formId, form, inRow, uniqueId);
+    WebserverMemoryVariables::sendForm(writer, formId, FORM_ITEM_INPUT, inRow, uniqueId, [&](const char *token) {
+        if (strcmp(token, "LABEL") == 0) {
+            WebserverTemplate::sendText(writer, label);
+        } else if (strcmp(token, "VALUE") == 0) {
+            WebserverTemplate::sendText(writer, value);
+        } else if (strcmp(token, "MAXLEN") == 0) {
+            writer->print(String(maxLen));
+        } else if (strcmp(token, "EVENTS") == 0) {
+            WebserverTemplate::sendText(writer, events);
+        } else if (strcmp(token, "PLACEHOLDER") == 0) {
+            WebserverTemplate::sendText(writer, placeholder);
+        } else if (strcmp(token, "FIELDTYPE") == 0) {
+            writer->print(isPassword ? "password" : "text");
+        }
+    });
 }
 
 /**
- * @brief Send out an single input field form row
- * @param server                    Send out instancce
+ * @brief Send out an single select form row with options from PROGMEM
+ * @param writer                    Send out instancce
  * @param formId                    Form id/name
  * @param label                     Text for label head
- * @param value                     Value in field
+ * @param value                     Value in field (text of option to preselect)
  * @param events                    Extra events for input field
+ * @param options                   Options in PROGMEM
  * @param inRow                     Extend the field with row div
  * @param uniqueId                  Unique key for ids
  */
 void WebserverMemoryVariables::sendFormSelect(
-    ESP8266WebServer *server,
+    WebserverResponseWriter *writer,
     String formId,
     String label,
     String value,
     String events,
-    String options,
+    PGM_P options,
     bool inRow,
     String uniqueId = ""
 ) {
-    String form = FPSTR(FORM_ITEM_SELECT_START);
-    form.replace("%FORMID%", formId);
-    form.replace("%LABEL%", label);
-    form.replace("%EVENTS%", events);
-    form.replace("%PRESELECTVAL%", value);
-
-    if ((options.length() > 0) && (value.length() > 0)) {
-        if (options.indexOf(">"+ value + "<") > 0) {
-            options.replace(
-                ">"+ value + "<",
-                " selected>" + String(value) + "<"
-            );
-        } else {
-            options.replace(
-                "value=\""+ value + "\"",
-                "value=\""+ value + "\" selected"
-            );
+    WebserverMemoryVariables::sendFormSelect(writer, formId, label, value, events, [&]() {
+        WebserverTemplate::sendOptions_P(writer, options, value);
+    }, inRow, uniqueId);
+}
+
+/**
+ * @brief Send out an single select form row
+ * @param writer                    Send out instancce
+ * @param formId                    Form id/name
+ * @param label                     Text for label head
+ * @param value                     Value for preselection on client side
+ * @param events                    Extra events for input field
+ * @param sendOptions               Sends all options (already with selection)
+ * @param inRow                     Extend the field with row div
+ * @param uniqueId                  Unique key for ids
+ */
+void WebserverMemoryVariables::sendFormSelect(
+    WebserverResponseWriter *writer,
+    String formId,
+    String label,
+    String value,
+    String events,
+    std::function<void()> sendOptions,
+    bool inRow,
+    String uniqueId = ""
+) {
+    WebserverMemoryVariables::sendForm(writer, formId, FORM_ITEM_SELECT, inRow, uniqueId, [&](const char *token) {
+        if (strcmp(token, "LABEL") == 0) {
+            WebserverTemplate::sendText(writer, label);
+        } else if (strcmp(token, "EVENTS") == 0) {
+            WebserverTemplate::sendText(writer, events);
+        } else if (strcmp(token, "PRESELECTVAL") == 0) {
+            WebserverTemplate::sendText(writer, value);
+        } else if (strcmp(token, "OPTIONS") == 0) {
+            sendOptions();
         }
-    }
-    
-    WebserverMemoryVariables::sendForm(
-        server,
-        formId,
-        form + options + FPSTR(FORM_ITEM_SELECT_END),
-        inRow,
-        uniqueId
-    );   
+    });
 }
 
 /**
  * @brief Send form out to client
  * 
- * @param server                    Send out instancce
+ * @param writer                    Send out instancce
  * @param formElement               Form element
  * @param inRow                     True if in row
  */
 void WebserverMemoryVariables::sendFormSubmitButton(
-    ESP8266WebServer *server,
+    WebserverResponseWriter *writer,
     bool inRow
 ) {
-    WebserverMemoryVariables::sendForm(
-        server,
-        "",
-        FPSTR(FORM_ITEM_SUBMIT),
-        inRow,
-        ""
-    );
+    WebserverMemoryVariables::sendForm(writer, "", FORM_ITEM_SUBMIT, inRow, "", [](const char *token) {});
 }
 
 /**
  * @brief Send form out to client
  * 
- * @param server                    Send out instance
+ * @param writer                    Send out instance
  * @param formId                    Form id/name
- * @param formElement               Form element
+ * @param formTemplate              Template of form element in PROGMEM
  * @param inRow                     True if in row
  * @param uniqueId                  Unique key for ids
+ * @param provider                  Values for all element specific placeholders
  */
 void WebserverMemoryVariables::sendForm(
-    ESP8266WebServer *server,
+    WebserverResponseWriter *writer,
     String formId,
-    String formElement,
+    PGM_P formTemplate,
     bool inRow,
-    String uniqueId
+    String uniqueId,
+    WebserverTemplateProvider provider
 ) {
-    if (uniqueId.length() > 0) {
-        formElement.replace("id='" + formId + "'", "id='" + formId + "-" + uniqueId + "'");
-        formElement.replace("for='" + formId + "'", "for='" + formId + "-"  + uniqueId + "'");
-        formElement.replace("\"" + formId + "\"", "\"" + formId + "-"  + uniqueId + "\"");
-    }
+    String extraClass = WebserverMemoryVariables::rowExtraClass;
+    WebserverMemoryVariables::rowExtraClass = "";
     if (inRow) {
-        String rowStartData = FPSTR(FORM_ITEM_ROW_START);
-        rowStartData.replace("%ROWEXTRACLASS%", WebserverMemoryVariables::rowExtraClass);
-        server->sendContent(rowStartData);
-        formElement.replace("%ROWEXT%", FPSTR(FORM_ITEM_ROW_EXT));
-        formElement.replace("%DIVEXTRACLASS%", "");
-    } else {
-        formElement.replace("%ROWEXT%", "");
-        formElement.replace("%DIVEXTRACLASS%", WebserverMemoryVariables::rowExtraClass);
+        WebserverMemoryVariables::sendRowStart(writer, extraClass);
     }
-    WebserverMemoryVariables::rowExtraClass = "";
-    server->sendContent(formElement);
+    WebserverTemplate::send(writer, formTemplate, [&](const char *token) {
+        if (strcmp(token, "FORMID") == 0) {
+            WebserverTemplate::sendText(writer, formId);
+        } else if (strcmp(token, "FORMUID") == 0) {
+            WebserverTemplate::sendText(writer, formId);
+            if (uniqueId.length() > 0) {
+                writer->print("-");
+                writer->print(uniqueId);
+            }
+        } else if (strcmp(token, "ROWEXT") == 0) {
+            if (inRow) {
+                writer->print(FPSTR(FORM_ITEM_ROW_EXT));
+            }
+        } else if (strcmp(token, "DIVEXTRACLASS") == 0) {
+            if (!inRow) {
+                WebserverTemplate::sendText(writer, extraClass);
+            }
+        } else {
+            provider(token);
+        }
+    });
     if (inRow) {
-        server->sendContent(FPSTR(FORM_ITEM_ROW_END));
+        writer->print(FPSTR(FORM_ITEM_ROW_END));
     }
 }
 
+/**
+ * @brief Send start of a row
+ * @param writer                    Send out instancce
+ * @param extraClass                Additional attributes for row
+ */
+void WebserverMemoryVariables::sendRowStart(WebserverResponseWriter *writer, String extraClass) {
+    WebserverTemplate::send(writer, FORM_ITEM_ROW_START, [&](const char *token) {
+        WebserverTemplate::sendText(writer, extraClass);
+    });
+}
+
 /**
  * @brief Send danger modal out to client
  * 
- * @param server                    Send out instancce
+ * @param writer                    Send out instancce
  * @param formId                    ID of element
  * @param label                     Label top
  * @param title                     Dialog title
@@ -1121,7 +1231,7 @@ void WebserverMemoryVariables::sendForm(
  * @param primActionEvent           Event of primary button
  */
 void WebserverMemoryVariables::sendModalDanger(
-    ESP8266WebServer *server,
+    WebserverResponseWriter *writer,
     String formId,
     String label,
     String title,
@@ -1130,14 +1240,22 @@ void WebserverMemoryVariables::sendModalDanger(
     String primActionTitle,
     String primActionEvent
 ) {
-    String modalDialog = FPSTR(MODAL_DANGER);
-    modalDialog.replace("%ID%", formId);
-    modalDialog.replace("%LABEL%", label);
-    modalDialog.replace("%HEADING%", title);
-    modalDialog.replace("%CONTENT%", content);
-    modalDialog.replace("%SECACTION%", secActionTitle);
-    modalDialog.replace("%MAINACTION%", primActionTitle);
-    modalDialog.replace("%MAINEVENT%", primActionEvent);
-    server->sendContent(modalDialog);
+    WebserverTemplate::send(writer, MODAL_DANGER, [&](const char *token) {
+        if (strcmp(token, "ID") == 0) {
+            WebserverTemplate::sendText(writer, formId);
+        } else if (strcmp(token, "LABEL") == 0) {
+            WebserverTemplate::sendText(writer, label);
+        } else if (strcmp(token, "HEADING") == 0) {
+            WebserverTemplate::sendText(writer, title);
+        } else if (strcmp(token, "CONTENT") == 0) {
+            WebserverTemplate::sendText(writer, content);
+        } else if (strcmp(token, "SECACTION") == 0) {
+            WebserverTemplate::sendText(writer, secActionTitle);
+        } else if (strcmp(token, "MAINACTION") == 0) {
+            WebserverTemplate::sendText(writer, primActionTitle);
+        } else if (strcmp(token, "MAINEVENT") == 0) {
+            WebserverTemplate::sendText(writer, primActionEvent);
+        }
+    });
 }
 
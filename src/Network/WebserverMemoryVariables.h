@@ -3,6 +3,10 @@
 #include <ESP8266WiFi.h>
 #include <ESP8266WebServer.h>
 #include "../Global/GlobalDataController.h"
+#include "WebserverAssets.h"
+#include "WebserverFragmentCache.h"
+#include "WebserverResponseWriter.h"
+#include "WebserverTemplate.h"
 
 /**
  * Webpage form items for reuse
@@ -12,8 +16,8 @@ static const char FORM_ITEM_ROW_EXT[] PROGMEM = "bx--col bx--col--auto";
 static const char FORM_ITEM_ROW_END[] PROGMEM = "</div>";
 
 static const char FORM_ITEM_CHECKBOX[] PROGMEM = "<div class='%ROWEXT% bx--form-item' %DIVEXTRACLASS%>"
-                        "<input class='bx--toggle-input bx--toggle-input--small' id='%FORMID%' type='checkbox' name='%FORMID%' %CHECKED% %ONCHANGE%>"
-                        "<label class='bx--toggle-input__label' for='%FORMID%'>"
+                        "<input class='bx--toggle-input bx--toggle-input--small' id='%FORMUID%' type='checkbox' name='%FORMID%' %CHECKED% %ONCHANGE%>"
+                        "<label class='bx--toggle-input__label' for='%FORMUID%'>"
                             "<span class='bx--toggle__switch'>"
                                 "<svg class='bx--toggle__check' width='6px' height='5px' viewBox='0 0 6 5'>"
                                     "<path d='M2.2 2.7L5 0 6 1 2.2 5 0 2.7 1 1.5z' />"
@@ -27,19 +31,22 @@ static const char FORM_ITEM_CHECKBOX_ON[] PROGMEM = " activated";
 static const char FORM_ITEM_CHECKBOX_OFF[] PROGMEM = " deactivated";
 
 static const char FORM_ITEM_INPUT[] PROGMEM = "<div class='%ROWEXT% bx--form-item' %DIVEXTRACLASS%>"
-                            "<label for='%FORMID%' class='bx--label'>%LABEL%</label>"
-                            "<input id='%FORMID%' type='%FIELDTYPE%' class='bx--text-input' placeholder='%PLACEHOLDER%' name='%FORMID%' value='%VALUE%' maxlength='%MAXLEN%' %EVENTS%>"
+                            "<label for='%FORMUID%' class='bx--label'>%LABEL%</label>"
+                            "<input id='%FORMUID%' type='%FIELDTYPE%' class='bx--text-input' placeholder='%PLACEHOLDER%' name='%FORMID%' value='%VALUE%' maxlength='%MAXLEN%' %EVENTS%>"
                         "</div>";
 
-static const char FORM_ITEM_SELECT_START[] PROGMEM = "<div class='bx--form-item bx--select %ROWEXT%' %DIVEXTRACLASS%>"
-                            "<label for='%FORMID%' class='bx--label'>%LABEL%</label>"
+static const char FORM_ITEM_SELECT[] PROGMEM = "<div class='bx--form-item bx--select %ROWEXT%' %DIVEXTRACLASS%>"
+                            "<label for='%FORMUID%' class='bx--label'>%LABEL%</label>"
                             "<div class='bx--select-input__wrapper'>"
-                                "<select id='%FORMID%' class='bx--select-input' name='%FORMID%' %EVENTS% data-preselect='%PRESELECTVAL%'>";
-static const char FORM_ITEM_SELECT_END[] PROGMEM = "</select>"
+                                "<select id='%FORMUID%' class='bx--select-input' name='%FORMID%' %EVENTS% data-preselect='%PRESELECTVAL%'>"
+                                    "%OPTIONS%"
+                                "</select>"
                                 "<svg focusable='false' preserveAspectRatio='xMidYMid meet' style='will-change: transform;' xmlns='http://www.w3.org/2000/svg' class='bx--select__arrow' width='10' height='6' viewBox='0 0 10 6' aria-hidden='true'><path d='M5 6L0 1 0.7 0.3 5 4.6 9.3 0.3 10 1z'></path></svg>"
                             "</div>"
                         "</div>";
 
+static const char FORM_ITEM_SELECT_OPTION[] PROGMEM = "<option class='bx--select-option' value='%VALUE%' %ATTRIBUTES%>%TEXT%</option>";
+
 static const char FORM_ITEM_SUBMIT[] PROGMEM = "<div class='bx--form-item %ROWEXT%' %DIVEXTRACLASS%>"
                         "<button class='bx--btn bx--btn--primary' type='submit'>Save</button>"
                     "</div>";
@@ -108,6 +115,21 @@ static const char MENUE_ITEMS[] PROGMEM =
         "<svg focusable='false' preserveAspectRatio='xMidYMid meet' xmlns='http://www.w3.org/2000/svg' fill='currentColor' width='16' height='16' viewBox='0 0 32 32' aria-hidden='true'><path d='M16,2A14,14,0,1,0,30,16,14,14,0,0,0,16,2Zm0,26A12,12,0,1,1,28,16,12,12,0,0,1,16,28Z'></path><circle cx='16' cy='23.5' r='1.5'></circle><path d='M17,8H15.5A4.49,4.49,0,0,0,11,12.5V13h2v-.5A2.5,2.5,0,0,1,15.5,10H17a2.5,2.5,0,0,1,0,5H15v4.5h2V17a4.5,4.5,0,0,0,0-9Z'></path></svg>"
     "</a></li>";
 
+/**
+ * Static assets, served gzipped from LittleFS (/www/...) or sent inline when the filesystem image has no assets.
+ * scripts/build_assets.py extracts all ASSET_* strings into data/www/ when building the filesystem image.
+ */
+static const char ASSET_APP_CSS[] PROGMEM = ".hidden{display:none} .bx--form-item{margin-bottom:20px} .bx--table-column-menu{width: 3.25rem} .menitem{padding:6px 1rem;font-size:.875rem;font-weight:600;line-height:1.29;letter-spacing:.16px;display:flex;justify-content:space-between;text-decoration:none;color:#c6c6c6} .pStateBar{width:100%;background-color:#ddd;margin:5px 0} .pStateBarD{height:20px;background-color:#24a148;text-align:center!important;font-size:13px!important;color:#ffffff;padding:4px 0} .pStateHr{border-top:1px solid #0043ce;margin: 5px 0}";
+
+static const char ASSET_APP_JS[] PROGMEM = "function showhide(a,b) {var e=$(\"[data-sh='\"+b+\"']\");var f=$(\"#\" + a);if (f.checked||f.prop('checked')){e.removeClass('hidden');}else{e.addClass('hidden');}}"
+        "function showhideDir(a,b) {var e=$(\"[data-sh='\"+a+\"']\");var f=$(\"#\" + a);if (b){e.removeClass('hidden');}else{e.addClass('hidden');}}"
+        "function openModal(refelementId){document.body.classList.add(\"bx--body--with-modal-open\");document.getElementById(refelementId).classList.add(\"is-visible\")} function closeModal(refelementId){document.getElementById(refelementId).classList.remove(\"is-visible\");document.body.classList.remove(\"bx--body--with-modal-open\")}"
+        "function isNumberKey(e){var h=e.which?e.which:event.keyCode;return!(h>31&&(h<48||h>57))}"
+        "function openUrl(e){window.location.assign(e)}"
+        "function apiTypeSelect(r,t){if($(\"#\"+r).find(\":selected\").data('need-api')){$(\"[data-sh='\"+t+\"']\").removeClass('hidden')}else{$(\"[data-sh='\"+t+\"']\").addClass('hidden')}}"
+        "function openSidebar(){document.getElementById('sidebar').classList.toggle('bx--header-panel--expanded');document.getElementById('chipinfo').classList.add('hidden');};function openChipInfo(){document.getElementById('sidebar').classList.remove('bx--header-panel--expanded');document.getElementById('chipinfo').classList.toggle('hidden');}"
+        "$(function(){$('form').on('submit',function(e){$('#pageloading').removeClass('hidden')});$(\"input[type='checkbox']\").trigger('change')})";
+
 /**
  * Basic header/footer blocks
  */
@@ -122,15 +144,12 @@ static const char HEADER_BLOCK2[] PROGMEM = "<link rel='stylesheet' href='https:
         "<link rel='stylesheet' href='https://cdn.jsdelivr.net/npm/open-weather-icons@0.0.8/dist/css/open-weather-icons.css'>"
         "<script src='https://ajax.googleapis.com/ajax/libs/jquery/3.5.1/jquery.min.js'></script>"
         "<script src='https://cdnjs.cloudflare.com/ajax/libs/moment.js/2.29.1/moment-with-locales.min.js' crossorigin='anonymous'></script>"
-        "<script src='https://cdnjs.cloudflare.com/ajax/libs/moment-timezone/0.5.32/moment-timezone-with-data.js' crossorigin='anonymous'></script>"
-        "<style>.hidden{display:none} .bx--form-item{margin-bottom:20px} .bx--table-column-menu{width: 3.25rem} .menitem{padding:6px 1rem;font-size:.875rem;font-weight:600;line-height:1.29;letter-spacing:.16px;display:flex;justify-content:space-between;text-decoration:none;color:#c6c6c6} .pStateBar{width:100%;background-color:#ddd;margin:5px 0} .pStateBarD{height:20px;background-color:#24a148;text-align:center!important;font-size:13px!important;color:#ffffff;padding:4px 0} .pStateHr{border-top:1px solid #0043ce;margin: 5px 0}</style>"
-        "<script>function showhide(a,b) {var e=$(\"[data-sh='\"+b+\"']\");var f=$(\"#\" + a);if (f.checked||f.prop('checked')){e.removeClass('hidden');}else{e.addClass('hidden');}}</script>"
-        "<script>function showhideDir(a,b) {var e=$(\"[data-sh='\"+a+\"']\");var f=$(\"#\" + a);if (b){e.removeClass('hidden');}else{e.addClass('hidden');}}</script>"
-        "<script>function openModal(refelementId){document.body.classList.add(\"bx--body--with-modal-open\");document.getElementById(refelementId).classList.add(\"is-visible\")} function closeModal(refelementId){document.getElementById(refelementId).classList.remove(\"is-visible\");document.body.classList.remove(\"bx--body--with-modal-open\")}</script>"
-        "<script>function isNumberKey(e){var h=e.which?e.which:event.keyCode;return!(h>31&&(h<48||h>57))}</script>"
-        "<script>function openUrl(e){window.location.assign(e)}</script>"
-        "<script>function apiTypeSelect(r,t){if($(\"#\"+r).find(\":selected\").data('need-api')){$(\"[data-sh='\"+t+\"']\").removeClass('hidden')}else{$(\"[data-sh='\"+t+\"']\").addClass('hidden')}}</script>"
-        "</head><body>"
+        "<script src='https://cdnjs.cloudflare.com/ajax/libs/moment-timezone/0.5.32/moment-timezone-with-data.js' crossorigin='anonymous'></script>";
+
+static const char HEADER_BLOCK2_ASSETS[] PROGMEM = "<link rel='stylesheet' href='/www/app.css?v=%CSSVERSION%'>"
+        "<script src='/www/app.js?v=%JSVERSION%'></script>";
+
+static const char HEADER_BLOCK2_BODY[] PROGMEM = "</head><body>"
         "<header class='cv-header bx--header'>"
         "<a href='/' class='cv-header-name bx--header__name'>";
 
@@ -163,7 +182,6 @@ static const char HEADER_BLOCK5[] PROGMEM = "</div>"
                 "</div>"
             "</div>"
         "</header>"
-        "<script>function openSidebar(){document.getElementById('sidebar').classList.toggle('bx--header-panel--expanded');document.getElementById('chipinfo').classList.add('hidden');};function openChipInfo(){document.getElementById('sidebar').classList.remove('bx--header-panel--expanded');document.getElementById('chipinfo').classList.toggle('hidden');}</script>"
         "<br><div class='bx--grid bx--grid--full-width' style='margin-top:60px'>"
             "<div class='page-header' style='margin-bottom:20px;position:relative'><h4 class='page-header__label'>";
 
@@ -195,7 +213,6 @@ static const char FOOTER_BLOCK[] PROGMEM = "<br><br><br></div>"
             "</div>"
         "</div>"
         "<script src='https://unpkg.com/carbon-components/scripts/carbon-components.min.js'></script>"
-        "<script>$(function(){$('form').on('submit',function(e){$('#pageloading').removeClass('hidden')});$(\"input[type='checkbox']\").trigger('change')})</script>"
     "</body>"
 "</html>";
 
@@ -254,6 +271,25 @@ static const char UPDATE_FORM[] PROGMEM = "<div class='bx--row'>"
             "<input type='submit' value='Update FileSystem' class='bx--btn bx--btn--danger'>"
         "</form>"
     "</div>"
+    "<div class='bx--col-md-4'>"
+        "<form method='POST' action='/settings/restore' enctype='multipart/form-data'>"
+            "<div class='cv-file-uploader cv-form-item bx--form-item'>"
+                "<strong class='bx--file--label'>Backup &amp; Restore Settings</strong>"
+                "<p class='bx--label-description'>A filesystem update replaces all settings and printers. "
+                    "<a href='/settings/backup'>Download a backup</a> first and restore it after the update.</p>"
+                "<div data-file='' class='bx--file'>"
+                    "<label for='settings' role='button' tabindex='0' class='bx--file-browse-btn'>"
+                        "<div data-file-drop-container='' class='bx--file__drop-container'>"
+                            "Drag and drop file here or upload"
+                            "<input type='file' id='settings' accept='.txt' class='bx--file-input' name='settings' onchange='document.getElementById(\"fset\").innerHTML = \"\"'>"
+                        "</div>"
+                    "</label>"
+                    "<div data-file-container='' class='bx--file-container' id='fset'></div>"
+                "</div>"
+            "</div>"
+            "<input type='submit' value='Restore Settings' class='bx--btn bx--btn--danger'>"
+        "</form>"
+    "</div>"
 "</div>";
 
 /**
@@ -360,7 +396,7 @@ static const char CONFPRINTER_FORM_START[] PROGMEM = "<div class='bx--row'>"
                     "</div>"
                     "<section class='bx--table-toolbar'>"
                         "<div class='bx--toolbar-content'>"
-                            "<button class='bx--btn bx--btn--sm bx--btn--primary' onclick='openModal(\"mae-0\")'>"
+                            "<button class='bx--btn bx--btn--sm bx--btn--primary' onclick='editPrinter(0)'>"
                                 "Add new"
                                 "<svg focusable='false' preserveAspectRatio='xMidYMid meet' style='will-change: transform;' xmlns='http://www.w3.org/2000/svg' class='bx--btn__icon' width='20' height='20' viewBox='0 0 32 32'><path d='M17 15L17 7 15 7 15 15 7 15 7 17 15 17 15 25 17 25 17 17 25 17 25 15 17 15z'></path></svg>"
                             "</button>"
@@ -384,7 +420,7 @@ static const char CONFPRINTER_FORM_ROW_OK[] PROGMEM =  "<div class='bx--tag bx--
                                         "%STATUS%"
                                     "</div>";
 
-static const char CONFPRINTER_FORM_ROW[] PROGMEM = "<tr>"
+static const char CONFPRINTER_FORM_ROW[] PROGMEM = "<tr id='pr-%ID%' data-pname='%NAME%'>"
                                 "<td>%NAME%</td>"
                                 "<td>%TYPE%</td>"
                                 "<td>%STATE%</td>"
@@ -393,7 +429,7 @@ static const char CONFPRINTER_FORM_ROW[] PROGMEM = "<tr>"
                                         "<svg focusable='false' preserveAspectRatio='xMidYMid meet' style='will-change: transform;' xmlns='http://www.w3.org/2000/svg' class='bx--overflow-menu__icon' width='16' height='16' viewBox='0 0 16 16' aria-hidden='true'><circle cx='8' cy='3' r='1'></circle><circle cx='8' cy='8' r='1'></circle><circle cx='8' cy='13' r='1'></circle></svg>"
                                         "<ul class='bx--overflow-menu-options bx--overflow-menu--flip' data-floating-menu-direction='bottom'>"
                                             "<li class='bx--overflow-menu-options__option bx--table-row--menu-option'>"
-                                                "<button class='bx--overflow-menu-options__btn' onclick='openModal(\"mae-%ID%\")'>"
+                                                "<button class='bx--overflow-menu-options__btn' onclick='editPrinter(%ID%)'>"
                                                     "<div class='bx--overflow-menu-options__option-content'>"
                                                         "<svg focusable='false' preserveAspectRatio='xMidYMid meet' style='will-change: transform;' xmlns='http://www.w3.org/2000/svg' width='16' height='16' viewBox='0 0 16 16' aria-hidden='true'><path d='M1 13H15V14H1zM12.7 4.5c.4-.4.4-1 0-1.4 0 0 0 0 0 0l-1.8-1.8c-.4-.4-1-.4-1.4 0 0 0 0 0 0 0L2 8.8V12h3.2L12.7 4.5zM10.2 2L12 3.8l-1.5 1.5L8.7 3.5 10.2 2zM3 11V9.2l5-5L9.8 6l-5 5H3z'></path></svg> "
                                                         "Edit"
@@ -401,7 +437,7 @@ static const char CONFPRINTER_FORM_ROW[] PROGMEM = "<tr>"
                                                 "</button>"
                                             "</li>"
                                             "<li class='bx--overflow-menu-options__option bx--table-row--menu-option'>"
-                                                "<button class='bx--overflow-menu-options__btn' onclick='openModal(\"deletePrinterModal-%ID%\")'>"
+                                                "<button class='bx--overflow-menu-options__btn' onclick='deletePrinter(%ID%)'>"
                                                     "<div class='bx--overflow-menu-options__option-content'>"
                                                         "<svg focusable='false' preserveAspectRatio='xMidYMid meet' style='will-change: transform;' xmlns='http://www.w3.org/2000/svg' width='16' height='16' viewBox='0 0 16 16' aria-hidden='true'><path d='M6 6H7V12H6zM9 6H10V12H9z'></path><path d='M2 3v1h1v10c0 .6.4 1 1 1h8c.6 0 1-.4 1-1V4h1V3H2zM4 14V4h8v10H4zM6 1H10V2H6z'></path></svg> "
                                                         "Delete"
@@ -417,7 +453,9 @@ static const char CONFPRINTER_FORM_END[] PROGMEM = "</tbody>"
                     "</table>"
                 "</div>"
             "</div>"
-            "<script>$(\"select[id^='e-tapi']\").trigger('change')</script>";
+            "<script>function editPrinter(i){var h=$('#mae-0-heading'),o=function(){$('#e-tapi-0,#e-tapipw-0').trigger('change');openModal('mae-0')};$('#mae-0 form')[0].reset();$('#mae-0-id').val(i);h.text(h.data(i>0?'te':'ta'));if(i<1){return o()}"
+                "$('#pageloading').removeClass('hidden');$.getJSON('/configureprinter/get?id='+i,function(p){$('#e-tname-0').val(p.name);$('#e-tapi-0').val(p.apiType);$('#e-tapikey-0').val(p.apiKey);$('#e-taddr-0').val(p.address);$('#e-tport-0').val(p.port);$('#e-tapipw-0').prop('checked',p.basicAuth);$('#e-tapiuser-0').val(p.user);$('#e-tapipass-0').val(p.password);o()}).always(function(){$('#pageloading').addClass('hidden')})}"
+                "function deletePrinter(i){var d=$('#deletePrinterModal');d.find('[data-pname]').text($('#pr-'+i).data('pname'));d.data('pid',i);openModal('deletePrinterModal')}</script>";
 
 
 static const char CONFPRINTER_FORM_ADDEDIT_TA[] PROGMEM = "Create new printer";
@@ -426,10 +464,10 @@ static const char CONFPRINTER_FORM_ADDEDIT_TE[] PROGMEM = "Edit data for printer
 static const char CONFPRINTER_FORM_ADDEDIT_START[] PROGMEM = "<div data-modal id='mae-%ID%' class='bx--modal' role='dialog' aria-modal='true' aria-labelledby='mae-%ID%-label' aria-describedby='mae-%ID%-heading' tabindex='-1'>"
                 "<div class='bx--modal-container'>"
                     "<form method='GET' action='/configureprinter/edit'>"
-                        "<input type='hidden' name='id' value='%ID%'>"
+                        "<input type='hidden' id='mae-%ID%-id' name='id' value='%ID%'>"
                         "<div class='bx--modal-header'>"
                             "<p class='bx--modal-header__label bx--type-delta' id='mae-%ID%-label'>Printer Configuration</p>"
-                            "<p class='bx--modal-header__heading bx--type-beta' id='mae-%ID%-heading'>%TITLE%</p>"
+                            "<p class='bx--modal-header__heading bx--type-beta' id='mae-%ID%-heading' data-ta='%TITLEADD%' data-te='%TITLEEDIT%'>%TITLE%</p>"
                             "<button class='bx--modal-close' type='button' onclick='closeModal(\"mae-%ID%\")'>"
                                 "<svg focusable='false' preserveAspectRatio='xMidYMid meet' style='will-change: transform;' xmlns='http://www.w3.org/2000/svg' class='bx--modal-close__icon' width='16' height='16' viewBox='0 0 16 16' aria-hidden='true'><path d='M12 4.7L11.3 4 8 7.3 4.7 4 4 4.7 7.3 8 4 11.3 4.7 12 8 8.7 11.3 12 12 11.3 8.7 8z'></path></svg>"
                             "</button>"
@@ -570,7 +608,7 @@ static const char MAINPAGE_ROW_WEATHER_ERROR_BLOCK[] PROGMEM = "<div class='bx--
                                         "</div>"
                                     "</div>";
 
-static const char MAINPAGE_ROW_WEATHER_AND_SENSOR_BLOCK[] PROGMEM = "<div class='bx--col bx--col--auto' style='margin: 2rem 0;'>"
+static const char MAINPAGE_ROW_WEATHER_AND_SENSOR_BLOCK[] PROGMEM = "<div class='bx--col bx--col--auto' style='margin: 2rem 0;' id='%BLOCKID%'>"
                                         "<div class='bx--grid bx--grid--full-width'>"
                                             "<div class='bx--row'>"
                                                 "<div class='bx--col bx--col--auto'>"
@@ -603,19 +641,19 @@ static const char MAINPAGE_ROW_WEATHER_AND_SENSOR_END[] PROGMEM = "</div>"
                 "</div>"
             "</div>";
 
-static const char MAINPAGE_ROW_PRINTER_BLOCK_S_PRINTING[] PROGMEM = "<div class='bx--col bx--col--auto'>"
+static const char MAINPAGE_ROW_PRINTER_BLOCK_S_PRINTING[] PROGMEM = "<div class='bx--col bx--col--auto' id='pb-%ID%' data-state='%STATE%'>"
             "<div class='bx--inline-notification bx--inline-notification--info bx--inline-notification--low-contrast'>"
                 "<div class='bx--inline-notification__details'>"
                     "<svg focusable='false' preserveAspectRatio='xMidYMid meet' style='will-change: transform;' xmlns='http://www.w3.org/2000/svg' class='bx--inline-notification__icon' width='20' height='20' viewBox='0 0 32 32' aria-hidden='true'><path d='M16,2A14,14,0,1,0,30,16,14,14,0,0,0,16,2Zm0,5a1.5,1.5,0,1,1-1.5,1.5A1.5,1.5,0,0,1,16,7Zm4,17.12H12V21.88h2.88V15.12H13V12.88h4.13v9H20Z'></path></svg>"
                     "<div style='margin: .5rem 0;width: 100%;'>";
 
-static const char MAINPAGE_ROW_PRINTER_BLOCK_S_ERROROFFLINE[] PROGMEM = "<div class='bx--col bx--col--auto'>"
+static const char MAINPAGE_ROW_PRINTER_BLOCK_S_ERROROFFLINE[] PROGMEM = "<div class='bx--col bx--col--auto' id='pb-%ID%' data-state='%STATE%'>"
             "<div class='bx--inline-notification bx--inline-notification--error bx--inline-notification--low-contrast'>"
                 "<div class='bx--inline-notification__details'>"
                     "<svg focusable='false' preserveAspectRatio='xMidYMid meet' style='will-change: transform;' xmlns='http://www.w3.org/2000/svg' class='bx--inline-notification__icon' width='20' height='20' viewBox='0 0 20 20' aria-hidden='true'><path d='M10,1c-5,0-9,4-9,9s4,9,9,9s9-4,9-9S15,1,10,1z M13.5,14.5l-8-8l1-1l8,8L13.5,14.5z'></path><path d='M13.5,14.5l-8-8l1-1l8,8L13.5,14.5z' data-icon-path='inner-path' opacity='0'></path></svg>"
                     "<div style='margin: .5rem 0;width: 100%;'>";
 
-static const char MAINPAGE_ROW_PRINTER_BLOCK_S_STANDBY[] PROGMEM = "<div class='bx--col bx--col--auto'>"
+static const char MAINPAGE_ROW_PRINTER_BLOCK_S_STANDBY[] PROGMEM = "<div class='bx--col bx--col--auto' id='pb-%ID%' data-state='%STATE%'>"
             "<div class='bx--inline-notification bx--inline-notification--success bx--inline-notification--low-contrast'>"
                 "<div class='bx--inline-notification__details'>"
                     "<svg focusable='false' preserveAspectRatio='xMidYMid meet' style='will-change: transform;' xmlns='http://www.w3.org/2000/svg' class='bx--inline-notification__icon' width='20' height='20' viewBox='0 0 20 20' aria-hidden='true'><path d='M10,1c-4.9,0-9,4.1-9,9s4.1,9,9,9s9-4,9-9S15,1,10,1z M8.7,13.5l-3.2-3.2l1-1l2.2,2.2l4.8-4.8l1,1L8.7,13.5z'></path><path fill='none' d='M8.7,13.5l-3.2-3.2l1-1l2.2,2.2l4.8-4.8l1,1L8.7,13.5z' data-icon-path='inner-path' opacity='0'></path></svg>"
@@ -625,12 +663,29 @@ static const char MAINPAGE_ROW_PRINTER_BLOCK_TITLE[] PROGMEM = "<p class='bx--in
                     "<p class='bx--inline-notification__subtitle'>";
 
 
-static const char MAINPAGE_ROW_PRINTER_BLOCK_LINE[] PROGMEM = "<div><strong>%T%:</strong> %V%</div>";
-static const char MAINPAGE_ROW_PRINTER_BLOCK_PROG[] PROGMEM = "<div class='pStateBar'><div class='pStateBarD' style='width: %P%'>%P%</div></div>";
+static const char MAINPAGE_ROW_PRINTER_BLOCK_LINE[] PROGMEM = "<div><strong>%T%:</strong> <span data-pb='%K%'>%V%</span></div>";
+static const char MAINPAGE_ROW_PRINTER_BLOCK_PROG[] PROGMEM = "<div class='pStateBar'><div class='pStateBarD' style='width: %P%' data-pb='progress'>%P%</div></div>";
 static const char MAINPAGE_ROW_PRINTER_BLOCK_HR[] PROGMEM = "<hr class='pStateHr'>";
 
 static const char MAINPAGE_ROW_PRINTER_BLOCK_E[] PROGMEM = "</p></div></div></div></div>";
 
+static const char MAINPAGE_VALUE_SPAN[] PROGMEM = "<span data-pb='%K%'>%V%</span>";
+
+// Patch values from /events in place, reload on state change (different layout) or when events are not available
+static const char MAINPAGE_EVENTS_SCRIPT[] PROGMEM = "<script>(function(){"
+    "function reload(){setTimeout(function(){location.reload()},30000)}"
+    "if(!window.EventSource){reload();return}"
+    "function patch(b,d){if(!b){return}for(var k in d){var e=b.querySelectorAll(\"[data-pb='\"+k+\"']\");"
+        "for(var i=0;i<e.length;i++){e[i].textContent=d[k];if(k=='progress'){e[i].style.width=d[k]}}}}"
+    "var es=new EventSource('/events');"
+    "es.addEventListener('printer',function(m){var d=JSON.parse(m.data);var b=document.getElementById('pb-'+d.id);"
+        "if(!b||b.getAttribute('data-state')!=String(d.state)){location.reload();return}"
+        "d.tool=d.toolTemp+'\\u00B0 C ['+d.toolTargetTemp+']';d.bed=d.bedTemp+'\\u00B0 C ['+d.bedTargetTemp+']';patch(b,d)});"
+    "es.addEventListener('sensor',function(m){patch(document.getElementById('sb'),JSON.parse(m.data))});"
+    "es.addEventListener('weather',function(m){patch(document.getElementById('wb'),JSON.parse(m.data))});"
+    "es.onerror=function(){if(es.readyState==2){reload()}}"
+"})()</script>";
+
 
 /**
  * @brief Class to generate HTML content from Memory
@@ -640,29 +695,35 @@ private:
     static String rowExtraClass;
 
 public:
-    static void sendHeader(ESP8266WebServer *server, GlobalDataController *globalDataController, String pageLabel, String pageTitle);
-    static void sendHeader(ESP8266WebServer *server, GlobalDataController *globalDataController, String pageLabel, String pageTitle, boolean refresh);
-    static void sendFooter(ESP8266WebServer *server, GlobalDataController *globalDataController);
-
-    static void sendMainPage(ESP8266WebServer *server, GlobalDataController *globalDataController);
-    static void sendUpdateForm(ESP8266WebServer *server, GlobalDataController *globalDataController);
-    static void sendWeatherConfigForm(ESP8266WebServer *server, GlobalDataController *globalDataController);
-    static void sendStationConfigForm(ESP8266WebServer *server, GlobalDataController *globalDataController);
-    static void sendPrinterConfigForm(ESP8266WebServer *server, GlobalDataController *globalDataController);
-    static void sendSensorConfigForm(ESP8266WebServer *server, GlobalDataController *globalDataController);
-    static void sendDisplayConfigForm(ESP8266WebServer *server, GlobalDataController *globalDataController);
+    static void sendHeader(WebserverResponseWriter *writer, GlobalDataController *globalDataController, String pageLabel, String pageTitle);
+    static void sendHeader(WebserverResponseWriter *writer, GlobalDataController *globalDataController, String pageLabel, String pageTitle, boolean refresh);
+    static void sendFooter(WebserverResponseWriter *writer, GlobalDataController *globalDataController);
+
+    static void sendMainPage(WebserverResponseWriter *writer, GlobalDataController *globalDataController);
+    static void sendUpdateForm(WebserverResponseWriter *writer, GlobalDataController *globalDataController);
+    static void sendWeatherConfigForm(WebserverResponseWriter *writer, GlobalDataController *globalDataController);
+    static void sendStationConfigForm(WebserverResponseWriter *writer, GlobalDataController *globalDataController);
+    static void sendPrinterConfigForm(WebserverResponseWriter *writer, GlobalDataController *globalDataController);
+    static void sendSensorConfigForm(WebserverResponseWriter *writer, GlobalDataController *globalDataController);
+    static void sendDisplayConfigForm(WebserverResponseWriter *writer, GlobalDataController *globalDataController);
 
 private:
-    static void sendFormCheckbox(ESP8266WebServer *server, String formId, bool isChecked, String label, bool inRow, String uniqueId);
-    static void sendFormCheckbox(ESP8266WebServer *server, String formId, bool isChecked, String labelOn, String labelOff, bool inRow, String uniqueId);
-    static void sendFormCheckboxEvent(ESP8266WebServer *server, String formId, bool isChecked, String label, String onChange, bool inRow, String uniqueId);
-    static void sendFormCheckboxEvent(ESP8266WebServer *server, String formId, bool isChecked, String labelOn, String labelOff, String onChange, bool inRow, String uniqueId);
-    static void sendFormInput(ESP8266WebServer *server, String formId, String label, String value, String placeholder, int maxLen, String events, bool isPassword, bool inRow, String uniqueId);
-    static void sendFormSelect(ESP8266WebServer *server, String formId, String label, String value, String events, String options, bool inRow, String uniqueId);
-    static void sendFormSubmitButton(ESP8266WebServer *server, bool inRow);
-    static void sendForm(ESP8266WebServer *server, String formId, String formElement, bool inRow, String uniqueId);
-
-    static void sendPrinterConfigFormAEModal(ESP8266WebServer *server, int id, PrinterDataStruct *forPrinter, GlobalDataController *globalDataController);
-
-    static void sendModalDanger(ESP8266WebServer *server, String formId, String label, String title, String content, String secActionTitle, String primActionTitle, String primActionEvent);
+    static void sendFormCheckbox(WebserverResponseWriter *writer, String formId, bool isChecked, String label, bool inRow, String uniqueId);
+    static void sendFormCheckbox(WebserverResponseWriter *writer, String formId, bool isChecked, String labelOn, String labelOff, bool inRow, String uniqueId);
+    static void sendFormCheckboxEvent(WebserverResponseWriter *writer, String formId, bool isChecked, String label, String onChange, bool inRow, String uniqueId);
+    static void sendFormCheckboxEvent(WebserverResponseWriter *writer, String formId, bool isChecked, String labelOn, String labelOff, String onChange, bool inRow, String uniqueId);
+    static void sendFormInput(WebserverResponseWriter *writer, String formId, String label, String value, String placeholder, int maxLen, String events, bool isPassword, bool inRow, String uniqueId);
+    static void sendFormSelect(WebserverResponseWriter *writer, String formId, String label, String value, String events, PGM_P options, bool inRow, String uniqueId);
+    static void sendFormSelect(WebserverResponseWriter *writer, String formId, String label, String value, String events, std::function<void()> sendOptions, bool inRow, String uniqueId);
+    static void sendSelectOption(WebserverResponseWriter *writer, int value, bool isSelected, const char *attributes, String text);
+    static void sendFormSubmitButton(WebserverResponseWriter *writer, bool inRow);
+    static void sendForm(WebserverResponseWriter *writer, String formId, PGM_P formTemplate, bool inRow, String uniqueId, WebserverTemplateProvider provider);
+    static void sendRowStart(WebserverResponseWriter *writer, String extraClass);
+    static void sendPrinterCard(WebserverResponseWriter *writer, int i, PrinterDataStruct *printerConfig, GlobalDataController *globalDataController);
+    static void sendPrinterLine(WebserverResponseWriter *writer, const char *title, const char *key, const char *value);
+    static void sendValueSpan(WebserverResponseWriter *writer, const char *key, const char *value);
+
+    static void sendPrinterConfigFormAEModal(WebserverResponseWriter *writer, GlobalDataController *globalDataController);
+
+    static void sendModalDanger(WebserverResponseWriter *writer, String formId, String label, String title, String content, String secActionTitle, String primActionTitle, String primActionEvent);
 };
@@ -0,0 +1,217 @@
+#include "WebserverResponseWriter.h"
+
+/**
+ * @brief Construct a new Webserver Response Writer object
+ * @param server            Send out instance
+ */
+WebserverResponseWriter::WebserverResponseWriter(ESP8266WebServer *server) {
+    this->server = server;
+    this->buffer = NULL;
+    this->bufferLength = 0;
+    this->capture = NULL;
+    this->captureLength = 0;
+    this->captureSize = 0;
+    this->captureOverflow = false;
+}
+
+/**
+ * @brief Destroy the Webserver Response Writer object, pending content is sent
+ */
+WebserverResponseWriter::~WebserverResponseWriter() {
+    if (this->capture != NULL) {
+        free(this->capture);
+    }
+    this->flush();
+    this->releaseBuffer();
+}
+
+/**
+ * @brief Get the server instance of the response
+ * @return ESP8266WebServer* 
+ */
+ESP8266WebServer *WebserverResponseWriter::getServer() {
+    return this->server;
+}
+
+/**
+ * @brief Send the response header for chunked content (not cached by the client)
+ * @param code              HTTP status code
+ * @param contentType       Content type
+ */
+void WebserverResponseWriter::begin(int code, const char *contentType) {
+    this->begin(code, contentType, CONTENT_LENGTH_UNKNOWN);
+}
+
+/**
+ * @brief Send the response header (not cached by the client)
+ * @param code              HTTP status code
+ * @param contentType       Content type
+ * @param contentLength     Length of content or CONTENT_LENGTH_UNKNOWN for chunked content
+ */
+void WebserverResponseWriter::begin(int code, const char *contentType, size_t contentLength) {
+    this->server->sendHeader("Cache-Control", "no-cache, no-store");
+    this->server->sendHeader("Pragma", "no-cache");
+    this->server->sendHeader("Expires", "-1");
+    this->server->setContentLength(contentLength);
+    this->server->send(code, contentType, "");
+}
+
+/**
+ * @brief Send pending content and end the response (final empty chunk when chunked)
+ */
+void WebserverResponseWriter::end() {
+    this->flush();
+    this->releaseBuffer();
+    this->server->sendContent("");
+}
+
+/**
+ * @brief Add single byte to the response
+ * @param data 
+ * @return size_t 
+ */
+size_t WebserverResponseWriter::write(uint8_t data) {
+    return this->write(&data, 1);
+}
+
+/**
+ * @brief Add data to the response, full buffers are sent as one chunk
+ * @param data 
+ * @param size 
+ * @return size_t 
+ */
+size_t WebserverResponseWriter::write(const uint8_t *data, size_t size) {
+    if (this->capture != NULL) {
+        if (!this->captureOverflow && (this->captureLength + size <= this->captureSize)) {
+            memcpy(this->capture + this->captureLength, data, size);
+            this->captureLength += size;
+        } else {
+            this->captureOverflow = true;
+        }
+        return size;
+    }
+    if (!this->allocateBuffer()) {
+        // Not enough memory for buffering, send directly
+        if (size > 0) {
+            this->server->sendContent((const char *)data, size);
+        }
+        return size;
+    }
+    size_t written = 0;
+    while (written < size) {
+        size_t part = _min(size - written, WEBSERVER_RESPONSE_BUFFER_SIZE - this->bufferLength);
+        memcpy(this->buffer + this->bufferLength, data + written, part);
+        this->bufferLength += part;
+        written += part;
+        if (this->bufferLength >= WEBSERVER_RESPONSE_BUFFER_SIZE) {
+            this->flush();
+        }
+    }
+    return written;
+}
+
+/**
+ * @brief Add data from PROGMEM to the response
+ * @param data              Data in PROGMEM
+ * @param size              Number of bytes
+ * @return size_t 
+ */
+size_t WebserverResponseWriter::write_P(PGM_P data, size_t size) {
+    if (this->capture != NULL) {
+        if (!this->captureOverflow && (this->captureLength + size <= this->captureSize)) {
+            memcpy_P(this->capture + this->captureLength, data, size);
+            this->captureLength += size;
+        } else {
+            this->captureOverflow = true;
+        }
+        return size;
+    }
+    if (!this->allocateBuffer()) {
+        if (size > 0) {
+            this->server->sendContent_P(data, size);
+        }
+        return size;
+    }
+    size_t written = 0;
+    while (written < size) {
+        size_t part = _min(size - written, WEBSERVER_RESPONSE_BUFFER_SIZE - this->bufferLength);
+        memcpy_P(this->buffer + this->bufferLength, data + written, part);
+        this->bufferLength += part;
+        written += part;
+        if (this->bufferLength >= WEBSERVER_RESPONSE_BUFFER_SIZE) {
+            this->flush();
+        }
+    }
+    return written;
+}
+
+/**
+ * @brief Send buffered content as one chunk
+ */
+void WebserverResponseWriter::flush() {
+    if (this->bufferLength == 0) {
+        return;
+    }
+    this->server->sendContent((const char *)this->buffer, this->bufferLength);
+    this->bufferLength = 0;
+}
+
+/**
+ * @brief Collect all following content in memory instead of sending it
+ * @param maxSize           Maximum size of the content to collect
+ * @return true             Capturing started
+ * @return false            Out of memory or already capturing
+ */
+bool WebserverResponseWriter::beginCapture(size_t maxSize) {
+    if ((this->capture != NULL) || (maxSize == 0)) {
+        return false;
+    }
+    this->capture = (uint8_t *)malloc(maxSize);
+    this->captureLength = 0;
+    this->captureSize = maxSize;
+    this->captureOverflow = false;
+    return this->capture != NULL;
+}
+
+/**
+ * @brief Stop capturing, the collected content is handed over to the caller (release with free())
+ * @param length            Length of collected content
+ * @return uint8_t*         Collected content or NULL if it exceeded the maximum size
+ */
+uint8_t *WebserverResponseWriter::endCapture(size_t *length) {
+    uint8_t *content = this->capture;
+    *length = this->captureLength;
+    this->capture = NULL;
+    if ((content == NULL) || this->captureOverflow || (this->captureLength == 0)) {
+        free(content);
+        *length = 0;
+        return NULL;
+    }
+    // Shrink to the used size
+    uint8_t *shrunk = (uint8_t *)realloc(content, this->captureLength);
+    return shrunk != NULL ? shrunk : content;
+}
+
+/**
+ * @brief Allocate buffer on first use
+ * @return true             Buffer available
+ * @return false            Out of memory
+ */
+bool WebserverResponseWriter::allocateBuffer() {
+    if (this->buffer == NULL) {
+        this->buffer = (uint8_t *)malloc(WEBSERVER_RESPONSE_BUFFER_SIZE);
+        this->bufferLength = 0;
+    }
+    return this->buffer != NULL;
+}
+
+/**
+ * @brief Release buffer, content must be flushed before
+ */
+void WebserverResponseWriter::releaseBuffer() {
+    if (this->buffer != NULL) {
+        free(this->buffer);
+        this->buffer = NULL;
+    }
+    this->bufferLength = 0;
+}
@@ -0,0 +1,44 @@
+#pragma once
+#include <Arduino.h>
+#include <ESP8266WebServer.h>
+
+// One TCP segment (MSS), content is sent as chunks of this size
+#define WEBSERVER_RESPONSE_BUFFER_SIZE  1460
+
+/**
+ * @brief Collects the content of a chunked response and sends it in MSS sized chunks
+ * Instead of one HTTP chunk (and TCP segment) for every small piece of content.
+ * The buffer is allocated on the first write and released with end().
+ * Between beginCapture() and endCapture() all content is collected in memory instead (e.g. for caching).
+ */
+class WebserverResponseWriter : public Print {
+private:
+    ESP8266WebServer *server;
+    uint8_t *buffer;
+    size_t bufferLength;
+    uint8_t *capture;
+    size_t captureLength;
+    size_t captureSize;
+    bool captureOverflow;
+
+public:
+    WebserverResponseWriter(ESP8266WebServer *server);
+    ~WebserverResponseWriter();
+    ESP8266WebServer *getServer();
+    void begin(int code, const char *contentType);
+    void begin(int code, const char *contentType, size_t contentLength);
+    void end();
+
+    size_t write(uint8_t data) override;
+    size_t write(const uint8_t *data, size_t size) override;
+    size_t write_P(PGM_P data, size_t size);
+    void flush() override;
+    using Print::write;
+
+    bool beginCapture(size_t maxSize);
+    uint8_t *endCapture(size_t *length);
+
+private:
+    bool allocateBuffer();
+    void releaseBuffer();
+};
@@ -0,0 +1,121 @@
+#include "WebserverTemplate.h"
+
+/**
+ * @brief Send template, placeholders are resolved by the provider
+ * @param writer            Send out instance
+ * @param templateData      Template in PROGMEM
+ * @param provider          Sends the value for a placeholder (name without %)
+ */
+void WebserverTemplate::send(WebserverResponseWriter *writer, PGM_P templateData, WebserverTemplateProvider provider) {
+    char token[WEBSERVER_TEMPLATE_MAX_TOKEN + 1];
+    PGM_P spanStart = templateData;
+    PGM_P pos = templateData;
+    char c;
+
+    while ((c = pgm_read_byte(pos)) != 0) {
+        if (c != '%') {
+            pos++;
+            continue;
+        }
+
+        // Collect placeholder name, anything else (e.g. "100%") stays literal
+        size_t tokenLen = 0;
+        PGM_P tokenPos = pos + 1;
+        while (((c = pgm_read_byte(tokenPos)) != 0) && WebserverTemplate::isTokenChar(c) && (tokenLen < WEBSERVER_TEMPLATE_MAX_TOKEN)) {
+            token[tokenLen++] = c;
+            tokenPos++;
+        }
+        if ((c != '%') || (tokenLen == 0)) {
+            pos = tokenPos;
+            continue;
+        }
+        token[tokenLen] = 0;
+
+        WebserverTemplate::sendSpan_P(writer, spanStart, pos - spanStart);
+        provider(token);
+        pos = tokenPos + 1;
+        spanStart = pos;
+    }
+    WebserverTemplate::sendSpan_P(writer, spanStart, pos - spanStart);
+}
+
+/**
+ * @brief Send text, empty text is skipped
+ * @param writer            Send out instance
+ * @param text 
+ */
+void WebserverTemplate::sendText(WebserverResponseWriter *writer, const String &text) {
+    if (text.length() > 0) {
+        writer->print(text);
+    }
+}
+
+/**
+ * @brief Send text, empty text is skipped
+ * @param writer            Send out instance
+ * @param text 
+ */
+void WebserverTemplate::sendText(WebserverResponseWriter *writer, const char *text) {
+    size_t length = strlen(text);
+    if (length > 0) {
+        writer->write(text, length);
+    }
+}
+
+/**
+ * @brief Send text from PROGMEM, empty text is skipped
+ * @param writer            Send out instance
+ * @param text 
+ */
+void WebserverTemplate::sendText_P(WebserverResponseWriter *writer, PGM_P text) {
+    WebserverTemplate::sendSpan_P(writer, text, strlen_P(text));
+}
+
+/**
+ * @brief Send option list from PROGMEM (<option ...>text</option>) and mark the option with the given text as selected
+ * @param writer            Send out instance
+ * @param options           Options in PROGMEM
+ * @param selectedText      Text of option to preselect
+ */
+void WebserverTemplate::sendOptions_P(WebserverResponseWriter *writer, PGM_P options, const String &selectedText) {
+    PGM_P spanStart = options;
+    PGM_P pos = options;
+    size_t selectedLen = selectedText.length();
+    char c;
+
+    while ((c = pgm_read_byte(pos)) != 0) {
+        if ((c == '>') && (selectedLen > 0)
+            && (strncmp_P(selectedText.c_str(), pos + 1, selectedLen) == 0)
+            && (pgm_read_byte(pos + 1 + selectedLen) == '<')
+        ) {
+            WebserverTemplate::sendSpan_P(writer, spanStart, pos - spanStart);
+            writer->print(" selected");
+            spanStart = pos;
+            selectedLen = 0;
+        }
+        pos++;
+    }
+    WebserverTemplate::sendSpan_P(writer, spanStart, pos - spanStart);
+}
+
+/**
+ * @brief Send part of PROGMEM data
+ * @param writer            Send out instance
+ * @param start             Start in PROGMEM
+ * @param length            Number of bytes
+ */
+void WebserverTemplate::sendSpan_P(WebserverResponseWriter *writer, PGM_P start, size_t length) {
+    if (length > 0) {
+        writer->write_P(start, length);
+    }
+}
+
+/**
+ * @brief Allowed characters of placeholder names
+ * @param c 
+ * @return true 
+ * @return false 
+ */
+bool WebserverTemplate::isTokenChar(char c) {
+    return ((c >= 'A') && (c <= 'Z')) || ((c >= '0') && (c <= '9')) || (c == '_');
+}
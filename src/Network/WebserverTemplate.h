@@ -0,0 +1,28 @@
+#pragma once
+#include <Arduino.h>
+#include <ESP8266WebServer.h>
+#include "WebserverResponseWriter.h"
+#include <functional>
+
+// Longest placeholder name (without the surrounding %)
+#define WEBSERVER_TEMPLATE_MAX_TOKEN    20
+
+typedef std::function<void(const char *token)> WebserverTemplateProvider;
+
+/**
+ * @brief Streams PROGMEM templates with %TOKEN% placeholders to the client
+ * Literal parts are copied directly from flash into the response buffer, the provider sends the value of each placeholder.
+ * The template itself is never copied into a String.
+ */
+class WebserverTemplate {
+public:
+    static void send(WebserverResponseWriter *writer, PGM_P templateData, WebserverTemplateProvider provider);
+    static void sendText(WebserverResponseWriter *writer, const String &text);
+    static void sendText(WebserverResponseWriter *writer, const char *text);
+    static void sendText_P(WebserverResponseWriter *writer, PGM_P text);
+    static void sendOptions_P(WebserverResponseWriter *writer, PGM_P options, const String &selectedText);
+
+private:
+    static void sendSpan_P(WebserverResponseWriter *writer, PGM_P start, size_t length);
+    static bool isTokenChar(char c);
+};
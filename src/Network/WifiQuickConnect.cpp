@@ -0,0 +1,121 @@
+#include "WifiQuickConnect.h"
+
+bool WifiQuickConnect::started = false;
+
+/**
+ * @brief Start connection to the cached access point with the cached IP configuration
+ * @return true             Connection started, wait with waitForConnection()
+ * @return false            No cache or no stored credentials, use WiFiManager
+ */
+bool WifiQuickConnect::begin() {
+    WifiCacheDataStruct cache;
+    WifiQuickConnect::started = false;
+    if (!WifiQuickConnect::readCache(&cache) || (WiFi.SSID().length() == 0)) {
+        WifiQuickConnect::releaseAccessPoint();
+        return false;
+    }
+    WiFi.mode(WIFI_STA);
+    WiFi.config(IPAddress(cache.localIp), IPAddress(cache.gateway), IPAddress(cache.subnet), IPAddress(cache.dns));
+    // BSSID and channel only apply to this connection, the stored configuration stays unchanged
+    WiFi.persistent(false);
+    WiFi.begin(WiFi.SSID().c_str(), WiFi.psk().c_str(), cache.channel, cache.bssid);
+    WiFi.persistent(true);
+    WifiQuickConnect::started = true;
+    return true;
+}
+
+/**
+ * @brief Wait for the connection started with begin()
+ * @param timeoutMillis     Maximum time to wait
+ * @param waitHandler       Called while waiting (display, timers)
+ * @return true             Connected, DHCP is started again to get a lease for the cached address
+ * @return false            Not started or timed out, DHCP is enabled again and the cache is dropped
+ */
+bool WifiQuickConnect::waitForConnection(unsigned long timeoutMillis, std::function<void()> waitHandler) {
+    if (!WifiQuickConnect::started) {
+        return false;
+    }
+    unsigned long startMillis = millis();
+    while ((WiFi.status() != WL_CONNECTED) && ((millis() - startMillis) < timeoutMillis)) {
+        waitHandler();
+        delay(10);
+    }
+    if (WiFi.status() == WL_CONNECTED) {
+        // The cached address has no lease on the DHCP server, so request one now that the link is up.
+        // The address is kept until the lease is bound (usually the same, otherwise requests are retried).
+        WiFi.config(IPAddress((uint32_t)0), IPAddress((uint32_t)0), IPAddress((uint32_t)0));
+        return true;
+    }
+
+    // Access point or network changed, use scan and DHCP. WiFi.disconnect() would also clear the stored credentials.
+    WifiQuickConnect::invalidate();
+    wifi_station_disconnect();
+    WifiQuickConnect::releaseAccessPoint();
+    WiFi.config(IPAddress((uint32_t)0), IPAddress((uint32_t)0), IPAddress((uint32_t)0));
+    return false;
+}
+
+/**
+ * @brief Connect to any access point with the stored SSID again (drop the BSSID of the quick connect).
+ * Older versions stored the BSSID persistently, so it is also removed from the stored configuration.
+ */
+void WifiQuickConnect::releaseAccessPoint() {
+    struct station_config config;
+    if (wifi_station_get_config_default(&config) && config.bssid_set) {
+        config.bssid_set = 0;
+        wifi_station_set_config(&config);
+    }
+    if (wifi_station_get_config(&config) && config.bssid_set) {
+        config.bssid_set = 0;
+        wifi_station_set_config_current(&config);
+    }
+}
+
+/**
+ * @brief Store the current connection for the next start
+ */
+void WifiQuickConnect::store() {
+    WifiCacheDataStruct cache;
+    memset(&cache, 0, sizeof(cache));
+    if (WiFi.BSSID() != NULL) {
+        memcpy(cache.bssid, WiFi.BSSID(), sizeof(cache.bssid));
+    }
+    cache.channel = WiFi.channel();
+    cache.localIp = WiFi.localIP();
+    cache.gateway = WiFi.gatewayIP();
+    cache.subnet = WiFi.subnetMask();
+    cache.dns = WiFi.dnsIP();
+
+    WifiCacheDataStruct current;
+    if (WifiQuickConnect::readCache(&current) && (memcmp(((uint8_t *)&current) + 8, ((uint8_t *)&cache) + 8, sizeof(cache) - 8) == 0)) {
+        return;
+    }
+    cache.magic = WIFI_CACHE_MAGIC;
+    cache.crc = BinaryConfigFile::crc32(((uint8_t *)&cache) + 8, sizeof(cache) - 8);
+    ESP.rtcUserMemoryWrite(WIFI_CACHE_RTC_OFFSET, (uint32_t *)&cache, sizeof(cache));
+}
+
+/**
+ * @brief Drop the cached connection
+ */
+void WifiQuickConnect::invalidate() {
+    WifiCacheDataStruct cache;
+    memset(&cache, 0, sizeof(cache));
+    ESP.rtcUserMemoryWrite(WIFI_CACHE_RTC_OFFSET, (uint32_t *)&cache, sizeof(cache));
+}
+
+/**
+ * @brief Read cached connection from RTC memory
+ * @param cache             Target
+ * @return true             Cache is valid
+ * @return false 
+ */
+bool WifiQuickConnect::readCache(WifiCacheDataStruct *cache) {
+    if (!ESP.rtcUserMemoryRead(WIFI_CACHE_RTC_OFFSET, (uint32_t *)cache, sizeof(WifiCacheDataStruct))) {
+        return false;
+    }
+    return (cache->magic == WIFI_CACHE_MAGIC)
+        && (cache->channel > 0)
+        && (cache->localIp != 0)
+        && (cache->crc == BinaryConfigFile::crc32(((uint8_t *)cache) + 8, sizeof(WifiCacheDataStruct) - 8));
+}
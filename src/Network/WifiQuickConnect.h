@@ -0,0 +1,30 @@
+#pragma once
+#include <Arduino.h>
+#include <ESP8266WiFi.h>
+#include <functional>
+#include "../DataStructs/WifiCacheDataStruct.h"
+#include "../Global/BinaryConfigFile.h"
+
+// RTC user memory behind the OTA bootloader command (in 4 byte blocks)
+#define WIFI_CACHE_RTC_OFFSET       32
+// Time to wait for the direct reconnect before the WiFiManager scan is used
+#define WIFI_QUICK_CONNECT_TIMEOUT  5000
+
+/**
+ * @brief Reconnects to the last access point without scan and DHCP (BSSID, channel and IP are kept in RTC memory).
+ * The connection is started before the display is initialized, so both run at the same time.
+ * DHCP is started again once the link is up, so the address is not used without a lease.
+ */
+class WifiQuickConnect {
+private:
+    static bool started;
+
+    static bool readCache(WifiCacheDataStruct *cache);
+    static void releaseAccessPoint();
+
+public:
+    static bool begin();
+    static bool waitForConnection(unsigned long timeoutMillis, std::function<void()> waitHandler);
+    static void store();
+    static void invalidate();
+};
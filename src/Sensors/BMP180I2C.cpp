@@ -48,25 +48,26 @@ void BMP180I2C::endSensor() {
 /**
  * @brief Read sensor data
  * @param sensorData            Handle to sensor data struct
+ * @return true                 New values in the raw fields of sensorData
+ * @return false                No reading
  */
-void BMP180I2C::updateSensor(SensorDataStruct *sensorData) {
+boolean BMP180I2C::updateSensor(SensorDataStruct *sensorData) {
     if (!sensorData->sensorIsRuning) {
-        return;
+        return false;
     }
 
     sensors_event_t event;
     this->bmp->getEvent(&event);
-    if (event.pressure)
-    {
-        this->bmp->getTemperature(&sensorData->temperature);
-        sensorData->pressure = event.pressure;
-        sensorData->altitude = this->pressureToAltitude(sensorData->pressure, sensorData->temperature);
-
-        // Show some values
-        this->debugController->printLn("Temp: " + String(sensorData->temperature));
-        this->debugController->printLn("Pressure: " + String(sensorData->pressure));
-        this->debugController->printLn("Altitude: " + String(sensorData->altitude));
+    if (!event.pressure) {
+        return false;
     }
+    this->bmp->getTemperature(&sensorData->rawTemperature);
+    sensorData->rawPressure = event.pressure;
+
+    // Show some values
+    this->debugController->printLn("Temp: " + String(sensorData->rawTemperature));
+    this->debugController->printLn("Pressure: " + String(sensorData->rawPressure));
+    return true;
 }
 
 /**
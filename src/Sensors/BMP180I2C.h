@@ -17,7 +17,7 @@ public:
     void initialize(TwoWire *i2cInterface, SPIClass *spiInterface, uint8_t spiCsPin, uint8_t oneWirePin) override;
     boolean startSensor(SensorDataStruct *sensorData) override;
     void endSensor() override;
-    void updateSensor(SensorDataStruct *sensorData) override;
+    boolean updateSensor(SensorDataStruct *sensorData) override;
 
     boolean hasTemperature() override;
     boolean hasPressure() override;
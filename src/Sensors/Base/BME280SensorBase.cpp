@@ -21,22 +21,22 @@ void BME280SensorBase::endSensor() {
 /**
  * @brief Read sensor data
  * @param sensorData            Handle to sensor data struct
+ * @return true                 New values in the raw fields of sensorData
+ * @return false                No reading
  */
-void BME280SensorBase::updateSensor(SensorDataStruct *sensorData) {
-    if (!sensorData->sensorIsRuning) {
-        return;
+boolean BME280SensorBase::updateSensor(SensorDataStruct *sensorData) {
+    if (!sensorData->sensorIsRuning || !this->bme->takeForcedMeasurement()) {
+        return false;
     }
-    this->bme->takeForcedMeasurement();
-    sensorData->temperature = this->bme->readTemperature();
-    sensorData->pressure = this->bme->readPressure() / 100.0;
-    sensorData->humidity = this->bme->readHumidity();
-    sensorData->altitude = this->pressureToAltitude(sensorData->pressure, sensorData->temperature);
+    sensorData->rawTemperature = this->bme->readTemperature();
+    sensorData->rawPressure = this->bme->readPressure() / 100.0;
+    sensorData->rawHumidity = this->bme->readHumidity();
 
     // Show some values
-    this->debugController->printLn("Temp: " + String(sensorData->temperature));
-    this->debugController->printLn("Humidity: " + String(sensorData->humidity));
-    this->debugController->printLn("Pressure: " + String(sensorData->pressure));
-    this->debugController->printLn("Altitude: " + String(sensorData->altitude));
+    this->debugController->printLn("Temp: " + String(sensorData->rawTemperature));
+    this->debugController->printLn("Humidity: " + String(sensorData->rawHumidity));
+    this->debugController->printLn("Pressure: " + String(sensorData->rawPressure));
+    return !isnan(sensorData->rawTemperature) && !isnan(sensorData->rawPressure) && !isnan(sensorData->rawHumidity);
 }
 
 /**
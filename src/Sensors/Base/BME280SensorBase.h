@@ -14,7 +14,7 @@ protected:
 public:
     BME280SensorBase(String clientType, GlobalDataController *globalDataController, DebugController *debugController, JsonRequestClient *jsonRequestClient);
     void endSensor() override;
-    void updateSensor(SensorDataStruct *sensorData) override;
+    boolean updateSensor(SensorDataStruct *sensorData) override;
 
     boolean hasTemperature() override;
     boolean hasHumidity() override;
@@ -32,7 +32,9 @@ boolean BME680SensorBase::startSensor(SensorDataStruct *sensorData) {
     this->bme->setIIRFilterSize(BME680_FILTER_SIZE_3);
     this->bme->setGasHeater(320, 150); // 320*C for 150 ms
 
-    this->getGasReference();
+    // Gas reference is built up from the regular readings
+    this->gasReferenceReadings = 0;
+    this->measuring = false;
     return true;
 }
 
@@ -40,35 +42,67 @@ boolean BME680SensorBase::startSensor(SensorDataStruct *sensorData) {
  * @brief stop the sensor
  */
 void BME680SensorBase::endSensor() {
+    // Finish a running measurement, otherwise the driver would not start a new one
+    if (this->measuring) {
+        this->bme->endReading();
+        this->measuring = false;
+    }
 }
 
 /**
- * @brief Read sensor data
+ * @brief Start measurement, values are read by handleSensor() when the measurement is done
  * @param sensorData            Handle to sensor data struct
+ * @return false                Never a new reading at once
  */
-void BME680SensorBase::updateSensor(SensorDataStruct *sensorData) {
-    if (!sensorData->sensorIsRuning) {
-        return;
+boolean BME680SensorBase::updateSensor(SensorDataStruct *sensorData) {
+    if (!sensorData->sensorIsRuning || this->measuring) {
+        return false;
     }
-    if (!this->bme->performReading()) {
+    if (this->bme->beginReading() == 0) {
+        MemoryHelper::stringToChar("Failed to begin reading BME680", sensorData->error, 120);
+        return false;
+    }
+    this->measuring = true;
+    return false;
+}
+
+/**
+ * @brief Indicates if a measurement is running
+ * @return boolean 
+ */
+boolean BME680SensorBase::isMeasuring() {
+    return this->measuring;
+}
+
+/**
+ * @brief Read sensor data if the running measurement (incl. gas heater) is done
+ * @param sensorData            Handle to sensor data struct
+ * @return true                 New values in the raw fields of sensorData
+ * @return false                Still measuring or reading failed (see isMeasuring())
+ */
+boolean BME680SensorBase::handleSensor(SensorDataStruct *sensorData) {
+    if (!this->measuring || (this->bme->remainingReadingMillis() != Adafruit_BME680::reading_complete)) {
+        return false;
+    }
+    this->measuring = false;
+    if (!this->bme->endReading()) {
         MemoryHelper::stringToChar("Failed to perform reading BME680", sensorData->error, 120);
-        return;
+        return false;
     }
-    if ((getgasreference_count++)%10==0) this->getGasReference(); 
+    this->updateGasReference(this->bme->gas_resistance);
 
-    sensorData->temperature = this->bme->temperature;
-    sensorData->pressure = this->bme->pressure / 100.0;
-    sensorData->humidity = this->bme->humidity;
-    sensorData->airQuality = this->calculateIAQScore(sensorData);
+    sensorData->rawTemperature = this->bme->temperature;
+    sensorData->rawPressure = this->bme->pressure / 100.0;
+    sensorData->rawHumidity = this->bme->humidity;
+    sensorData->airQuality = this->calculateIAQScore(sensorData->rawHumidity);
     sensorData->gasResistance = this->bme->gas_resistance / 1000.0;
-    sensorData->altitude = this->pressureToAltitude(sensorData->pressure, sensorData->temperature);
 
     // Show some values
-    this->debugController->printLn("Temp: " + String(sensorData->temperature));
-    this->debugController->printLn("Humidity: " + String(sensorData->humidity));
-    this->debugController->printLn("Pressure: " + String(sensorData->pressure));
-    this->debugController->printLn("Altitude: " + String(sensorData->altitude));
+    this->debugController->printLn("Temp: " + String(sensorData->rawTemperature));
+    this->debugController->printLn("Humidity: " + String(sensorData->rawHumidity));
+    this->debugController->printLn("Pressure: " + String(sensorData->rawPressure));
     this->debugController->printLn("AIR Q..." + this->airQualityAsString(sensorData));
+    return true;
 }
 
 /**
@@ -121,12 +155,11 @@ boolean BME680SensorBase::hasAltitude() {
 
 /**
  * @brief Calculating humidity and gas sensor value to an air quality index value
- * @param sensorData            Handle to sensor data struct
+ * @param current_humidity      Relative humidity (%)
  * @return float 
  */
-float BME680SensorBase::calculateIAQScore(SensorDataStruct *sensorData) {
+float BME680SensorBase::calculateIAQScore(float current_humidity) {
     // Calculate humidity contribution to IAQ index
-    float current_humidity = sensorData->humidity;
     if (current_humidity >= 38 && current_humidity <= 42) {
         // Humidity +/-5% around optimum 
         this->hum_score = 0.25*100; 
@@ -151,14 +184,20 @@ float BME680SensorBase::calculateIAQScore(SensorDataStruct *sensorData) {
 }
 
 /**
- * @brief Run the sensor for a burn-in period, then use combination of relative humidity and gas resistance to estimate indoor air quality as a percentage.
+ * @brief Use the gas resistance of each reading for the reference: averaged over the first
+ * BME680_GAS_REFERENCE_READINGS readings (burn-in), then as moving average with the same weight.
+ * The combination of relative humidity and gas resistance estimates indoor air quality as a percentage.
+ * @param gasResistance         Gas resistance of the last reading (ohms)
  */
-void BME680SensorBase::getGasReference() {
-    int readings = 10;
-    for (int i = 1; i <= readings; i++) { // read gas for 10 x 0.150mS = 1.5secs
-        this->gas_reference += this->bme->readGas();
+void BME680SensorBase::updateGasReference(float gasResistance) {
+    if (this->gasReferenceReadings < BME680_GAS_REFERENCE_READINGS) {
+        this->gasReferenceReadings++;
+    }
+    if (this->gasReferenceReadings == 1) {
+        this->gas_reference = gasResistance;
+        return;
     }
-    this->gas_reference = this->gas_reference / readings;
+    this->gas_reference += (gasResistance - this->gas_reference) / this->gasReferenceReadings;
 }
 
 /**
@@ -167,7 +206,7 @@ void BME680SensorBase::getGasReference() {
  * @return String 
  */
 String BME680SensorBase::airQualityAsString(SensorDataStruct *sensorData) {
-    float score = this->calculateIAQScore(sensorData);
+    float score = this->calculateIAQScore(sensorData->humidity);
     score = (100-score)*5;
     if      (score >= 301)                  return "Hazardous";
     else if (score >= 201 && score <= 300 ) return "Very Unhealthy";
@@ -183,7 +222,7 @@ String BME680SensorBase::airQualityAsString(SensorDataStruct *sensorData) {
  * @return int 
  */
 int BME680SensorBase::airQualityAsInt(SensorDataStruct *sensorData) {
-    float score = this->calculateIAQScore(sensorData);
+    float score = this->calculateIAQScore(sensorData->humidity);
     score = (100-score)*5;
     if      (score >= 301)                  return 6;
     else if (score >= 201 && score <= 300 ) return 5;
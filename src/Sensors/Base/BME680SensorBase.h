@@ -4,6 +4,9 @@
 #include <Adafruit_Sensor.h>
 #include <Adafruit_BME680.h>
 
+// Number of readings averaged for the gas reference, afterwards it follows with the same weight
+#define BME680_GAS_REFERENCE_READINGS   10
+
 /**
  * @brief Basic implementation for an BME680 Sensor (I2C and SPI)
  */
@@ -16,13 +19,16 @@ protected:
     float hum_score, gas_score;
     float gas_reference = 250000;
     float hum_reference = 40;
-    int   getgasreference_count = 0;
+    int   gasReferenceReadings = 0;
+    bool  measuring = false;
 
 public:
     BME680SensorBase(String clientType, GlobalDataController *globalDataController, DebugController *debugController, JsonRequestClient *jsonRequestClient);
     boolean startSensor(SensorDataStruct *sensorData) override;
     void endSensor() override;
-    void updateSensor(SensorDataStruct *sensorData) override;
+    boolean updateSensor(SensorDataStruct *sensorData) override;
+    boolean isMeasuring() override;
+    boolean handleSensor(SensorDataStruct *sensorData) override;
 
     boolean hasTemperature() override;
     boolean hasHumidity() override;
@@ -34,7 +40,7 @@ public:
     int airQualityAsInt(SensorDataStruct *sensorData) override;
 
 protected:
-    float calculateIAQScore(SensorDataStruct *sensorData);
+    float calculateIAQScore(float current_humidity);
     String calculateIAQ(float score);
-    void getGasReference();
+    void updateGasReference(float gasResistance);
 };
@@ -33,26 +33,29 @@ void DHTxxSensorBase::endSensor() {
 /**
  * @brief Read sensor data
  * @param sensorData            Handle to sensor data struct
+ * @return true                 New values in the raw fields of sensorData
+ * @return false                No (complete) reading
  */
-void DHTxxSensorBase::updateSensor(SensorDataStruct *sensorData) {
+boolean DHTxxSensorBase::updateSensor(SensorDataStruct *sensorData) {
     if (!sensorData->sensorIsRuning) {
-        return;
+        return false;
     }
 
-    sensors_event_t event;
-    this->dht->temperature().getEvent(&event);
-    if (!isnan(event.temperature)) {
-        sensorData->temperature = event.temperature;
-    }
-
-    this->dht->humidity().getEvent(&event);
-    if (!isnan(event.relative_humidity)) {
-        sensorData->humidity = event.relative_humidity;
+    sensors_event_t temperatureEvent;
+    sensors_event_t humidityEvent;
+    this->dht->temperature().getEvent(&temperatureEvent);
+    this->dht->humidity().getEvent(&humidityEvent);
+    if (isnan(temperatureEvent.temperature) || isnan(humidityEvent.relative_humidity)) {
+        this->debugController->printLn("Failed to read from DHT sensor");
+        return false;
     }
+    sensorData->rawTemperature = temperatureEvent.temperature;
+    sensorData->rawHumidity = humidityEvent.relative_humidity;
 
     // Show some values
-    this->debugController->printLn("Temp: " + String(sensorData->temperature));
-    this->debugController->printLn("Humidity: " + String(sensorData->humidity));
+    this->debugController->printLn("Temp: " + String(sensorData->rawTemperature));
+    this->debugController->printLn("Humidity: " + String(sensorData->rawHumidity));
+    return true;
 }
 
 /**
@@ -15,7 +15,7 @@ public:
     DHTxxSensorBase(String clientType, GlobalDataController *globalDataController, DebugController *debugController, JsonRequestClient *jsonRequestClient);
     boolean startSensor(SensorDataStruct *sensorData) override;
     void endSensor() override;
-    void updateSensor(SensorDataStruct *sensorData) override;
+    boolean updateSensor(SensorDataStruct *sensorData) override;
 
     boolean hasTemperature() override;
     boolean hasHumidity() override;
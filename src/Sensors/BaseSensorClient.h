@@ -18,7 +18,11 @@ public:
     virtual void initialize(TwoWire *i2cInterface, SPIClass *spiInterface, uint8_t spiCsPin, uint8_t oneWirePin) = 0;
     virtual boolean startSensor(SensorDataStruct *sensorData) = 0;
     virtual void endSensor() = 0;
-    virtual void updateSensor(SensorDataStruct *sensorData) = 0;
+    virtual boolean updateSensor(SensorDataStruct *sensorData) = 0;
+    virtual boolean isMeasuring() = 0;
+    virtual boolean handleSensor(SensorDataStruct *sensorData) = 0;
+    virtual void addSample(SensorDataStruct *sensorData) = 0;
+    virtual void resetSamples(SensorDataStruct *sensorData) = 0;
 
     virtual boolean hasTemperature() = 0;
     virtual boolean hasHumidity() = 0;
@@ -39,6 +43,9 @@ public:
     static void resetData(SensorDataStruct *sensorData) {
         sensorData->activated = false;
         sensorData->showOnDisplay = false;
+        sensorData->rawTemperature = 0;
+        sensorData->rawPressure = 0;
+        sensorData->rawHumidity = 0;
         sensorData->pressure = 0;
         sensorData->humidity = 0;
         sensorData->gasResistance = 0;
@@ -46,6 +53,10 @@ public:
         sensorData->temperature = 0;
         sensorData->sensType = 0;
         sensorData->altitude = 0;
+        sensorData->sampleCount = 0;
+        memset(&sensorData->temperatureStats, 0, sizeof(SensorStatsDataStruct));
+        memset(&sensorData->humidityStats, 0, sizeof(SensorStatsDataStruct));
+        memset(&sensorData->pressureStats, 0, sizeof(SensorStatsDataStruct));
         MemoryHelper::stringToChar("", sensorData->error, 120);
     }
 };
\ No newline at end of file
@@ -1,5 +1,10 @@
 #include "BaseSensorClientImpl.h"
 
+float BaseSensorClientImpl::samples[SENSOR_SAMPLE_BUFFER][SENSOR_SAMPLE_VALUES];
+int BaseSensorClientImpl::sampleHead = 0;
+int BaseSensorClientImpl::sampleCount = 0;
+float BaseSensorClientImpl::emaValues[SENSOR_SAMPLE_VALUES];
+
 /**
  * @brief Construct a new Base Sensor Client Impl:: Base Sensor Client Impl object
  * 
@@ -36,4 +41,113 @@ String BaseSensorClientImpl::getType() {
  */
 float BaseSensorClientImpl::pressureToAltitude(float pressure, float temp) {
     return (1.0 - pow(pressure /SEALEVELPRESSURE_HPA,0.1903)) * (temp + 273.15F) / 0.0065F;
-}
\ No newline at end of file
+}
+/**
+ * @brief Store the raw values of a new reading in the ring buffer, set the filtered values
+ * and update the rolling statistics. Only call it once per reading of the sensor.
+ * @param sensorData            Handle to sensor data struct
+ */
+void BaseSensorClientImpl::addSample(SensorDataStruct *sensorData) {
+    if (!sensorData->sensorIsRuning
+        || isnan(sensorData->rawTemperature) || isnan(sensorData->rawHumidity) || isnan(sensorData->rawPressure)
+    ) {
+        return;
+    }
+    float *sample = BaseSensorClientImpl::samples[BaseSensorClientImpl::sampleHead];
+    sample[SENSOR_SAMPLE_TEMPERATURE] = sensorData->rawTemperature;
+    sample[SENSOR_SAMPLE_HUMIDITY] = sensorData->rawHumidity;
+    sample[SENSOR_SAMPLE_PRESSURE] = sensorData->rawPressure;
+    BaseSensorClientImpl::sampleHead = (BaseSensorClientImpl::sampleHead + 1) % SENSOR_SAMPLE_BUFFER;
+    if (BaseSensorClientImpl::sampleCount < SENSOR_SAMPLE_BUFFER) {
+        BaseSensorClientImpl::sampleCount++;
+    }
+
+    sensorData->temperature = BaseSensorClientImpl::filterValue(SENSOR_SAMPLE_TEMPERATURE, sensorData->rawTemperature);
+    sensorData->humidity = BaseSensorClientImpl::filterValue(SENSOR_SAMPLE_HUMIDITY, sensorData->rawHumidity);
+    sensorData->pressure = BaseSensorClientImpl::filterValue(SENSOR_SAMPLE_PRESSURE, sensorData->rawPressure);
+    if (this->hasAltitude()) {
+        sensorData->altitude = this->pressureToAltitude(sensorData->pressure, sensorData->temperature);
+    }
+
+    sensorData->sampleCount = BaseSensorClientImpl::sampleCount;
+    BaseSensorClientImpl::calculateStats(SENSOR_SAMPLE_TEMPERATURE, &sensorData->temperatureStats);
+    BaseSensorClientImpl::calculateStats(SENSOR_SAMPLE_HUMIDITY, &sensorData->humidityStats);
+    BaseSensorClientImpl::calculateStats(SENSOR_SAMPLE_PRESSURE, &sensorData->pressureStats);
+}
+
+/**
+ * @brief Drop all samples (e.g. sensor changed)
+ * @param sensorData            Handle to sensor data struct
+ */
+void BaseSensorClientImpl::resetSamples(SensorDataStruct *sensorData) {
+    BaseSensorClientImpl::sampleHead = 0;
+    BaseSensorClientImpl::sampleCount = 0;
+    sensorData->sampleCount = 0;
+    memset(&sensorData->temperatureStats, 0, sizeof(SensorStatsDataStruct));
+    memset(&sensorData->humidityStats, 0, sizeof(SensorStatsDataStruct));
+    memset(&sensorData->pressureStats, 0, sizeof(SensorStatsDataStruct));
+}
+
+/**
+ * @brief Filter value according to SENSOR_FILTER, the new sample is already in the ring buffer
+ * @param valueIdx              SENSOR_SAMPLE_*
+ * @param value                 New raw value
+ * @return float                Filtered value
+ */
+float BaseSensorClientImpl::filterValue(int valueIdx, float value) {
+#if SENSOR_FILTER == SENSOR_FILTER_MEDIAN
+    return BaseSensorClientImpl::medianOfLast(valueIdx, _min(BaseSensorClientImpl::sampleCount, SENSOR_FILTER_MEDIAN_SIZE));
+#elif SENSOR_FILTER == SENSOR_FILTER_EMA
+    if (BaseSensorClientImpl::sampleCount <= 1) {
+        BaseSensorClientImpl::emaValues[valueIdx] = value;
+    } else {
+        BaseSensorClientImpl::emaValues[valueIdx] += SENSOR_FILTER_EMA_ALPHA * (value - BaseSensorClientImpl::emaValues[valueIdx]);
+    }
+    return BaseSensorClientImpl::emaValues[valueIdx];
+#else
+    return value;
+#endif
+}
+
+/**
+ * @brief Median of the newest samples
+ * @param valueIdx              SENSOR_SAMPLE_*
+ * @param count                 Number of samples (1...SENSOR_FILTER_MEDIAN_SIZE)
+ * @return float 
+ */
+float BaseSensorClientImpl::medianOfLast(int valueIdx, int count) {
+    float sorted[SENSOR_FILTER_MEDIAN_SIZE];
+    for (int i = 0; i < count; i++) {
+        int idx = (BaseSensorClientImpl::sampleHead - 1 - i + SENSOR_SAMPLE_BUFFER) % SENSOR_SAMPLE_BUFFER;
+        float value = BaseSensorClientImpl::samples[idx][valueIdx];
+        // Insertion sort, count is small
+        int j = i;
+        while ((j > 0) && (sorted[j - 1] > value)) {
+            sorted[j] = sorted[j - 1];
+            j--;
+        }
+        sorted[j] = value;
+    }
+    if ((count % 2) == 0) {
+        return (sorted[count / 2 - 1] + sorted[count / 2]) / 2.0;
+    }
+    return sorted[count / 2];
+}
+
+/**
+ * @brief Min, max and average over all samples in the ring buffer
+ * @param valueIdx              SENSOR_SAMPLE_*
+ * @param stats                 Target
+ */
+void BaseSensorClientImpl::calculateStats(int valueIdx, SensorStatsDataStruct *stats) {
+    float sum = 0;
+    stats->min = BaseSensorClientImpl::samples[0][valueIdx];
+    stats->max = stats->min;
+    for (int i = 0; i < BaseSensorClientImpl::sampleCount; i++) {
+        float value = BaseSensorClientImpl::samples[i][valueIdx];
+        stats->min = _min(stats->min, value);
+        stats->max = _max(stats->max, value);
+        sum += value;
+    }
+    stats->avg = sum / _max(1, BaseSensorClientImpl::sampleCount);
+}
@@ -2,6 +2,12 @@
 #include "BaseSensorClient.h"
 #include "../Global/GlobalDataController.h"
 
+// Values kept per sample in the ring buffer
+#define SENSOR_SAMPLE_TEMPERATURE       0
+#define SENSOR_SAMPLE_HUMIDITY          1
+#define SENSOR_SAMPLE_PRESSURE          2
+#define SENSOR_SAMPLE_VALUES            3
+
 /**
  * @brief Basic implementations for an sensor client with needed data
  */
@@ -11,6 +17,14 @@ protected:
     DebugController *debugController;
     JsonRequestClient *jsonRequestClient;
     String clientType = "BME680";
+
+    /**
+     * Raw samples of the active sensor (only one sensor runs at a time, so the buffer is shared)
+     */
+    static float samples[SENSOR_SAMPLE_BUFFER][SENSOR_SAMPLE_VALUES];
+    static int sampleHead;
+    static int sampleCount;
+    static float emaValues[SENSOR_SAMPLE_VALUES];
     
 public:
     BaseSensorClientImpl(String clientType, GlobalDataController *globalDataController, DebugController *debugController, JsonRequestClient *jsonRequestClient);
@@ -18,7 +32,11 @@ public:
     void initialize(TwoWire *i2cInterface, SPIClass *spiInterface, uint8_t spiCsPin, uint8_t oneWirePin) {};
     boolean startSensor(SensorDataStruct *sensorData) { return false; };
     void endSensor() {};
-    void updateSensor(SensorDataStruct *sensorData) {};
+    boolean updateSensor(SensorDataStruct *sensorData) { return false; };
+    boolean isMeasuring() { return false; };
+    boolean handleSensor(SensorDataStruct *sensorData) { return false; };
+    void addSample(SensorDataStruct *sensorData);
+    void resetSamples(SensorDataStruct *sensorData);
     
     boolean hasTemperature() { return false; };
     boolean hasHumidity() { return false; };
@@ -34,6 +52,9 @@ public:
 
 protected:
     float pressureToAltitude(float pressure, float temp);
+    static float filterValue(int valueIdx, float value);
+    static float medianOfLast(int valueIdx, int count);
+    static void calculateStats(int valueIdx, SensorStatsDataStruct *stats);
     String roundValue(float value) {
         int rounded = (int)(value+0.5f);
         return String(rounded);
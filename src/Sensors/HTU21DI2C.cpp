@@ -47,18 +47,21 @@ void HTU21DI2C::endSensor() {
 /**
  * @brief Read sensor data
  * @param sensorData            Handle to sensor data struct
+ * @return true                 New values in the raw fields of sensorData
+ * @return false                No reading
  */
-void HTU21DI2C::updateSensor(SensorDataStruct *sensorData) {
+boolean HTU21DI2C::updateSensor(SensorDataStruct *sensorData) {
     if (!sensorData->sensorIsRuning) {
-        return;
+        return false;
     }
 
-    sensorData->temperature = this->htu->readTemperature();
-    sensorData->humidity = this->htu->readHumidity();
+    sensorData->rawTemperature = this->htu->readTemperature();
+    sensorData->rawHumidity = this->htu->readHumidity();
 
     // Show some values
-    this->debugController->printLn("Temp: " + String(sensorData->temperature));
-    this->debugController->printLn("Humidity: " + String(sensorData->humidity));
+    this->debugController->printLn("Temp: " + String(sensorData->rawTemperature));
+    this->debugController->printLn("Humidity: " + String(sensorData->rawHumidity));
+    return !isnan(sensorData->rawTemperature) && !isnan(sensorData->rawHumidity);
 }
 
 /**
@@ -4,9 +4,12 @@
 String lastMinute = "xx";
 String lastSecond = "xx";
 bool isFirstLoop = true;
+bool isWeatherSynced = false;
+int bootScreenTimer = TIMER_INVALID;
 
 void configModeCallback(WiFiManager *myWiFiManager);
 void handleSubroutineLoop();
+void handleBootStats();
 
 /**
  * @brief Setup/Initialize ESP
@@ -16,6 +19,12 @@ void setup() {
     LittleFS.begin();
     debugController.setup();
 
+    // Start WiFi with the cached access point first, the display is initialized while associating
+    String hostname(HOSTNAME);
+    hostname += String(ESP.getChipId(), HEX);
+    WiFi.hostname(hostname);
+    WifiQuickConnect::begin();
+
     // Init interfaces (SPI & I2C)
     i2cInterface->begin(I2C_SDA_PIN, I2C_SCL_PIN);
     SPI.pins(SPI_SCK, SPI_MISO, SPI_MOSI, SPI_CS);
@@ -46,22 +55,29 @@ void setup() {
     globalDataController.setup();
     globalDataController.getDisplayClient()->preSetup();
     globalDataController.getDisplayClient()->showBootScreen();
-    delay(5000);
+    bootScreenTimer = timerController.once(DISPLAY_BOOT_SCREEN_MILLIS, []() {});
 
-    // WiFiManager - Local intialization. Once its business is done, there is no need to keep it around
-    WiFiManager wifiManager;
-    wifiManager.setDebugOutput(DEBUG_MODE_ENABLE);
-    //wifiManager.resetSettings();    // Uncomment for testing wifi manager
-    wifiManager.setAPCallback(configModeCallback);
-    String hostname(HOSTNAME);
-    hostname += String(ESP.getChipId(), HEX);
-    WiFi.hostname(hostname);
-    if (!wifiManager.autoConnect((const char *)hostname.c_str())) { // new addition
-        delay(3000);
-        WiFi.disconnect(true);
-        ESP.reset();
-        delay(5000);
+    SystemDataStruct *systemSettings = globalDataController.getSystemSettings();
+    systemSettings->bootQuickConnect = WifiQuickConnect::waitForConnection(WIFI_QUICK_CONNECT_TIMEOUT, []() {
+        timerController.handle();
+    });
+    if (systemSettings->bootQuickConnect) {
+        debugController.printLn("WiFi quick connect");
+    } else {
+        // WiFiManager - Local intialization. Once its business is done, there is no need to keep it around
+        WiFiManager wifiManager;
+        wifiManager.setDebugOutput(DEBUG_MODE_ENABLE);
+        //wifiManager.resetSettings();    // Uncomment for testing wifi manager
+        wifiManager.setAPCallback(configModeCallback);
+        if (!wifiManager.autoConnect((const char *)hostname.c_str())) { // new addition
+            delay(3000);
+            WiFi.disconnect(true);
+            ESP.reset();
+            delay(5000);
+        }
     }
+    WifiQuickConnect::store();
+    systemSettings->bootWifiMillis = millis();
     
     globalDataController.getDisplayClient()->postSetup(false);
 
@@ -76,6 +92,8 @@ void setup() {
         });
         ArduinoOTA.onEnd([]() {
             debugController.printLn("\nEnd");
+            // Keep the last known data for the restart (filesystem is replaced by U_FS updates)
+            globalDataController.storeWarmStart(ArduinoOTA.getCommand() == U_FLASH);
         });
         ArduinoOTA.onProgress([](unsigned int progress, unsigned int total) {
             debugController.printF("Progress: %u%%\r", (progress / (total / 100)));
@@ -100,6 +118,8 @@ void setup() {
 
 #if WEBSERVER_ENABLED
     webServer.setup();
+    // Answer web requests while waiting for printer and weather responses
+    JsonRequestClient::setWaitHandler([]() { webServer.handleClient(); });
     globalDataController.getDisplayClient()->showWebserverSplashScreen(true);
 #else
     globalDataController.getDisplayClient()->showWebserverSplashScreen(false);
@@ -114,18 +134,28 @@ void setup() {
  * @brief Loop trough all
  */
 void loop() {
+    // Configuration changes received during the last requests, no printer data is in use here
+    webServer.handleDeferredActions();
+
     if (globalDataController.getDisplayClient()->isInTransitionMode()) {
         handleSubroutineLoop();
         return;
     }
 
     // Handle update of time
-    if(timeClient.handleSync(globalDataController.getSystemSettings()->clockWeatherResyncMinutes) 
-        && globalDataController.getWeatherSettings()->show
-    ) {
-        // We sync time? Ok, sync weather also!
-        debugController.printLn("Updating weather...");
-        weatherClient.updateWeather();
+    timeClient.handleSync(globalDataController.getSystemSettings()->clockWeatherResyncMinutes);
+
+    // The time response arrives within a few hundred ms, blocking requests meanwhile would falsify its round trip.
+    // On boot the first weather and printer requests are sent meanwhile, a late response is dropped and asked again.
+    if (timeClient.isSyncing() && (globalDataController.getSystemSettings()->bootDataMillis != 0)) {
+        handleSubroutineLoop();
+        return;
+    }
+
+    // Weather has its own refresh delay (observation interval, cache headers, retries).
+    // The fetch still blocks (web is served meanwhile), printers are polled after it returned.
+    if (globalDataController.handleWeatherSync()) {
+        isWeatherSynced = true;
         handleSubroutineLoop();
     }
 
@@ -139,8 +169,8 @@ void loop() {
         handleSubroutineLoop();
     }
 
-    // We have weather and time, show something on display
-    if (isFirstLoop) {
+    // We have weather and time, show something on display (but keep the boot screen for its minimum time)
+    if (isFirstLoop && !timerController.isActive(bootScreenTimer)) {
         globalDataController.getDisplayClient()->firstLoopCompleted();
         isFirstLoop = false;
         handleSubroutineLoop();
@@ -148,33 +178,62 @@ void loop() {
 
     // Sync only if we have printers
     if (globalDataController.getNumPrinters() > 0) {
-        PrinterDataStruct *presetPrinters = globalDataController.getPrinterSettings();
         long cEpoch = timeClient.getCurrentEpoch();
         for(int i=0; i<globalDataController.getNumPrinters(); i++) {
+            // Web handlers may add or remove printers between the polls, so the list is read again each time
+            PrinterDataStruct *printer = &(globalDataController.getPrinterSettings()[i]);
             int secFromLastSyn = -1;
-            if (presetPrinters[i].lastSyncEpoch > 0) {
-                secFromLastSyn = timeClient.getSecondsFromLast(presetPrinters[i].lastSyncEpoch);
+            if (printer->lastSyncEpoch > 0) {
+                secFromLastSyn = timeClient.getSecondsFromLast(printer->lastSyncEpoch);
             }
             if ((secFromLastSyn < 0) ||
-                (!presetPrinters[i].isPrinting && (secFromLastSyn >= PRINTER_SYNC_SEC)) ||
-                (presetPrinters[i].isPrinting && (secFromLastSyn >= PRINTER_SYNC_SEC_PRINTING))
+                (!printer->isPrinting && (secFromLastSyn >= PRINTER_SYNC_SEC)) ||
+                (printer->isPrinting && (secFromLastSyn >= PRINTER_SYNC_SEC_PRINTING))
              ) {
                 globalDataController.ledOnOff(true);
-                presetPrinters[i].lastSyncEpoch = cEpoch;
-                globalDataController.syncPrinter(&presetPrinters[i]);
+                printer->lastSyncEpoch = cEpoch;
+                globalDataController.syncPrinter(printer);
                 globalDataController.ledOnOff(false);
             }
             // Handle some web between the printers to avoid blocking!
             handleSubroutineLoop();
         }
     }
+    handleBootStats();
     handleSubroutineLoop();
 }
 
+/**
+ * @brief Measure time from boot until time, weather and all printers have data
+ */
+void handleBootStats() {
+    SystemDataStruct *systemSettings = globalDataController.getSystemSettings();
+    if ((systemSettings->bootDataMillis != 0)
+        || !timeClient.isTimeValid()
+        || (globalDataController.getWeatherSettings()->show && !isWeatherSynced)
+    ) {
+        return;
+    }
+    PrinterDataStruct *presetPrinters = globalDataController.getPrinterSettings();
+    for(int i=0; i<globalDataController.getNumPrinters(); i++) {
+        if ((presetPrinters[i].lastSyncEpoch == 0) || (presetPrinters[i].cachedEpoch > 0)) {
+            return;
+        }
+    }
+    systemSettings->bootDataMillis = millis();
+    debugController.printLn("Boot to first data: " + String(systemSettings->bootDataMillis) + " ms");
+}
+
 /**
  * @brief Functions to avoid permantent blocking between longer routines
  */
 void handleSubroutineLoop() {
+    // Handle all pending timers
+    timerController.handle();
+
+    // Handle running sensor measurement
+    globalDataController.handleSensor();
+
     // Handle Display
     globalDataController.syncDisplay();
 
@@ -199,5 +258,6 @@ void configModeCallback(WiFiManager *myWiFiManager) {
     debugController.printLn("Please connect to AP");
     debugController.printLn(myWiFiManager->getConfigPortalSSID());
     debugController.printLn("To setup Wifi Configuration");
-    globalDataController.flashLED(20, 50);
+    // Config portal is blocking, no timers are handled: LED stays on until we are connected
+    globalDataController.ledOnOff(true);
 }
@@ -0,0 +1,82 @@
+#pragma once
+/**
+ * @brief Minimal Arduino core for the host build (env:native)
+ * Only covers what the display library and the host tested sources need.
+ */
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <algorithm>
+#include <chrono>
+#include <string>
+#include <thread>
+
+#define PROGMEM
+#define pgm_read_byte(addr)     (*(const unsigned char *)(addr))
+#define _min(a, b)              ((a) < (b) ? (a) : (b))
+#define _max(a, b)              ((a) > (b) ? (a) : (b))
+
+using std::min;
+using std::max;
+
+typedef bool boolean;
+typedef uint8_t byte;
+
+inline unsigned long micros() {
+    static auto start = std::chrono::steady_clock::now();
+    return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count();
+}
+
+inline unsigned long millis() {
+    return micros() / 1000;
+}
+
+inline void delay(unsigned long ms) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(ms));
+}
+
+inline void yield() {
+}
+
+inline char *dtostrf(double number, signed char width, unsigned char prec, char *s) {
+    sprintf(s, "%*.*f", width, prec, number);
+    return s;
+}
+
+class String {
+private:
+    std::string value;
+
+public:
+    String(const char *s = "") : value(s == NULL ? "" : s) {}
+    String(const std::string &s) : value(s) {}
+    unsigned int length() const { return this->value.length(); }
+    const char *c_str() const { return this->value.c_str(); }
+    void toCharArray(char *buf, unsigned int bufsize, unsigned int index = 0) const {
+        if (bufsize == 0) {
+            return;
+        }
+        size_t len = this->value.copy(buf, bufsize - 1, index);
+        buf[len] = 0;
+    }
+    String operator+(const String &other) const { return String(this->value + other.value); }
+    bool operator==(const String &other) const { return this->value == other.value; }
+};
+
+class Print {
+public:
+    virtual ~Print() {}
+    virtual size_t write(uint8_t c) = 0;
+    virtual size_t write(const uint8_t *buffer, size_t size) {
+        size_t n = 0;
+        while (size--) {
+            n += this->write(*buffer++);
+        }
+        return n;
+    }
+    size_t print(const char *str) {
+        return this->write((const uint8_t *)str, strlen(str));
+    }
+};
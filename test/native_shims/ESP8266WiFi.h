@@ -0,0 +1,3 @@
+#pragma once
+// Not available on the host build (env:native)
+#include <Arduino.h>
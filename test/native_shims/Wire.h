@@ -0,0 +1,17 @@
+#pragma once
+#include <Arduino.h>
+
+/**
+ * @brief I2C bus stand-in for the host build (env:native), all transmissions are dropped
+ */
+class TwoWire {
+public:
+    void begin(int sda = -1, int scl = -1) {}
+    void setClock(uint32_t frequency) {}
+    void beginTransmission(uint8_t address) {}
+    uint8_t endTransmission(bool sendStop = true) { return 0; }
+    size_t write(uint8_t data) { return 1; }
+    size_t write(const uint8_t *data, size_t quantity) { return quantity; }
+};
+
+static TwoWire Wire;
@@ -0,0 +1,199 @@
+#include <Arduino.h>
+#include <unity.h>
+#include <OLEDDisplay.h>
+#include "Display/Extras/Oled/OledFrameRenderer.h"
+#include "Display/Extras/Oled/OledPartialRefresh.h"
+#include "Global/ViewFormatter.h"
+
+// Set to regenerate the golden images (check the new images before committing them!)
+#define GOLDEN_UPDATE_ENV   "OLED_RENDER_UPDATE_GOLDEN"
+
+/**
+ * @brief In-memory 128x64 display which flushes like the SSD1306 partial refresh driver
+ */
+class TestOledDisplay : public OLEDDisplay, public OledPartialRefresh {
+public:
+    TestOledDisplay() : OledPartialRefresh(0x3c) {}
+    void display(void) {
+        this->flushDirtyWindows(this->buffer, this->buffer_back, this->width(), this->height() / 8);
+    }
+
+protected:
+    int getBufferOffset(void) { return 0; }
+    bool connect() { return true; }
+    void sendWindow(uint8_t page, uint8_t startX, uint8_t endX, uint8_t *data) {
+        this->writeCommand(COLUMNADDR);
+        this->writeCommand(startX);
+        this->writeCommand(endX);
+        this->writeCommand(PAGEADDR);
+        this->writeCommand(page);
+        this->writeCommand(page);
+        this->writeData(data, endX - startX + 1);
+    }
+};
+
+/**
+ * @brief Collects the PBM dump of a frame
+ */
+class PbmCollector : public Print {
+public:
+    std::string data;
+    size_t write(uint8_t c) {
+        this->data.push_back((char)c);
+        return 1;
+    }
+};
+
+TestOledDisplay *testDisplay;
+TimeViewDataStruct timeView;
+
+void setUp(void) {
+    testDisplay = new TestOledDisplay();
+    testDisplay->init();
+    memset(&timeView, 0, sizeof(TimeViewDataStruct));
+    timeView.is24h = true;
+    strcpy(timeView.clockShort, "12:34");
+}
+
+void tearDown(void) {
+    // Release the buffers while getBufferOffset() can still be called (base destructor would call it)
+    testDisplay->end();
+    delete testDisplay;
+}
+
+/**
+ * @brief Synthetic printer in printing state
+ * @param printer           Target
+ */
+void fillPrinter(PrinterDataStruct *printer) {
+    memset(printer, 0, sizeof(PrinterDataStruct));
+    strcpy(printer->customName, "Prusa MK3");
+    strcpy(printer->remoteAddress, "192.168.1.20");
+    printer->remotePort = 80;
+    printer->state = PRINTER_STATE_PRINTING;
+    printer->isPrinting = true;
+    printer->progressCompletion = 42;
+    printer->progressPrintTime = 3723;
+    printer->progressPrintTimeLeft = 5140;
+    printer->toolTemp = 214.6;
+    printer->toolTargetTemp = 215;
+    printer->bedTemp = 59.8;
+    printer->bedTargetTemp = 60;
+}
+
+/**
+ * @brief Render one printer frame (with header) and flush it, like a ui update on the device
+ * @param printer           Printer data
+ * @param numPages          Pages for the header blobs
+ * @return uint32_t         Bytes flushed to the display
+ */
+uint32_t renderPrinterFrame(PrinterDataStruct *printer, int numPages) {
+    PrinterViewDataStruct view;
+    char message[80];
+    memset(&view, 0, sizeof(PrinterViewDataStruct));
+    uint32_t flushedBefore = testDisplay->getFlushedBytes();
+
+    unsigned long startMicros = micros();
+    ViewFormatter::formatPrinter(&view, printer, "OctoPrint");
+    testDisplay->clear();
+    OledFrameRenderer::drawInformationHeader(testDisplay, &timeView, numPages, 0);
+    OledFrameRenderer::drawPrinterState(testDisplay, printer, &view, 0, 0);
+    testDisplay->display();
+    unsigned long frameMicros = micros() - startMicros;
+
+    uint32_t flushed = testDisplay->getFlushedBytes() - flushedBefore;
+    snprintf(message, sizeof(message), "%s: %lu us per frame, %u bytes flushed", printer->customName, frameMicros, flushed);
+    TEST_MESSAGE(message);
+    return flushed;
+}
+
+/**
+ * @brief Compare the current frame against its golden image
+ * @param name              Name of the golden image (test/test_oled_render/golden/<name>.pbm)
+ */
+void assertGolden(const char *name) {
+    PbmCollector collector;
+    OledFrameRenderer::sendFrameBuffer(testDisplay, &collector);
+    TEST_ASSERT_EQUAL(OledFrameRenderer::getFrameBufferDumpSize(testDisplay), collector.data.size());
+
+    std::string path = __FILE__;
+    path = path.substr(0, path.find_last_of("/\\") + 1) + "golden/" + name + ".pbm";
+    if (getenv(GOLDEN_UPDATE_ENV) != NULL) {
+        FILE *file = fopen(path.c_str(), "wb");
+        TEST_ASSERT_NOT_NULL_MESSAGE(file, path.c_str());
+        fwrite(collector.data.data(), 1, collector.data.size(), file);
+        fclose(file);
+        return;
+    }
+
+    std::string golden;
+    char chunk[256];
+    size_t len;
+    FILE *file = fopen(path.c_str(), "rb");
+    TEST_ASSERT_NOT_NULL_MESSAGE(file, path.c_str());
+    while ((len = fread(chunk, 1, sizeof(chunk), file)) > 0) {
+        golden.append(chunk, len);
+    }
+    fclose(file);
+    TEST_ASSERT_EQUAL_MESSAGE(golden.size(), collector.data.size(), name);
+    TEST_ASSERT_EQUAL_MEMORY_MESSAGE(golden.data(), collector.data.data(), golden.size(), name);
+}
+
+void test_printer_printing(void) {
+    PrinterDataStruct printer;
+    fillPrinter(&printer);
+    renderPrinterFrame(&printer, 1);
+    assertGolden("printer_printing");
+}
+
+void test_printer_cached_without_bed(void) {
+    PrinterDataStruct printer;
+    fillPrinter(&printer);
+    strcpy(printer.customName, "Ender 3");
+    printer.cachedEpoch = 1600000000;
+    printer.bedTemp = 0;
+    printer.bedTargetTemp = 0;
+    renderPrinterFrame(&printer, 1);
+    assertGolden("printer_cached_without_bed");
+}
+
+void test_printer_progress_capped(void) {
+    PrinterDataStruct printer;
+    fillPrinter(&printer);
+    printer.progressCompletion = 100;
+    printer.progressPrintTimeLeft = 0;
+    renderPrinterFrame(&printer, 1);
+    assertGolden("printer_progress_capped");
+}
+
+void test_header_12h_with_pages(void) {
+    PrinterDataStruct printer;
+    fillPrinter(&printer);
+    timeView.is24h = false;
+    strcpy(timeView.clockShort, "9:05");
+    strcpy(timeView.amPm, "PM");
+    renderPrinterFrame(&printer, 3);
+    assertGolden("header_12h_with_pages");
+}
+
+void test_partial_refresh_sends_changes_only(void) {
+    PrinterDataStruct printer;
+    fillPrinter(&printer);
+    uint32_t fullFrame = renderPrinterFrame(&printer, 1);
+    TEST_ASSERT_EQUAL_UINT32(0, renderPrinterFrame(&printer, 1));
+
+    printer.progressCompletion = 43;
+    uint32_t changedFrame = renderPrinterFrame(&printer, 1);
+    TEST_ASSERT_GREATER_THAN_UINT32(0, changedFrame);
+    TEST_ASSERT_LESS_THAN_UINT32(fullFrame / 4, changedFrame);
+}
+
+int main(int argc, char **argv) {
+    UNITY_BEGIN();
+    RUN_TEST(test_printer_printing);
+    RUN_TEST(test_printer_cached_without_bed);
+    RUN_TEST(test_printer_progress_capped);
+    RUN_TEST(test_header_12h_with_pages);
+    RUN_TEST(test_partial_refresh_sends_changes_only);
+    return UNITY_END();
+}
@@ -0,0 +1,161 @@
+#include <Arduino.h>
+#include <unity.h>
+#include <limits.h>
+#include "Network/TimeSyncMath.h"
+
+// Unix time of the stand-in server (2021-01-01 00:00:00)
+#define SERVER_EPOCH        1609459200UL
+#define REQUEST_NONCE       0x1234abcdUL
+
+byte request[NTP_PACKET_SIZE];
+byte response[NTP_PACKET_SIZE];
+TimeSyncDataStruct result;
+
+void setUp(void) {
+    TimeSyncMath::buildRequest(request, REQUEST_NONCE);
+    memset(response, 0, NTP_PACKET_SIZE);
+    memset(&result, 0, sizeof(TimeSyncDataStruct));
+}
+
+void tearDown(void) {
+}
+
+/**
+ * @brief NTP fraction of a second, rounded up so it reads back as the same millisecond
+ * @param ms                Milliseconds
+ * @return uint32_t 
+ */
+uint32_t msToFraction(uint32_t ms) {
+    return (((uint64_t)ms << 32) + 999) / 1000;
+}
+
+/**
+ * @brief Stand-in for a SNTP server, answers the request like a server would
+ * @param stratum           Stratum of the server (0 = kiss of death)
+ * @param receiveMs         Milliseconds after SERVER_EPOCH when the request was received
+ * @param processingMs      Time from receive to transmit of the response
+ */
+void answerRequest(uint8_t stratum, uint32_t receiveMs, uint32_t processingMs) {
+    uint32_t transmitMs = receiveMs + processingMs;
+    response[0] = 0x24;     // LI = 0, Version = 4, Mode = 4 (server)
+    response[1] = stratum;
+    memcpy(&response[24], &request[40], 8);     // Originate timestamp = transmit timestamp of the request
+    TimeSyncMath::writeUInt32(&response[32], SERVER_EPOCH + NTP_UNIX_OFFSET + (receiveMs / 1000));
+    TimeSyncMath::writeUInt32(&response[36], msToFraction(receiveMs % 1000));
+    TimeSyncMath::writeUInt32(&response[40], SERVER_EPOCH + NTP_UNIX_OFFSET + (transmitMs / 1000));
+    TimeSyncMath::writeUInt32(&response[44], msToFraction(transmitMs % 1000));
+}
+
+void test_request_packet(void) {
+    TEST_ASSERT_EQUAL(0x23, request[0]);
+    TEST_ASSERT_EQUAL_UINT32(REQUEST_NONCE, TimeSyncMath::readUInt32(&request[40]));
+}
+
+void test_half_round_trip_is_added(void) {
+    answerRequest(2, 200, 0);
+    TEST_ASSERT_TRUE(TimeSyncMath::parseResponse(response, REQUEST_NONCE, 100, &result));
+    TEST_ASSERT_EQUAL(100, result.roundTripMs);
+    TEST_ASSERT_EQUAL(SERVER_EPOCH, result.epoch);
+    TEST_ASSERT_EQUAL(250, result.epochMs);
+}
+
+void test_server_processing_is_not_round_trip(void) {
+    answerRequest(1, 100, 200);
+    TEST_ASSERT_TRUE(TimeSyncMath::parseResponse(response, REQUEST_NONCE, 260, &result));
+    TEST_ASSERT_EQUAL(60, result.roundTripMs);
+    TEST_ASSERT_EQUAL(SERVER_EPOCH, result.epoch);
+    TEST_ASSERT_EQUAL(330, result.epochMs);
+}
+
+void test_processing_over_second_boundary(void) {
+    answerRequest(2, 900, 300);
+    TEST_ASSERT_TRUE(TimeSyncMath::parseResponse(response, REQUEST_NONCE, 340, &result));
+    TEST_ASSERT_EQUAL(40, result.roundTripMs);
+    TEST_ASSERT_EQUAL(SERVER_EPOCH + 1, result.epoch);
+    TEST_ASSERT_EQUAL(220, result.epochMs);
+}
+
+void test_delay_carries_into_next_second(void) {
+    answerRequest(2, 980, 0);
+    TEST_ASSERT_TRUE(TimeSyncMath::parseResponse(response, REQUEST_NONCE, 100, &result));
+    TEST_ASSERT_EQUAL(SERVER_EPOCH + 1, result.epoch);
+    TEST_ASSERT_EQUAL(30, result.epochMs);
+}
+
+void test_negative_round_trip_adds_no_delay(void) {
+    // Server claims more processing time than the whole request took
+    answerRequest(2, 0, 500);
+    TEST_ASSERT_TRUE(TimeSyncMath::parseResponse(response, REQUEST_NONCE, 300, &result));
+    TEST_ASSERT_EQUAL(-200, result.roundTripMs);
+    TEST_ASSERT_EQUAL(SERVER_EPOCH, result.epoch);
+    TEST_ASSERT_EQUAL(500, result.epochMs);
+}
+
+void test_invalid_responses_are_rejected(void) {
+    answerRequest(2, 0, 0);
+    TEST_ASSERT_FALSE_MESSAGE(TimeSyncMath::parseResponse(response, REQUEST_NONCE + 1, 50, &result), "Other nonce");
+
+    answerRequest(0, 0, 0);
+    TEST_ASSERT_FALSE_MESSAGE(TimeSyncMath::parseResponse(response, REQUEST_NONCE, 50, &result), "Kiss of death");
+
+    answerRequest(16, 0, 0);
+    TEST_ASSERT_FALSE_MESSAGE(TimeSyncMath::parseResponse(response, REQUEST_NONCE, 50, &result), "Unsynchronized");
+
+    answerRequest(2, 0, 0);
+    response[0] = 0x23;
+    TEST_ASSERT_FALSE_MESSAGE(TimeSyncMath::parseResponse(response, REQUEST_NONCE, 50, &result), "Client mode");
+}
+
+void test_clock_offset(void) {
+    // Running clock started second 100 at millis 5000, the new time says second 105 started at millis 9700
+    TEST_ASSERT_EQUAL(300, TimeSyncMath::getClockOffset(105, 9700, 100, 5000));
+    TEST_ASSERT_EQUAL(-250, TimeSyncMath::getClockOffset(105, 10250, 100, 5000));
+    TEST_ASSERT_EQUAL(0, TimeSyncMath::getClockOffset(100, 5000, 100, 5000));
+}
+
+void test_clock_offset_over_millis_overflow(void) {
+    unsigned long localMillis = ULONG_MAX - 499;
+    TEST_ASSERT_EQUAL(100, TimeSyncMath::getClockOffset(101, localMillis + 900, 100, localMillis));
+}
+
+void test_slew_limit(void) {
+    TEST_ASSERT_TRUE(TimeSyncMath::canSlew(TIME_SLEW_MAX_MS));
+    TEST_ASSERT_TRUE(TimeSyncMath::canSlew(-TIME_SLEW_MAX_MS));
+    TEST_ASSERT_FALSE(TimeSyncMath::canSlew(TIME_SLEW_MAX_MS + 1));
+    TEST_ASSERT_FALSE(TimeSyncMath::canSlew(-TIME_SLEW_MAX_MS - 1));
+}
+
+void test_slew_step(void) {
+    TEST_ASSERT_EQUAL(5, TimeSyncMath::getSlewStep(300, 100));
+    TEST_ASSERT_EQUAL(-5, TimeSyncMath::getSlewStep(-300, 100));
+    TEST_ASSERT_EQUAL(0, TimeSyncMath::getSlewStep(300, TIME_SLEW_RATE_DIVIDER - 1));
+    TEST_ASSERT_EQUAL(3, TimeSyncMath::getSlewStep(3, 1000));
+    TEST_ASSERT_EQUAL(-3, TimeSyncMath::getSlewStep(-3, 1000));
+}
+
+void test_slew_completes(void) {
+    long remainingMs = 1500;
+    unsigned long elapsedMillis = 0;
+    while (remainingMs != 0) {
+        remainingMs -= TimeSyncMath::getSlewStep(remainingMs, 100);
+        elapsedMillis += 100;
+    }
+    TEST_ASSERT_EQUAL(1500 * TIME_SLEW_RATE_DIVIDER, elapsedMillis);
+}
+
+int main(int argc, char **argv) {
+    UNITY_BEGIN();
+    RUN_TEST(test_request_packet);
+    RUN_TEST(test_half_round_trip_is_added);
+    RUN_TEST(test_server_processing_is_not_round_trip);
+    RUN_TEST(test_processing_over_second_boundary);
+    RUN_TEST(test_delay_carries_into_next_second);
+    RUN_TEST(test_negative_round_trip_adds_no_delay);
+    RUN_TEST(test_invalid_responses_are_rejected);
+    RUN_TEST(test_clock_offset);
+    RUN_TEST(test_clock_offset_over_millis_overflow);
+    RUN_TEST(test_slew_limit);
+    RUN_TEST(test_slew_step);
+    RUN_TEST(test_slew_completes);
+    return UNITY_END();
+}
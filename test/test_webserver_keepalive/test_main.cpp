@@ -0,0 +1,196 @@
+#include <Arduino.h>
+#include <unity.h>
+#include "Network/WebserverKeepAlive.h"
+
+// Model of the web server, times in ms. Only one connection is served at a time.
+#define CONNECT_MILLIS      15      // Accept, TCP handshake and close of a connection
+#define REQUEST_MILLIS      25      // Read request and send response
+#define NEXT_REQUEST_MILLIS 5       // Browser sends the next request of the page after this time
+#define PAGE_REQUESTS       6       // Page, styles, script and api requests of one page load
+#define MAX_BROWSERS        2
+#define SIMULATION_MILLIS   60000
+
+#define KEEPALIVE_OFF       0       // Every request on its own connection
+#define KEEPALIVE_IDLE_ONLY 1       // Idle connection only closed after WEBSERVER_KEEPALIVE_IDLE_MILLIS
+#define KEEPALIVE_POLICY    2       // WebserverKeepAlive::shouldClose
+
+typedef struct {
+    int requestsDone;
+    unsigned long readyAt;
+    unsigned long firstResponseAt;
+} SimBrowserStruct;
+
+typedef struct {
+    unsigned long totalMillis;
+    unsigned long lastFirstResponseMillis;
+} SimResultStruct;
+
+void setUp(void) {
+}
+
+void tearDown(void) {
+}
+
+/**
+ * @brief Check if the browser has a request to send
+ * @param browser           Browser to check
+ * @param now               Simulation time
+ * @return true
+ * @return false
+ */
+bool isRequestReady(SimBrowserStruct *browser, unsigned long now) {
+    return (browser->requestsDone < PAGE_REQUESTS) && (browser->readyAt <= now);
+}
+
+/**
+ * @brief Load one page in every browser against the model of the web server, browsers start at the same time
+ * @param browserCnt        Number of browsers
+ * @param mode              KEEPALIVE_OFF, KEEPALIVE_IDLE_ONLY or KEEPALIVE_POLICY
+ * @return SimResultStruct  Time until all pages are loaded and until the last browser got its first response
+ */
+SimResultStruct simulatePageLoads(int browserCnt, int mode) {
+    SimBrowserStruct browsers[MAX_BROWSERS];
+    memset(browsers, 0, sizeof(browsers));
+    SimResultStruct result = {0, 0};
+    int connectionOwner = -1;
+    int servedBrowser = -1;
+    unsigned long busyUntil = 0;
+    unsigned long idleSince = 0;
+
+    for (unsigned long now = 0; now < SIMULATION_MILLIS; now++) {
+        if (now < busyUntil) {
+            continue;
+        }
+
+        // Response of the running request is sent
+        if (servedBrowser >= 0) {
+            SimBrowserStruct *browser = &browsers[servedBrowser];
+            browser->requestsDone++;
+            browser->readyAt = now + NEXT_REQUEST_MILLIS;
+            if (browser->requestsDone == 1) {
+                browser->firstResponseAt = now;
+            }
+            if (mode == KEEPALIVE_OFF) {
+                connectionOwner = -1;
+            }
+            servedBrowser = -1;
+            idleSince = now;
+        }
+
+        int doneCnt = 0;
+        for (int i = 0; i < browserCnt; i++) {
+            doneCnt += (browsers[i].requestsDone == PAGE_REQUESTS) ? 1 : 0;
+        }
+        if (doneCnt == browserCnt) {
+            result.totalMillis = now;
+            break;
+        }
+
+        // Open keep-alive connection, serve the next request or check if it has to be closed
+        if (connectionOwner >= 0) {
+            if (isRequestReady(&browsers[connectionOwner], now)) {
+                servedBrowser = connectionOwner;
+                busyUntil = now + REQUEST_MILLIS;
+                continue;
+            }
+            bool clientWaiting = false;
+            for (int i = 0; i < browserCnt; i++) {
+                clientWaiting |= (i != connectionOwner) && isRequestReady(&browsers[i], now);
+            }
+            if (mode == KEEPALIVE_IDLE_ONLY) {
+                clientWaiting = false;
+            }
+            if (!WebserverKeepAlive::shouldClose(now - idleSince, clientWaiting)) {
+                continue;
+            }
+            connectionOwner = -1;
+        }
+
+        // Accept the next waiting connection, browsers that are waiting longer first
+        for (int i = 0; i < browserCnt; i++) {
+            if (isRequestReady(&browsers[i], now) && ((servedBrowser < 0) || (browsers[i].readyAt < browsers[servedBrowser].readyAt))) {
+                servedBrowser = i;
+            }
+        }
+        if (servedBrowser >= 0) {
+            connectionOwner = servedBrowser;
+            busyUntil = now + CONNECT_MILLIS + REQUEST_MILLIS;
+        }
+    }
+
+    for (int i = 0; i < browserCnt; i++) {
+        result.lastFirstResponseMillis = _max(result.lastFirstResponseMillis, browsers[i].firstResponseAt);
+    }
+    return result;
+}
+
+/**
+ * @brief Requests per second of a simulation
+ * @param result            Result of simulatePageLoads
+ * @param browserCnt        Number of browsers
+ * @return unsigned long
+ */
+unsigned long getRequestsPerSecond(SimResultStruct result, int browserCnt) {
+    return (browserCnt * PAGE_REQUESTS * 1000UL) / result.totalMillis;
+}
+
+/**
+ * @brief Print the result of a simulation
+ * @param name              Name of the case
+ * @param result            Result of simulatePageLoads
+ * @param browserCnt        Number of browsers
+ */
+void printResult(const char *name, SimResultStruct result, int browserCnt) {
+    char message[120];
+    snprintf(message, sizeof(message), "%s: %lu ms, %lu req/s, last first response after %lu ms",
+        name, result.totalMillis, getRequestsPerSecond(result, browserCnt), result.lastFirstResponseMillis);
+    TEST_MESSAGE(message);
+}
+
+void test_idle_connection_is_kept(void) {
+    TEST_ASSERT_FALSE(WebserverKeepAlive::shouldClose(WEBSERVER_KEEPALIVE_BUSY_IDLE_MILLIS + 1, false));
+    TEST_ASSERT_FALSE(WebserverKeepAlive::shouldClose(WEBSERVER_KEEPALIVE_IDLE_MILLIS, false));
+    TEST_ASSERT_TRUE(WebserverKeepAlive::shouldClose(WEBSERVER_KEEPALIVE_IDLE_MILLIS + 1, false));
+}
+
+void test_idle_connection_is_closed_for_waiting_client(void) {
+    TEST_ASSERT_FALSE(WebserverKeepAlive::shouldClose(WEBSERVER_KEEPALIVE_BUSY_IDLE_MILLIS, true));
+    TEST_ASSERT_TRUE(WebserverKeepAlive::shouldClose(WEBSERVER_KEEPALIVE_BUSY_IDLE_MILLIS + 1, true));
+}
+
+void test_single_browser_is_faster(void) {
+    SimResultStruct withoutKeepAlive = simulatePageLoads(1, KEEPALIVE_OFF);
+    SimResultStruct withKeepAlive = simulatePageLoads(1, KEEPALIVE_POLICY);
+    printResult("1 browser, keep-alive off", withoutKeepAlive, 1);
+    printResult("1 browser, keep-alive", withKeepAlive, 1);
+    TEST_ASSERT_GREATER_THAN_UINT32(getRequestsPerSecond(withoutKeepAlive, 1), getRequestsPerSecond(withKeepAlive, 1));
+}
+
+void test_two_browsers_are_faster(void) {
+    SimResultStruct withoutKeepAlive = simulatePageLoads(2, KEEPALIVE_OFF);
+    SimResultStruct withKeepAlive = simulatePageLoads(2, KEEPALIVE_POLICY);
+    printResult("2 browsers, keep-alive off", withoutKeepAlive, 2);
+    printResult("2 browsers, keep-alive", withKeepAlive, 2);
+    TEST_ASSERT_GREATER_THAN_UINT32(getRequestsPerSecond(withoutKeepAlive, 2), getRequestsPerSecond(withKeepAlive, 2));
+}
+
+void test_second_browser_is_not_blocked_by_idle_connection(void) {
+    SimResultStruct idleOnly = simulatePageLoads(2, KEEPALIVE_IDLE_ONLY);
+    SimResultStruct withKeepAlive = simulatePageLoads(2, KEEPALIVE_POLICY);
+    printResult("2 browsers, keep-alive closed only after idle time", idleOnly, 2);
+    // Without the waiting check, the second browser waits for the whole idle time
+    TEST_ASSERT_GREATER_THAN_UINT32(WEBSERVER_KEEPALIVE_IDLE_MILLIS, idleOnly.lastFirstResponseMillis);
+    // Now it waits at most for one page load of the first browser
+    unsigned long pageLoadMillis = CONNECT_MILLIS + PAGE_REQUESTS * (REQUEST_MILLIS + NEXT_REQUEST_MILLIS);
+    TEST_ASSERT_LESS_OR_EQUAL_UINT32(pageLoadMillis + WEBSERVER_KEEPALIVE_BUSY_IDLE_MILLIS + CONNECT_MILLIS + REQUEST_MILLIS, withKeepAlive.lastFirstResponseMillis);
+}
+
+int main(int argc, char **argv) {
+    UNITY_BEGIN();
+    RUN_TEST(test_idle_connection_is_kept);
+    RUN_TEST(test_idle_connection_is_closed_for_waiting_client);
+    RUN_TEST(test_single_browser_is_faster);
+    RUN_TEST(test_two_browsers_are_faster);
+    RUN_TEST(test_second_browser_is_not_blocked_by_idle_connection);
+    return UNITY_END();
+}